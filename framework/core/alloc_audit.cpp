@@ -0,0 +1,44 @@
+#include "framework/core/alloc_audit.h"
+#include "saber/core/buffer.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#ifdef ENABLE_ALLOC_AUDIT
+namespace {
+thread_local size_t t_heap_allocs = 0;
+} // namespace
+
+// the library versions of the array and nothrow forms all go through these two
+void* operator new(std::size_t size) {
+    t_heap_allocs++;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+#endif
+
+namespace anakin {
+
+size_t thread_alloc_count() {
+#ifdef ENABLE_ALLOC_AUDIT
+    return saber::thread_buffer_allocs() + t_heap_allocs;
+#else
+    return saber::thread_buffer_allocs();
+#endif
+}
+
+bool alloc_audit_env() {
+    const char* audit = std::getenv("ANAKIN_ALLOC_AUDIT");
+    return audit != nullptr && std::string(audit) != "0";
+}
+
+} /* namespace anakin */
@@ -0,0 +1,37 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_ALLOC_AUDIT_H
+#define ANAKIN_ALLOC_AUDIT_H
+
+#include "anakin_config.h"
+#include <cstddef>
+
+namespace anakin {
+
+/**
+ *  \brief allocations made by the calling thread so far.
+ *  Tensor buffer allocations are always counted. Built with ENABLE_ALLOC_AUDIT the global
+ *  operator new is replaced by a counting one, so every heap allocation (std::vector, Shape...)
+ *  is counted too. Allocations of the OpenMP threads of an op land on their own counters.
+ */
+size_t thread_alloc_count();
+
+/// true if env ANAKIN_ALLOC_AUDIT is set and not 0, the default of Net::set_alloc_audit.
+bool alloc_audit_env();
+
+} /* namespace anakin */
+
+#endif
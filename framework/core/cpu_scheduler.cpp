@@ -0,0 +1,239 @@
+#include "framework/core/cpu_scheduler.h"
+#include "framework/core/numa.h"
+#include "utils/logger/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace anakin {
+
+CpuLease::CpuLease(CpuScheduler* scheduler, int model, int node, int threads) :
+    _scheduler(scheduler), _model(model), _node(node), _threads(threads),
+    _start(std::chrono::steady_clock::now()) {}
+
+CpuLease::CpuLease(CpuLease&& other) :
+    _scheduler(other._scheduler), _model(other._model), _node(other._node),
+    _threads(other._threads), _start(other._start) {
+    other._scheduler = nullptr;
+}
+
+CpuLease& CpuLease::operator=(CpuLease&& other) {
+    if (this != &other) {
+        release();
+        _scheduler = other._scheduler;
+        _model = other._model;
+        _node = other._node;
+        _threads = other._threads;
+        _start = other._start;
+        other._scheduler = nullptr;
+    }
+
+    return *this;
+}
+
+void CpuLease::release() {
+    if (_scheduler != nullptr) {
+        double elapsed = std::chrono::duration<double, std::micro>(
+                             std::chrono::steady_clock::now() - _start).count();
+        _scheduler->release(_model, _node, _threads, elapsed);
+        _scheduler = nullptr;
+    }
+}
+
+CpuScheduler::CpuScheduler() {
+    auto& topo = GlobalNumaTopology::Global();
+    std::vector<int> budgets;
+
+    for (int i = 0; i < topo.node_num(); i++) {
+        budgets.push_back(topo.node(i).cpus.size());
+    }
+
+#ifndef USE_SGX
+    const char* env = std::getenv("ANAKIN_CPU_BUDGET");
+
+    if (env != nullptr) {
+        int total = std::atoi(env);
+
+        if (total <= 0) {
+            budgets.clear();
+        } else {
+            // split the total over the nodes, the first nodes take the remainder
+            int nodes = std::min<int>(budgets.size(), total);
+            budgets.assign(nodes, total / nodes);
+
+            for (int i = 0; i < total % nodes; i++) {
+                budgets[i]++;
+            }
+        }
+    }
+#endif
+
+    init(budgets);
+}
+
+CpuScheduler::CpuScheduler(const std::vector<int>& budgets) {
+    init(budgets);
+}
+
+void CpuScheduler::init(const std::vector<int>& budgets) {
+    for (int budget : budgets) {
+        CHECK_GT(budget, 0) << "cpu budget of a node must be positive";
+        Node node;
+        node.budget = budget;
+        node.free = budget;
+        _nodes.push_back(std::move(node));
+    }
+
+    LOG(INFO) << "cpu scheduler: " << (enabled() ? "" : "disabled, ") << _nodes.size() << " nodes";
+}
+
+int CpuScheduler::model_id(const std::string& name) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto it = _model_ids.find(name);
+
+    if (it != _model_ids.end()) {
+        return it->second;
+    }
+
+    int id = _models.size();
+    Model model;
+    model.name = name;
+    _models.push_back(model);
+    _model_ids[name] = id;
+
+    for (auto& node : _nodes) {
+        node.running.push_back(0);
+        node.waiting.emplace_back();
+    }
+
+    return id;
+}
+
+void CpuScheduler::configure(int model, float weight, int priority, int max_threads) {
+    CHECK_GT(weight, 0.f) << "model weight must be positive";
+    std::lock_guard<std::mutex> guard(_mut);
+    _models[model].weight = weight;
+    _models[model].priority = priority;
+    _models[model].max_threads = max_threads;
+}
+
+int CpuScheduler::free_threads(int node) {
+    std::lock_guard<std::mutex> guard(_mut);
+    return _nodes[node].free;
+}
+
+int CpuScheduler::waiting(int node) {
+    std::lock_guard<std::mutex> guard(_mut);
+    int num = 0;
+    for (auto& waiters : _nodes[node].waiting) {
+        num += waiters.size();
+    }
+    return num;
+}
+
+int CpuScheduler::share(int model, int node, int max_threads) {
+    Node& pool = _nodes[node];
+    float active_weight = 0.f;
+
+    for (int m = 0; m < _models.size(); m++) {
+        if (m == model || pool.running[m] > 0 || !pool.waiting[m].empty()) {
+            active_weight += _models[m].weight;
+        }
+    }
+
+    int threads = std::lround(pool.budget * _models[model].weight / active_weight);
+    int cap = pool.budget;
+
+    if (_models[model].max_threads > 0) {
+        cap = std::min(cap, _models[model].max_threads);
+    }
+
+    if (max_threads > 0) {
+        cap = std::min(cap, max_threads);
+    }
+
+    return std::max(1, std::min(threads, cap));
+}
+
+void CpuScheduler::dispatch(int node) {
+    Node& pool = _nodes[node];
+
+    while (pool.free > 0) {
+        int next = -1;
+
+        for (int m = 0; m < _models.size(); m++) {
+            if (pool.waiting[m].empty()) {
+                continue;
+            }
+
+            if (next < 0 || _models[m].priority > _models[next].priority
+                    || (_models[m].priority == _models[next].priority
+                        && _models[m].vtime < _models[next].vtime)) {
+                next = m;
+            }
+        }
+
+        if (next < 0) {
+            return;
+        }
+
+        Waiter* waiter = pool.waiting[next].front();
+        int threads = share(next, node, waiter->max_threads);
+
+        // the head waits for its whole share rather than being overtaken by smaller ones
+        if (threads > pool.free) {
+            return;
+        }
+
+        pool.waiting[next].pop_front();
+        pool.running[next]++;
+        pool.free -= threads;
+        waiter->granted = threads;
+        waiter->cv.notify_one();
+    }
+}
+
+CpuLease CpuScheduler::acquire(int model, int node, int max_threads) {
+    if (!enabled()) {
+        return CpuLease();
+    }
+
+    node = node % _nodes.size();
+    std::unique_lock<std::mutex> lock(_mut);
+    Model& self = _models[model];
+
+    if (self.active++ == 0) {
+        // coming back from idle: no older credit than the models already competing
+        double min_vtime = -1.0;
+
+        for (auto& other : _models) {
+            if (&other != &self && other.active > 0 && (min_vtime < 0 || other.vtime < min_vtime)) {
+                min_vtime = other.vtime;
+            }
+        }
+
+        self.vtime = std::max(self.vtime, min_vtime);
+    }
+
+    Waiter waiter;
+    waiter.max_threads = max_threads;
+    _nodes[node].waiting[model].push_back(&waiter);
+    dispatch(node);
+    waiter.cv.wait(lock, [&waiter]() {
+        return waiter.granted > 0;
+    });
+    return CpuLease(this, model, node, waiter.granted);
+}
+
+void CpuScheduler::release(int model, int node, int threads, double elapsed_us) {
+    std::lock_guard<std::mutex> guard(_mut);
+    Model& self = _models[model];
+    self.vtime += threads * elapsed_us / self.weight;
+    self.active--;
+    Node& pool = _nodes[node];
+    pool.running[model]--;
+    pool.free += threads;
+    dispatch(node);
+}
+
+} /* namespace anakin */
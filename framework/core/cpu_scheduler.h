@@ -0,0 +1,164 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_CPU_SCHEDULER_H
+#define ANAKIN_CPU_SCHEDULER_H
+
+#include "anakin_config.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "framework/core/singleton.h"
+
+namespace anakin {
+
+class CpuScheduler;
+
+/**
+ *  \brief intra-op threads granted to one inference, given back when the lease is destroyed.
+ *  threads() == 0 means the scheduler is disabled and the caller keeps its own thread count.
+ */
+class CpuLease {
+public:
+    CpuLease() {}
+    CpuLease(CpuLease&& other);
+    CpuLease& operator=(CpuLease&& other);
+    ~CpuLease() { release(); }
+
+    int threads() const { return _threads; }
+
+    void release();
+
+private:
+    friend class CpuScheduler;
+    CpuLease(CpuScheduler* scheduler, int model, int node, int threads);
+
+    CpuLease(const CpuLease&);
+    CpuLease& operator=(const CpuLease&);
+
+    CpuScheduler* _scheduler{nullptr};
+    int _model{0};
+    int _node{0};
+    int _threads{0};
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ *  \brief process wide owner of the cpu cores shared by every model served in the process.
+ *
+ *  Each numa node has a budget of cores. An inference acquires a lease of intra-op threads
+ *  before running its net and gives it back when done, so idle models hold no cores and
+ *  the sum of the OpenMP teams never exceeds the budget. Waiting inferences are served by
+ *  priority first, then by weighted fair share: every model accumulates the thread-time it
+ *  used divided by its weight, and the model with the least of it goes next. A model that
+ *  becomes active again starts at the smallest time of the active ones, it can't bank
+ *  credit while idle.
+ *
+ *  A lease gets the model's share of the node, budget * weight / (sum of the weights of the
+ *  models active on the node), capped by the model's max_threads and the cap of the caller.
+ *
+ *  The budget defaults to the usable cpus of each node, env ANAKIN_CPU_BUDGET sets the total
+ *  (split over the nodes), ANAKIN_CPU_BUDGET=0 disables the scheduler.
+ *  OpenMP teams spin for a while after a parallel region, run with OMP_WAIT_POLICY=passive
+ *  so that threads of finished inferences really go to sleep.
+ */
+class CpuScheduler {
+public:
+    CpuScheduler();
+
+    /// budgets[i] cores on node i, an empty list disables the scheduler.
+    explicit CpuScheduler(const std::vector<int>& budgets);
+
+    bool enabled() const { return !_nodes.empty(); }
+
+    int node_num() const { return _nodes.size(); }
+
+    int budget(int node) const { return _nodes[node].budget; }
+
+    /// id of the model called name, it's added with weight 1 and priority 0 the first time.
+    int model_id(const std::string& name);
+
+    /**
+     *  \brief set the scheduling parameters of a model.
+     *  \param weight relative share of the cores when models of one priority compete.
+     *  \param priority waiting inferences of a higher priority are always served first.
+     *  \param max_threads upper bound of the threads of one inference, 0 for no bound.
+     */
+    void configure(int model, float weight, int priority = 0, int max_threads = 0);
+
+    /**
+     *  \brief block until threads of node are free for an inference of model.
+     *  \param max_threads cap of the caller, 0 for none.
+     */
+    CpuLease acquire(int model, int node = 0, int max_threads = 0);
+
+    /// cores of node not leased at the moment.
+    int free_threads(int node);
+
+    /// inferences blocked in acquire for threads of node.
+    int waiting(int node);
+
+private:
+    friend class CpuLease;
+    void release(int model, int node, int threads, double elapsed_us);
+
+    struct Waiter {
+        int max_threads{0};
+        int granted{0};
+        std::condition_variable cv;
+    };
+
+    struct Model {
+        std::string name;
+        float weight{1.f};
+        int priority{0};
+        int max_threads{0};
+        ///< thread-microseconds used / weight
+        double vtime{0.0};
+        ///< leases held plus inferences waiting, on every node
+        int active{0};
+    };
+
+    struct Node {
+        int budget{0};
+        int free{0};
+        ///< per model
+        std::vector<int> running;
+        std::vector<std::deque<Waiter*> > waiting;
+    };
+
+    void init(const std::vector<int>& budgets);
+
+    /// threads an inference of model would get on node right now.
+    int share(int model, int node, int max_threads);
+
+    /// grant leases to the waiters of node while the next one fits.
+    void dispatch(int node);
+
+    std::mutex _mut;
+    std::vector<Model> _models;
+    std::unordered_map<std::string, int> _model_ids;
+    std::vector<Node> _nodes;
+};
+
+typedef Singleton<CpuScheduler> GlobalCpuScheduler;
+
+} /* namespace anakin */
+
+#endif
@@ -0,0 +1,265 @@
+#include "framework/core/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace anakin {
+
+int metric_shard() {
+    static std::atomic<int> next{0};
+    static thread_local int shard = next.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+    return shard;
+}
+
+int64_t Counter::value() const {
+    int64_t sum = 0;
+
+    for (int i = 0; i < kMetricShards; i++) {
+        sum += _shards[i].value.load(std::memory_order_relaxed);
+    }
+
+    return sum;
+}
+
+LatencyHistogram::LatencyHistogram() : _shards(new Shard[kMetricShards]) {
+    for (int i = 0; i < kMetricShards; i++) {
+        for (int b = 0; b < kBuckets; b++) {
+            _shards[i].buckets[b].store(0, std::memory_order_relaxed);
+        }
+
+        _shards[i].count.store(0, std::memory_order_relaxed);
+        _shards[i].sum.store(0, std::memory_order_relaxed);
+        _shards[i].max.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucket_of(uint64_t value) {
+    if (value < (1u << kSubBits)) {
+        return value;
+    }
+
+    int exp = 63 - __builtin_clzll(value);
+
+    if (exp > kMaxExp) {
+        return kBuckets - 1;
+    }
+
+    int sub = (value >> (exp - kSubBits)) & ((1 << kSubBits) - 1);
+    return ((exp - kSubBits + 1) << kSubBits) + sub;
+}
+
+uint64_t LatencyHistogram::bucket_lower(int bucket) {
+    if (bucket < (1 << kSubBits)) {
+        return bucket;
+    }
+
+    int exp = (bucket >> kSubBits) + kSubBits - 1;
+    uint64_t sub = bucket & ((1 << kSubBits) - 1);
+    return (((uint64_t)1 << kSubBits) + sub) << (exp - kSubBits);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    Shard& shard = _shards[metric_shard()];
+    shard.buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = shard.max.load(std::memory_order_relaxed);
+
+    while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    snap.buckets.assign(kBuckets, 0);
+
+    for (int i = 0; i < kMetricShards; i++) {
+        for (int b = 0; b < kBuckets; b++) {
+            snap.buckets[b] += _shards[i].buckets[b].load(std::memory_order_relaxed);
+        }
+
+        snap.count += _shards[i].count.load(std::memory_order_relaxed);
+        snap.sum += _shards[i].sum.load(std::memory_order_relaxed);
+        snap.max = std::max(snap.max, _shards[i].max.load(std::memory_order_relaxed));
+    }
+
+    return snap;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double q) const {
+    uint64_t total = 0;
+
+    for (auto n : buckets) {
+        total += n;
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(q * total));
+    uint64_t seen = 0;
+
+    for (int b = 0; b < buckets.size(); b++) {
+        seen += buckets[b];
+
+        if (seen >= rank) {
+            // report the top of the bucket, never above the largest value seen
+            uint64_t upper = b + 1 < buckets.size() ? bucket_lower(b + 1) - 1 : max;
+            return std::min(upper, max);
+        }
+    }
+
+    return max;
+}
+
+std::string metric_name(const std::string& name, const std::string& label,
+                        const std::string& value) {
+    return name + "{" + label + "=\"" + value + "\"}";
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    stop_sampler();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto& metric = _counters[name];
+
+    if (!metric) {
+        metric.reset(new Counter());
+    }
+
+    return *metric;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto& metric = _gauges[name];
+
+    if (!metric) {
+        metric.reset(new Gauge());
+    }
+
+    return *metric;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const std::string& name) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto& metric = _histograms[name];
+
+    if (!metric) {
+        metric.reset(new LatencyHistogram());
+    }
+
+    return *metric;
+}
+
+namespace {
+
+/// insert an extra label or a suffix into a possibly labeled name.
+std::string with_suffix(const std::string& name, const std::string& suffix,
+                        const std::string& extra_label = "") {
+    size_t brace = name.find('{');
+    std::string base = brace == std::string::npos ? name : name.substr(0, brace);
+    std::string labels = brace == std::string::npos ? "" : name.substr(brace + 1, name.size() - brace - 2);
+
+    if (!extra_label.empty()) {
+        labels = labels.empty() ? extra_label : labels + "," + extra_label;
+    }
+
+    return base + suffix + (labels.empty() ? "" : "{" + labels + "}");
+}
+
+} // namespace
+
+std::string MetricsRegistry::dump_text() {
+    std::lock_guard<std::mutex> guard(_mut);
+    std::ostringstream os;
+
+    for (auto& it : _counters) {
+        os << it.first << " " << it.second->value() << "\n";
+        auto rate = _rates.find(it.first);
+
+        if (rate != _rates.end()) {
+            os << with_suffix(it.first, "_qps") << " " << rate->second << "\n";
+        }
+    }
+
+    for (auto& it : _gauges) {
+        os << it.first << " " << it.second->value() << "\n";
+    }
+
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    for (auto& it : _histograms) {
+        auto snap = it.second->snapshot();
+
+        for (double q : quantiles) {
+            std::ostringstream label;
+            label << "quantile=\"" << q << "\"";
+            os << with_suffix(it.first, "", label.str()) << " " << snap.percentile(q) << "\n";
+        }
+
+        os << with_suffix(it.first, "_count") << " " << snap.count << "\n";
+        os << with_suffix(it.first, "_sum") << " " << snap.sum << "\n";
+        os << with_suffix(it.first, "_max") << " " << snap.max << "\n";
+    }
+
+    return os.str();
+}
+
+void MetricsRegistry::sample() {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - _last_sample).count();
+    bool first = _last_values.empty();
+
+    for (auto& it : _counters) {
+        int64_t value = it.second->value();
+        auto last = _last_values.find(it.first);
+
+        if (!first && last != _last_values.end() && seconds > 0) {
+            _rates[it.first] = (value - last->second) / seconds;
+        }
+
+        _last_values[it.first] = value;
+    }
+
+    _last_sample = now;
+}
+
+void MetricsRegistry::start_sampler(int interval_ms) {
+    std::lock_guard<std::mutex> guard(_sampler_mut);
+
+    if (_sampler.joinable()) {
+        return;
+    }
+
+    _sampler_stop = false;
+    _sampler = std::thread([this, interval_ms]() {
+        std::unique_lock<std::mutex> lock(_sampler_mut);
+
+        while (!_sampler_stop) {
+            lock.unlock();
+            sample();
+            lock.lock();
+            // sleeps until the next sample, or until stop_sampler wakes it
+            _sampler_cv.wait_for(lock, std::chrono::milliseconds(interval_ms),
+                                 [this]() { return _sampler_stop; });
+        }
+    });
+}
+
+void MetricsRegistry::stop_sampler() {
+    {
+        std::lock_guard<std::mutex> guard(_sampler_mut);
+        _sampler_stop = true;
+    }
+    _sampler_cv.notify_all();
+
+    if (_sampler.joinable()) {
+        _sampler.join();
+    }
+}
+
+} /* namespace anakin */
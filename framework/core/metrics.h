@@ -0,0 +1,172 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_METRICS_H
+#define ANAKIN_METRICS_H
+
+#include "anakin_config.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "framework/core/singleton.h"
+
+namespace anakin {
+
+/// recording threads are spread over this many shards, so hot counters don't share a cache line.
+const int kMetricShards = 8;
+
+/// shard of the calling thread, assigned round robin on first use.
+int metric_shard();
+
+/**
+ *  \brief monotonically increasing count, e.g. requests served. add() is a relaxed atomic
+ *  add on the shard of the calling thread, value() sums the shards.
+ */
+class Counter {
+public:
+    void add(int64_t n = 1) {
+        _shards[metric_shard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    int64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<int64_t> value{0};
+    };
+    Shard _shards[kMetricShards];
+};
+
+/// instant value, e.g. queue depth.
+class Gauge {
+public:
+    void add(int64_t n) { _value.fetch_add(n, std::memory_order_relaxed); }
+
+    void set(int64_t n) { _value.store(n, std::memory_order_relaxed); }
+
+    int64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> _value{0};
+};
+
+/**
+ *  \brief HDR style log-linear histogram of latencies (or any non negative value).
+ *  every power of two is split in 16 buckets, so a recorded value is off by at most 1/16
+ *  (values below 16 are exact, values above 2^40 are clamped). Recording is lock free.
+ */
+class LatencyHistogram {
+public:
+    static const int kSubBits = 4;
+    static const int kMaxExp = 40;
+    static const int kBuckets = (kMaxExp - kSubBits + 2) << kSubBits;
+
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count{0};
+        uint64_t sum{0};
+        uint64_t max{0};
+
+        /// value below which a fraction q of the records fall, q in [0, 1].
+        uint64_t percentile(double q) const;
+    };
+
+    LatencyHistogram();
+
+    void record(uint64_t value);
+
+    Snapshot snapshot() const;
+
+    static int bucket_of(uint64_t value);
+
+    /// smallest value of a bucket.
+    static uint64_t bucket_lower(int bucket);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> buckets[kBuckets];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+    std::unique_ptr<Shard[]> _shards;
+};
+
+/// microseconds elapsed since start.
+inline uint64_t elapsed_us(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ *  \brief named metrics of the process. Metrics are created on first lookup and never removed,
+ *  so callers look them up once and keep the reference for the hot path.
+ *  Names may carry labels: anakin_compute_us{model="vgg"}.
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry() {}
+    ~MetricsRegistry();
+
+    Counter& counter(const std::string& name);
+
+    Gauge& gauge(const std::string& name);
+
+    LatencyHistogram& histogram(const std::string& name);
+
+    /**
+     *  \brief text dump in prometheus exposition style, counters also get a _qps line
+     *  (rate over the last sampler interval), histograms get quantile/count/sum/max lines.
+     */
+    std::string dump_text();
+
+    /// start the thread computing counter rates, it sleeps interval_ms between samples.
+    void start_sampler(int interval_ms = 1000);
+
+    void stop_sampler();
+
+private:
+    void sample();
+
+    std::mutex _mut;
+    std::map<std::string, std::unique_ptr<Counter> > _counters;
+    std::map<std::string, std::unique_ptr<Gauge> > _gauges;
+    std::map<std::string, std::unique_ptr<LatencyHistogram> > _histograms;
+    ///< counter values at the last sample and the rates derived from them
+    std::map<std::string, int64_t> _last_values;
+    std::map<std::string, double> _rates;
+    std::chrono::steady_clock::time_point _last_sample;
+
+    std::thread _sampler;
+    std::mutex _sampler_mut;
+    std::condition_variable _sampler_cv;
+    bool _sampler_stop{false};
+};
+
+typedef Singleton<MetricsRegistry> GlobalMetrics;
+
+/// name{label="value"}
+std::string metric_name(const std::string& name, const std::string& label, const std::string& value);
+
+} /* namespace anakin */
+
+#endif
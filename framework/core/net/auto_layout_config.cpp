@@ -14,10 +14,177 @@
 */
 
 #include "framework/core/net/auto_layout_config.h"
+#include <cstdlib>
+#include <queue>
 #include <unordered_set>
 #include "framework/graph/node.h"
+#ifndef USE_SGX
+#include <fstream>
+#include <sstream>
+#endif
 namespace anakin {
 
+namespace {
+
+/// cost of a forbidden choice, far above any real plan.
+const double kForbidden = 1e6;
+
+/**
+ * \brief minimum of a binary labeling energy sum(unary) + sum(pairwise) by s-t min cut
+ *  (Kolmogorov & Zabih). exact as long as every pairwise term is submodular,
+ *  E(0,0) + E(1,1) <= E(0,1) + E(1,0). label 0 is the source side.
+ */
+class BinaryCut {
+public:
+    explicit BinaryCut(int var_num) : _var_num(var_num), _graph(var_num + 2) {}
+
+    void add_unary(int i, double cost0, double cost1) {
+        if (cost1 > cost0) {
+            _constant += cost0;
+            add_arc(source(), i, cost1 - cost0);
+        } else {
+            _constant += cost1;
+            add_arc(i, sink(), cost0 - cost1);
+        }
+    }
+
+    /// E(xi, xj) = {a: (0,0), b: (0,1), c: (1,0), d: (1,1)}, false if not submodular.
+    bool add_pairwise(int i, int j, double a, double b, double c, double d) {
+        if (a + d > b + c + 1e-6) {
+            return false;
+        }
+
+        _constant += a;
+        add_unary(i, 0, c - a);
+        add_unary(j, 0, d - c);
+        add_arc(i, j, b + c - a - d);
+        return true;
+    }
+
+    /// labels of the variables, returns the energy of the labeling.
+    double solve(std::vector<int>& labels) {
+        double flow = 0;
+
+        while (bfs()) {
+            _iter.assign(_graph.size(), 0);
+            double pushed = 0;
+
+            while ((pushed = dfs(source(), kForbidden * 1e3)) > 1e-12) {
+                flow += pushed;
+            }
+        }
+
+        labels.assign(_var_num, 1);
+
+        for (int i = 0; i < _var_num; i++) {
+            labels[i] = _level[i] >= 0 ? 0 : 1;
+        }
+
+        return _constant + flow;
+    }
+
+private:
+    struct Arc {
+        int to;
+        int rev;
+        double cap;
+    };
+
+    int source() const { return _var_num; }
+    int sink() const { return _var_num + 1; }
+
+    void add_arc(int from, int to, double cap) {
+        if (cap <= 0) {
+            return;
+        }
+
+        _graph[from].push_back({to, (int)_graph[to].size(), cap});
+        _graph[to].push_back({from, (int)_graph[from].size() - 1, 0});
+    }
+
+    bool bfs() {
+        _level.assign(_graph.size(), -1);
+        std::queue<int> queue;
+        _level[source()] = 0;
+        queue.push(source());
+
+        while (!queue.empty()) {
+            int v = queue.front();
+            queue.pop();
+
+            for (auto& arc : _graph[v]) {
+                if (arc.cap > 1e-12 && _level[arc.to] < 0) {
+                    _level[arc.to] = _level[v] + 1;
+                    queue.push(arc.to);
+                }
+            }
+        }
+
+        return _level[sink()] >= 0;
+    }
+
+    double dfs(int v, double limit) {
+        if (v == sink()) {
+            return limit;
+        }
+
+        for (int& k = _iter[v]; k < _graph[v].size(); k++) {
+            Arc& arc = _graph[v][k];
+
+            if (arc.cap > 1e-12 && _level[arc.to] == _level[v] + 1) {
+                double pushed = dfs(arc.to, std::min(limit, arc.cap));
+
+                if (pushed > 1e-12) {
+                    arc.cap -= pushed;
+                    _graph[arc.to][arc.rev].cap += pushed;
+                    return pushed;
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    int _var_num;
+    double _constant{0};
+    std::vector<std::vector<Arc> > _graph;
+    std::vector<int> _level;
+    std::vector<int> _iter;
+};
+
+/// union find over edge names, a set is a region of edges sharing one layout.
+struct EdgeGroups {
+    std::unordered_map<std::string, std::string> parent;
+
+    std::string find(const std::string& name) {
+        auto it = parent.find(name);
+
+        if (it == parent.end()) {
+            parent[name] = name;
+            return name;
+        }
+
+        if (it->second == name) {
+            return name;
+        }
+
+        std::string root = find(it->second);
+        parent[name] = root;
+        return root;
+    }
+
+    void unite(const std::string& a, const std::string& b) {
+        std::string ra = find(a);
+        std::string rb = find(b);
+
+        if (ra != rb) {
+            parent[ra] = rb;
+        }
+    }
+};
+
+} // namespace
+
 template<typename Ttype, Precision Ptype>
 void AutoLayoutConfigHelper<Ttype, Ptype>::init() {
     _node_layout_hint["Input"]["nchw"] = {"nchw"};
@@ -81,6 +248,229 @@ void AutoLayoutConfigHelper<Ttype, Ptype>::init() {
 
         _node_layout_hint_reverse[node_name] = out_in_map;
     }
+
+    init_cost_table();
+}
+
+template<typename Ttype, Precision Ptype>
+void AutoLayoutConfigHelper<Ttype, Ptype>::init_cost_table() {
+    // rough estimates relative to the fp32 nchw kernel of the same op, not measurements;
+    // a table from a benchmark of the target machine can be given in ANAKIN_LAYOUT_COST_TABLE
+    for (auto op : {"Convolution", "ConvRelu", "ConvBatchnormScaleRelu", "ConvBatchnormScale",
+                    "ConvEltwise"}) {
+        _op_cost[std::string(op) + ":nchw_c8r:fp32"] = 0.6f;
+        _op_cost[std::string(op) + ":*:int8"] = 0.35f;
+    }
+
+    _op_cost["Pooling:nchw_c8r:fp32"] = 0.8f;
+    _op_cost["Pooling:*:int8"] = 0.7f;
+    _op_cost["Dense:*:int8"] = 0.5f;
+    _op_cost["*:*:fp32"] = 1.f;
+    _op_cost["*:*:int8"] = 1.f;
+
+#ifndef USE_SGX
+    // lines of "<op> <layout> <dtype> <cost>", "reorder <cost>" or "calibrate <cost>"
+    const char* path = std::getenv("ANAKIN_LAYOUT_COST_TABLE");
+
+    if (path == nullptr) {
+        return;
+    }
+
+    std::ifstream file(path);
+
+    if (!file) {
+        LOG(WARNING) << "layout cost table " << path << " can't be read, use the defaults";
+        return;
+    }
+
+    std::string line;
+
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string op;
+
+        if (!(fields >> op) || op[0] == '#') {
+            continue;
+        }
+
+        if (op == "reorder") {
+            fields >> _reorder_cost;
+        } else if (op == "calibrate") {
+            fields >> _calibrate_cost;
+        } else {
+            std::string layout;
+            std::string dtype;
+            float cost = 1.f;
+
+            if (fields >> layout >> dtype >> cost) {
+                _op_cost[op + ":" + layout + ":" + dtype] = cost;
+            }
+        }
+    }
+
+#endif
+}
+
+template<typename Ttype, Precision Ptype>
+float AutoLayoutConfigHelper<Ttype, Ptype>::op_cost(const std::string& op,
+        const std::string& layout, const std::string& dtype) {
+    for (auto key : {op + ":" + layout + ":" + dtype, op + ":*:" + dtype,
+                     "*:" + layout + ":" + dtype, "*:*:" + dtype}) {
+        auto it = _op_cost.find(key);
+
+        if (it != _op_cost.end()) {
+            return it->second;
+        }
+    }
+
+    return 1.f;
+}
+
+template<typename Ttype, Precision Ptype>
+bool AutoLayoutConfigHelper<Ttype, Ptype>::layout_allowed(const std::string& op,
+        const std::string& in_layout, const std::string& out_layout) {
+    auto hint = _node_layout_hint.find(op);
+
+    if (hint == _node_layout_hint.end()) {
+        return in_layout == "nchw" && out_layout == "nchw";
+    }
+
+    auto outs = hint->second.find(in_layout);
+    return outs != hint->second.end()
+           && std::count(outs->second.begin(), outs->second.end(), out_layout) > 0;
+}
+
+template<typename Ttype, Precision Ptype>
+bool AutoLayoutConfigHelper<Ttype, Ptype>::cost_model_layout(graph::Graph<Ttype, Ptype>& graph) {
+    const std::string layouts[2] = {"nchw", "nchw_c8r"};
+    std::vector<graph::NodePtr> nodes;
+    auto collect_node = [&](graph::NodePtr node) {
+        nodes.push_back(node);
+    };
+    graph.Scanner->BFS(collect_node);
+
+    // an op keeping the layout of its input ties its in and out edges together,
+    // a merge needs the same layout on all its inputs, all outputs of an op share one layout
+    auto keeps_layout = [this](const std::string & op) {
+        auto hint = _node_layout_hint.find(op);
+
+        if (hint == _node_layout_hint.end()) {
+            return false;
+        }
+
+        for (auto& in_out : hint->second) {
+            if (in_out.second.size() != 1 || in_out.second[0] != in_out.first) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+    EdgeGroups groups;
+    std::unordered_map<std::string, std::string> in_group;
+    std::unordered_map<std::string, std::string> out_group;
+
+    for (auto& node : nodes) {
+        std::string first_in;
+        std::string first_out;
+
+        for (auto arc : graph.get_in_arc_its(node->name())) {
+            if (first_in.empty()) {
+                first_in = arc->name();
+            }
+
+            groups.unite(first_in, arc->name());
+        }
+
+        for (auto arc : graph.get_out_arc_its(node->name())) {
+            if (first_out.empty()) {
+                first_out = arc->name();
+            }
+
+            groups.unite(first_out, arc->name());
+        }
+
+        if (!first_in.empty() && !first_out.empty() && keeps_layout(node->get_op_name())) {
+            groups.unite(first_in, first_out);
+        }
+
+        if (!first_in.empty()) {
+            in_group[node->name()] = first_in;
+        }
+
+        if (!first_out.empty()) {
+            out_group[node->name()] = first_out;
+        }
+    }
+
+    std::unordered_map<std::string, int> var_id;
+
+    for (auto& it : groups.parent) {
+        std::string root = groups.find(it.first);
+
+        if (var_id.count(root) == 0) {
+            int id = var_id.size();
+            var_id[root] = id;
+        }
+    }
+
+    BinaryCut cut(var_id.size());
+
+    // price of an op reading in_layout and writing out_layout
+    auto price = [&, this](const std::string & op, const std::string & in_layout,
+    const std::string & out_layout) -> double {
+        if (!layout_allowed(op, in_layout, out_layout)) {
+            return kForbidden;
+        }
+
+        return op_cost(op, out_layout, "fp32") + (in_layout != out_layout ? _reorder_cost : 0.f);
+    };
+
+    for (auto& node : nodes) {
+        std::string op = node->get_op_name();
+        bool has_in = in_group.count(node->name()) > 0;
+        bool has_out = out_group.count(node->name()) > 0;
+        int in_var = has_in ? var_id[groups.find(in_group[node->name()])] : -1;
+        int out_var = has_out ? var_id[groups.find(out_group[node->name()])] : -1;
+        double cost[2][2];
+
+        for (int x = 0; x < 2; x++) {
+            for (int y = 0; y < 2; y++) {
+                cost[x][y] = price(op, layouts[x], layouts[y]);
+            }
+        }
+
+        if (has_in && has_out && in_var != out_var) {
+            if (!cut.add_pairwise(in_var, out_var, cost[0][0], cost[0][1], cost[1][0], cost[1][1])) {
+                LOG(WARNING) << "layout cost of " << node->name() << " is not submodular";
+                return false;
+            }
+        } else if (has_in && has_out) {
+            cut.add_unary(in_var, cost[0][0], cost[1][1]);
+        } else if (has_out) {
+            // a source (Input) can write y if it has any allowed in/out pair ending in y
+            cut.add_unary(out_var, std::min(cost[0][0], cost[1][0]), std::min(cost[0][1], cost[1][1]));
+        } else if (has_in) {
+            cut.add_unary(in_var, std::min(cost[0][0], cost[0][1]), std::min(cost[1][0], cost[1][1]));
+        }
+    }
+
+    std::vector<int> labels;
+    double total = cut.solve(labels);
+
+    if (total >= kForbidden) {
+        LOG(WARNING) << "no layout assignment satisfies the layout hints";
+        return false;
+    }
+
+    _layout_map_bynode.clear();
+
+    for (auto& it : groups.parent) {
+        _layout_map_bynode[it.first] = layouts[labels[var_id[groups.find(it.first)]]];
+    }
+
+    LOG(INFO) << "cost model layout: " << var_id.size() << " layout regions, cost " << total;
+    return true;
 }
 
 template<typename Ttype, Precision Ptype>
@@ -109,26 +499,50 @@ auto_config_node_dtype(graph::Graph<Ttype, Ptype>& graph) {
 
     std::unordered_map<std::string, std::string> result;
     std::unordered_set<std::string> relu_op = {"ConvBatchnormScaleRelu", "ConvRelu", "ConvEltwise"};
-    auto uint8_node_config = [&, this](graph::NodePtr target_node) {
+    // every calibrated node may run in int8, but an int8 island between fp32 ops costs two
+    // calibrations; choose per node with the same min cut as the layouts
+    std::vector<graph::NodePtr> int8_nodes;
+    std::unordered_map<std::string, int> var_id;
+    auto collect_int8_node = [&](graph::NodePtr target_node) {
         if (target_node->bit_type() == AK_INT8) {
-            if (relu_op.count(target_node->get_op_name()) > 0) {
-                if (target_node->get_op_name() == "ConvEltwise") {
+            var_id[target_node->name()] = int8_nodes.size();
+            int8_nodes.push_back(target_node);
+        }
+    };
+    graph.Scanner->BFS(collect_int8_node);
+    BinaryCut cut(int8_nodes.size());
 
-                    for (auto k : target_node->attr()) {
-                        LOG(INFO) << "ConvEltwise attr :" << k.first;
-                    }
+    for (auto& node : int8_nodes) {
+        cut.add_unary(var_id[node->name()], op_cost(node->get_op_name(), "*", "fp32"),
+                      op_cost(node->get_op_name(), "*", "int8"));
+    }
 
-                }
+    auto calibration_cost = [&, this](graph::Edge<Ttype>& edge) {
+        auto bottom = var_id.find(edge.bottom());
+        auto top = var_id.find(edge.top());
 
-                result[target_node->name()] = "uint8";
-                return;
-            } else {
-                result[target_node->name()] = "int8";
-                return;
-            }
+        if (bottom != var_id.end() && top != var_id.end()) {
+            cut.add_pairwise(bottom->second, top->second, 0, _calibrate_cost, _calibrate_cost, 0);
+        } else if (bottom != var_id.end()) {
+            cut.add_unary(bottom->second, 0, _calibrate_cost);
+        } else if (top != var_id.end()) {
+            cut.add_unary(top->second, 0, _calibrate_cost);
         }
     };
-    graph.Scanner->BFS(uint8_node_config);
+    graph.Scanner->BFS_Edge(calibration_cost);
+    std::vector<int> labels;
+    cut.solve(labels);
+
+    for (auto& target_node : int8_nodes) {
+        if (labels[var_id[target_node->name()]] == 0) {
+            result[target_node->name()] = "fp32";
+        } else if (relu_op.count(target_node->get_op_name()) > 0) {
+            result[target_node->name()] = "uint8";
+        } else {
+            result[target_node->name()] = "int8";
+        }
+    }
+
     return result;
 };
 
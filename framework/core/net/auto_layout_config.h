@@ -29,6 +29,14 @@ public:
     bool check_merge(graph::Graph<Ttype, Ptype>& graph);
     void print_layout();
     void scane_dfs_from_input(graph::Graph<Ttype, Ptype>& graph);
+    /**
+     * \brief global layout assignment: edges are grouped into regions that must share a layout
+     *  (layout preserving ops, merge inputs), each op is priced for every (in, out) layout pair
+     *  from the cost table plus a reorder when the layout changes, and the cheapest assignment is
+     *  found exactly with a min cut. returns false, leaving the layout map empty, if the graph
+     *  has no valid assignment; callers fall back to scane_dfs_from_input.
+     */
+    bool cost_model_layout(graph::Graph<Ttype, Ptype>& graph);
     std::unordered_map<std::string, std::string> get_config_layout(){
         return _layout_map_bynode;
     };
@@ -37,6 +45,11 @@ public:
 
 private:
     void init();
+    void init_cost_table();
+    /// estimated relative cost of an op, falls back to "*" for the op or the layout.
+    float op_cost(const std::string& op, const std::string& layout, const std::string& dtype);
+    bool layout_allowed(const std::string& op, const std::string& in_layout,
+                        const std::string& out_layout);
     std::vector<std::string> get_node_out_layout(std::string node_type, std::string in_layout);
     std::vector<graph::NodePtr> get_node_output_nodes(graph::Graph<Ttype, Ptype>& graph, graph::NodePtr& node);
     std::vector<graph::Edge<Ttype>> get_node_output_arcs(graph::Graph<Ttype, Ptype>& graph,
@@ -57,6 +70,10 @@ private:
     _node_layout_hint_reverse;
     std::unordered_map<std::string, std::string> _edge_done_map;
     std::unordered_map<std::string, std::string> _layout_map_bynode;
+    ///< "op:layout:dtype" -> cost relative to fp32 nchw, see init_cost_table
+    std::unordered_map<std::string, float> _op_cost;
+    float _reorder_cost{0.3f};
+    float _calibrate_cost{0.25f};
 };
 }
 #endif //ANAKIN_AUTO_LAYOUT_CONFIG_H
@@ -97,29 +97,44 @@ void EntropyCalibrator<Ttype>::expand_to_q(std::vector<int>& ref_p, std::vector<
  *  *because the length of q is not equal to hist, The last bin of q was given to all the rest */
 template<typename Ttype>
 float  EntropyCalibrator<Ttype>::get_kl_divergence(std::vector<int>&ref_p, std::vector<float>& q) {
-//float EntropyCalibrator<Ttype>:: get_kl_divergence(std::vector<int>&ref_p, std::vector<int>& q) {
+    const int p_size = ref_p.size();
+    const int q_size = q.size();
+    const int* p_data = ref_p.data();
+    const float* q_data = q.data();
     int sum_p = 0;
-    int sum_q = 0;
-    for (int i = 0; i < ref_p.size(); i++) {
-        sum_p += ref_p[i];
+    float sum_q = 0.f;
+#ifdef USE_OPENMP
+#pragma omp simd reduction(+:sum_p)
+#endif
+    for (int i = 0; i < p_size; i++) {
+        sum_p += p_data[i];
     }
-    for (int i = 0; i< q.size(); i++) {
-        sum_q += q[i];
+#ifdef USE_OPENMP
+#pragma omp simd reduction(+:sum_q)
+#endif
+    for (int i = 0; i < q_size; i++) {
+        sum_q += q_data[i];
     }
+    const float inv_sum_p = 1.f / sum_p;
+    const float inv_sum_q = 1.f / sum_q;
     float kl = 0;
-    for (int i = 0; i < q.size() - 1; i++) {
-        float p_prob = float(ref_p[i]) / sum_p;
-        float q_prob = float(q[i]) / sum_q;
-        if (ref_p[i] != 0 && q[i] != 0 ) {
-            kl += p_prob * log2(p_prob/q_prob);
-        }
+    // branch free, so that the loop can be vectorized; empty bins contribute 0
+#ifdef USE_OPENMP
+#pragma omp simd reduction(+:kl)
+#endif
+    for (int i = 0; i < q_size - 1; i++) {
+        float p_prob = p_data[i] * inv_sum_p;
+        float q_prob = q_data[i] * inv_sum_q;
+        bool valid = p_data[i] != 0 && q_data[i] != 0;
+        kl += valid ? p_prob * log2f(p_prob / q_prob) : 0.f;
     }
-    float q_prob = float(q[q.size() - 1]) / sum_q/ (ref_p.size() - q.size() + 1);
-    for (int i = q.size() - 1; i < ref_p.size(); i++) {
-        float p_prob = float(ref_p[i]) / sum_p;
-        if (ref_p[i] > 0) {
-            kl += p_prob * log2(p_prob/q_prob);
-        }
+    float q_prob = q_data[q_size - 1] * inv_sum_q / (p_size - q_size + 1);
+#ifdef USE_OPENMP
+#pragma omp simd reduction(+:kl)
+#endif
+    for (int i = q_size - 1; i < p_size; i++) {
+        float p_prob = p_data[i] * inv_sum_p;
+        kl += p_data[i] > 0 ? p_prob * log2f(p_prob / q_prob) : 0.f;
     }
     return kl;
 }
@@ -129,25 +144,46 @@ float  EntropyCalibrator<Ttype>::get_kl_divergence(std::vector<int>&ref_p, std::
  */
 template<typename Ttype>
 int  EntropyCalibrator<Ttype>::get_batch_data(std::vector<Tensor4dPtr<Ttype>> inputs) {
-    //if (_in_vec.size() == 0) {
-    //    _in_vec.resize(inputs.size());
-    //    int i = 0;
-    //    for (auto input : inputs) {
-    //        _in_vec[i++] = new Tensor<X86>(input->valid_shape());
-    //    }
-    //}
-    int num = this->_batch_stream->get_batch_data(inputs);
-    //if (num > 0) {
-    //    int i = 0;
-    //    for (auto input : inputs) {
-    //        input->reshape(_in_vec[i]->valid_shape());
-    //        input->copy_from((*_in_vec[i]));
-    //        i++;
-    //    }
-    //}
-    return num;
+    return this->_batch_stream->get_batch_data(inputs);
+}
+
+/*read the next batch into the staging tensors on a background thread, the net inputs
+ *keep the current batch meanwhile*/
+template<typename Ttype>
+int EntropyCalibrator<Ttype>::prefetch_batch_data() {
+    _prefetch = std::async(std::launch::async, [this]() {
+        return get_batch_data(_in_vec);
+    });
+    return 0;
 }
 
+/*get the batch for the coming run, in streaming mode the batch has been read
+ *while the net was running on the previous one */
+template<typename Ttype>
+int EntropyCalibrator<Ttype>::next_batch_data(std::vector<Tensor4dPtr<Ttype>> inputs) {
+    if (!_streaming) {
+        return get_batch_data(inputs);
+    }
+    if (_in_vec.size() == 0) {
+        for (auto input : inputs) {
+            _in_vec.push_back(new Tensor<Ttype>(input->valid_shape()));
+        }
+    }
+    if (!_prefetch.valid()) {
+        prefetch_batch_data();
+    }
+    int num = _prefetch.get();
+    if (num == 0) {
+        return 0;
+    }
+    for (int i = 0; i < inputs.size(); i++) {
+        inputs[i]->reshape(_in_vec[i]->valid_shape());
+        inputs[i]->copy_from(*_in_vec[i]);
+        inputs[i]->set_seq_offset(_in_vec[i]->get_seq_offset());
+    }
+    prefetch_batch_data();
+    return num;
+}
 
 template<typename Ttype>
 void EntropyCalibrator<Ttype>::read_calibrator() {
@@ -178,6 +214,10 @@ void EntropyCalibrator<Ttype>::write_calibrator() {
 
 template<typename Ttype>
 void EntropyCalibrator<Ttype>::reset_data_stream() {
+    if (_prefetch.valid()) {
+        _prefetch.wait();
+        _prefetch = std::future<int>();
+    }
 
     return this->_batch_stream->reset();
 }
@@ -194,9 +234,12 @@ float EntropyCalibrator<Ttype>::max_data(Tensor4dPtr<Ttype> tensor, int tensor_i
 
     float max_value = 0.f;
     const float* data = (const float*)h_tensor.data();
-    for (int i = 0; i < h_tensor.valid_size(); i++) {
-        //max_value  =  std::max(float(abs(data[i])), max_value);
-        auto x = fabs(data[i]);
+    const int size = h_tensor.valid_size();
+#ifdef USE_OPENMP
+#pragma omp parallel for simd reduction(max:max_value)
+#endif
+    for (int i = 0; i < size; i++) {
+        auto x = fabsf(data[i]);
         max_value  =  x > max_value ? x : max_value;
     }
     _max_vec[tensor_id] = _max_vec[tensor_id]  > max_value ? _max_vec[tensor_id] : max_value;
@@ -211,11 +254,29 @@ void EntropyCalibrator<Ttype>::histgram(Tensor4dPtr<Ttype> tensor, int tensor_id
     h_tensor.reshape(tensor->valid_shape());
     h_tensor.copy_from(*tensor);
     const float* data = (const float*) h_tensor.data();
+    const int size = h_tensor.valid_size();
+    const int bin_num = _bin_num;
     auto step = max_value / _bin_num;
-    for (int i = 0; i < h_tensor.valid_size(); i++) {
-        int id = fabs(data[i]) / step;
-        id = id < _bin_num ? id : _bin_num - 1;
-        hist_vec[id]++;
+    // every thread fills its own histogram, they are merged at the end
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> local_hist(bin_num, 0);
+#ifdef USE_OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < size; i++) {
+            int id = fabsf(data[i]) / step;
+            id = id < bin_num ? id : bin_num - 1;
+            local_hist[id]++;
+        }
+#ifdef USE_OPENMP
+#pragma omp critical
+#endif
+        for (int i = 0; i < bin_num; i++) {
+            hist_vec[i] += local_hist[i];
+        }
     }
 }
 
@@ -225,7 +286,7 @@ void EntropyCalibrator<Ttype>::get_max_values(std::vector<Tensor4dPtr<Ttype>> in
      /*get max data*/
     int batch_id = 0;
     while (true) {
-        int num = get_batch_data(in_vec);
+        int num = next_batch_data(in_vec);
         if (num == 0) {
             break;
         }
@@ -263,7 +324,7 @@ void EntropyCalibrator<Ttype>::get_histgrams(std::vector<Tensor4dPtr<Ttype>> in_
     reset_data_stream();
     int batch_id = 0;
     while (true) {
-        int num = get_batch_data(in_vec);
+        int num = next_batch_data(in_vec);
         if (num == 0) {
             break;
         }
@@ -296,61 +357,68 @@ void EntropyCalibrator<Ttype>::get_histgrams(std::vector<Tensor4dPtr<Ttype>> in_
 
 
 
+/*search the bin with min kl divergence in one histgram*/
+template<typename Ttype>
+int EntropyCalibrator<Ttype>::get_kl_thresh(std::vector<int>& hist) {
+    float min_kl_divergence = 1e30;
+    int total_num = 0;
+    for (auto a : hist) {
+        total_num += a;
+    }
+    total_num -= hist[0];
+
+    int start_num = 0;
+    for (int i = 1; i < 129; i++) {
+        start_num += hist[i];
+    }
+
+    int thresh = 0;
+    std::vector<float> q;
+    std::vector<float> ref_q;
+    std::vector<int> ref_p;
+    q.reserve(_bin_num);
+    ref_q.reserve(_bin_num);
+    ref_p.reserve(_bin_num);
+    for (int i = 129; i < _bin_num - 1; i++) {
+        ref_p.assign(hist.begin() + 1, hist.begin() + 1 + i);
+        int outlier = total_num - start_num;
+        ref_p[i - 1] += outlier;
+        ref_q.assign(128, 0.f);
+        q.assign(ref_p.size(), 0.f);
+        get_ref_q(ref_p, ref_q);
+        expand_to_q(ref_p, ref_q, q);
+        float kl = get_kl_divergence(hist, q);
+        thresh = min_kl_divergence > kl ? thresh : i;
+        min_kl_divergence  = min_kl_divergence > kl ? kl : min_kl_divergence;
+        start_num += hist[i];
+    }
+    return thresh;
+}
+
+/*search the thresholds of all the histgrams*/
+template<typename Ttype>
+std::vector<int> EntropyCalibrator<Ttype>::get_kl_threshes() {
+    int tensor_num = _hist_vecs.size();
+    std::vector<int> thresh_vec(tensor_num, 0);
+    // tensors are independent, search them concurrently
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int tensor_id = 0; tensor_id < tensor_num; tensor_id++) {
+        thresh_vec[tensor_id] = get_kl_thresh(_hist_vecs[tensor_id]);
+    }
+    return thresh_vec;
+}
+
 template<typename Ttype>
 void EntropyCalibrator<Ttype>::get_kl_threshold(std::vector<std::string>& tensor_name_list) {
-    
-	int tensor_id = 0;
-	for (auto hist : _hist_vecs) {
-		float min_kl_divergence = 1e30;
-		int total_num = 0;
-		for (auto a : hist) {
-			total_num += a;
-		}
-		total_num -= hist[0];
-
-		int start_num = 0;
-		for (int i = 1; i < 129; i++) {
-			start_num += hist[i];
-		}
-
-		int thresh = 0;
-		float kl_array[_bin_num];
-		std::vector<float> q;
-		std::vector<float> ref_q;
-		std::vector<int> ref_p;
-		q.reserve(_bin_num);
-		ref_q.reserve(_bin_num);
-		ref_p.reserve(_bin_num);
-		for (int i = 129; i < _bin_num - 1; i++) {
-			ref_p.resize(i);
-			for (int j = 0; j < ref_p.size(); j++) {
-				ref_p[j] = hist[j+1];
-			}
-			int outlier = total_num - start_num;
-			ref_p[i - 1] += outlier;
-			int q_size = ref_p.size();
-			ref_q.resize(128);
-			for (int j = 0; j < ref_q.size(); j++) {
-				ref_q[j] = 0.f;
-			}
-			q.resize(q_size);
-			for (int j = 0; j < q_size; j++) {
-				q[j] = 0.f;
-			}
-			get_ref_q(ref_p, ref_q);
-			expand_to_q(ref_p, ref_q, q);
-			float kl = get_kl_divergence(hist, q);
-			kl_array[i] = kl;
-			thresh = min_kl_divergence > kl ? thresh : i;
-			min_kl_divergence  = min_kl_divergence > kl ? kl : min_kl_divergence;
-			start_num += hist[i];
-		}
-		//_scale_map.insert(std::pair<std::string, float>(tensor_name_list[tensor_id], _max_vec[tensor_id] / (127 * _bin_num) *  thresh));
-		_scale_map.insert(std::pair<std::string, float>(tensor_name_list[tensor_id], _max_vec[tensor_id] / (127 * _bin_num) *  2048));
-		//_scale_map.insert(std::pair<std::string, float>(tensor_name_list[tensor_id], thresh));
-		tensor_id++;
-	}
-	write_calibrator();
+    int tensor_num = _hist_vecs.size();
+    std::vector<int> thresh_vec = get_kl_threshes();
+    for (int tensor_id = 0; tensor_id < tensor_num; tensor_id++) {
+        //_scale_map.insert(std::pair<std::string, float>(tensor_name_list[tensor_id], _max_vec[tensor_id] / (127 * _bin_num) *  thresh_vec[tensor_id]));
+        _scale_map.insert(std::pair<std::string, float>(tensor_name_list[tensor_id], _max_vec[tensor_id] / (127 * _bin_num) *  2048));
+    }
+    write_calibrator();
 }
 template<typename Ttype>
 void EntropyCalibrator<Ttype>::generate_calibrator_table() {
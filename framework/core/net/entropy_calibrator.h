@@ -22,6 +22,7 @@
 #ifndef USE_SGX
 
 #include "framework/core/net/calibrator.h"
+#include <future>
 
 namespace anakin {
 
@@ -39,7 +40,10 @@ public:
          Calibrator<Ttype>(stream, batch_size, calibrator_file, net), 
          _bin_num(bin_num) {}
 
-    ~EntropyCalibrator() { 
+    ~EntropyCalibrator() {
+        if (_prefetch.valid()) {
+            _prefetch.wait();
+        }
         for (auto tensor : _in_vec) {
              delete tensor;
              tensor = nullptr;
@@ -62,13 +66,27 @@ public:
 
     virtual CalibrationAlgoType get_algorithm() {return ENTROPY;}
 
-private:
+    /**
+     *  \brief Enable streaming mode: the next batch is read from BatchStream
+     *         on a background thread while the net runs on the current one.
+     */
+    void set_streaming(bool streaming) {_streaming = streaming;}
+
+protected:
     void get_ref_q(std::vector<int>& ref_p, std::vector<float>& ref_q);
 
     void expand_to_q(std::vector<int>& ref_p, std::vector<float>& ref_q, std::vector<float>& q);
 
     float get_kl_divergence(std::vector<int>&ref_p, std::vector<float>& q);
 
+    int get_kl_thresh(std::vector<int>& hist);
+
+    std::vector<int> get_kl_threshes();
+
+    int prefetch_batch_data();
+
+    int next_batch_data(std::vector<Tensor4dPtr<Ttype>> inputs);
+
     void get_histgrams(std::vector<Tensor4dPtr<Ttype>> in_vec,
             std::vector<OperatorFunc<Ttype, Precision::FP32 >> exec_funcs);
 
@@ -86,9 +104,14 @@ private:
     std::vector<float>& max_vec() {return _max_vec;}
 
     std::vector<std::vector<int>>& hist_vecs() {return _hist_vecs;}
-    
-protected:
-    std::vector<Tensor4dPtr<X86>> _in_vec;
+
+    /// staging tensors the prefetch thread reads the next batch into in streaming mode,
+    /// next_batch_data copies them to the net inputs once the previous run is done
+    std::vector<Tensor4dPtr<Ttype>> _in_vec;
+
+    std::future<int> _prefetch;
+
+    bool _streaming{false};
 
     std::map<std::string, float> _scale_map;
 
@@ -2,9 +2,14 @@
 #include "saber/funcs/debug.h"
 #include "framework/core/mem_info.h"
 #include "framework/core/net/auto_layout_config.h"
+#include "framework/graph/llvm/optimizer/memory_scheduler.h"
 #ifdef ENABLE_OP_TIMER
 #include "saber/funcs/timer.h"
 #endif
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <unordered_map>
 
 namespace anakin {
 
@@ -100,7 +105,11 @@ load_calibrator_config(graph::Graph<Ttype, Ptype>& graph, bool load_layout_from_
         } else if (is_all_nchw) {
                     LOG(INFO) << "ready to config layout";
             AutoLayoutConfigHelper<Ttype, Ptype> helper;
-            helper.scane_dfs_from_input(graph);
+
+            if (!helper.cost_model_layout(graph)) {
+                helper.scane_dfs_from_input(graph);
+            }
+
             helper.print_layout();
 
             if (helper.check_merge(graph)) {
@@ -209,6 +218,10 @@ void Net<Ttype, Ptype, RunType>::init(graph::Graph<Ttype, Ptype>& graph, \
     }
     // init memory of _graph_p
     init_memory();
+    plan_shape_const();
+    _session_planned = false;
+    // after plan_shape_const: the outputs of shape const ops get no views
+    plan_inplace_views();
 }
 
 
@@ -369,6 +382,10 @@ void Net<Ttype, Ptype, RunType>::init(graph::Graph<Ttype, Ptype>& graph,bool aut
     this->_graph_p->statistics.template set_info<graph::SYSTEM_MEM>(curr_mem_in_mb_end - curr_mem_in_mb_start);
     // init memory of _graph_p
     init_memory();
+    plan_shape_const();
+    _session_planned = false;
+    // after plan_shape_const: the outputs of shape const ops get no views
+    plan_inplace_views();
 
     graph.statistics = _graph_p->statistics; // copy statistic back
     LOG(INFO) << "Temp mem used:        " << this->_graph_p->statistics.template
@@ -422,7 +439,13 @@ void Net<Ttype, Ptype, RunType>::prediction() {
 #ifdef ENABLE_DEBUG
     int op_cnt = 0;
 #endif
-    for (auto& executer : _exec_funcs) {
+    // shapes changed: move the in-place views, the memory planned at init is kept
+    update_inplace_views();
+    // a shape const op launched again makes the ones after it launch too
+    bool const_launched = false;
+
+    for (int exec_id = 0; exec_id < _exec_funcs.size(); exec_id++) {
+        auto& executer = _exec_funcs[exec_id];
         if (RunType == OpRunType::SYNC || executer.need_sync || executer.op_name == "Output") {
             for (int i = 0; i < executer.ins.size(); i++) {
                 // sync event record in multi_stream or syn when encountering output op
@@ -448,9 +471,39 @@ void Net<Ttype, Ptype, RunType>::prediction() {
         my_time.start(ctx);
 #endif
 
-        if (executer.op_name != "Input" && executer.op_name != "Output") {
-            executer.infer_shape();
+        if (executer.op_name != "Input" && executer.op_name != "Output"
+                && (const_launched || !executer.shape_cached())) {
+            // at the shapes of the last launch there is nothing to infer: the steady state
+            // only runs the kernels, and should not allocate
+            bool steady = executer.shapes_inferred();
+            size_t allocs = _alloc_audit ? thread_alloc_count() : 0;
+            if (!steady) {
+                // all shapes were inferred when the views were placed, new ones come from data
+                if (_inplace_placed && writes_inplace_views(exec_id)) {
+                    drop_inplace_views(exec_id);
+                }
+                executer.infer_shape();
+            }
             executer.launch();
+            if (writes_inplace_views(exec_id) && !executer.shapes_inferred()) {
+                // the launch reshaped its outputs
+                drop_inplace_views(exec_id);
+            }
+            if (_alloc_audit && steady) {
+                allocs = thread_alloc_count() - allocs;
+                if (allocs > 0) {
+                    size_t& total = _alloc_audit_counts[executer.name];
+                    if (total == 0) {
+                        LOG(WARNING) << "alloc audit: " << executer.name << " (" << executer.op_name
+                                     << ") allocates " << allocs << " times in steady state";
+                    }
+                    total += allocs;
+                }
+            }
+            if (executer.shape_const) {
+                executer.cache_shapes();
+                const_launched = true;
+            }
         }
 
         for (int i = 0; i < executer.outs.size(); i++) {
@@ -635,6 +688,8 @@ void Net<Ttype, Ptype, RunType>::init() {
     this->_graph_p->statistics.template set_info<graph::SYSTEM_MEM>(curr_mem_in_mb_end - curr_mem_in_mb_start);
     // init memory of _graph_p
     init_memory();
+    plan_shape_const();
+    _session_planned = false;
 
     LOG(INFO) << "Temp mem used:        " << this->_graph_p->statistics.template
             get_info<graph::TEMP_MEM>() << " MB";
@@ -658,6 +713,8 @@ void Net<Ttype, Ptype, RunType>::execute_stop_at_node(std::string node_name) {
         }
     }
 
+    update_inplace_views();
+
     for (int i = 0; i < _suspended_point; i++) {
         auto& executer = _exec_funcs[i];
 
@@ -686,8 +743,14 @@ void Net<Ttype, Ptype, RunType>::execute_stop_at_node(std::string node_name) {
 #endif
 
         if (executer.op_name != "Input") {
+            if (_inplace_placed && writes_inplace_views(i) && !executer.shapes_inferred()) {
+                drop_inplace_views(i);
+            }
             executer.infer_shape();
             executer.launch();
+            if (writes_inplace_views(i) && !executer.shapes_inferred()) {
+                drop_inplace_views(i);
+            }
         }
 
         for (int i = 0; i < executer.outs.size(); i++) {
@@ -706,6 +769,8 @@ void Net<Ttype, Ptype, RunType>::execute_start_from_node(std::string node_name)
         }
     }
 
+    update_inplace_views();
+
     for (int i = _start_point; i < _exec_funcs.size(); i++) {
         auto& executer = _exec_funcs[i];
 
@@ -734,8 +799,14 @@ void Net<Ttype, Ptype, RunType>::execute_start_from_node(std::string node_name)
 #endif
 
         if (executer.op_name != "Input") {
+            if (_inplace_placed && writes_inplace_views(i) && !executer.shapes_inferred()) {
+                drop_inplace_views(i);
+            }
             executer.infer_shape();
             executer.launch();
+            if (writes_inplace_views(i) && !executer.shapes_inferred()) {
+                drop_inplace_views(i);
+            }
         }
 
         for (int i = 0; i < executer.outs.size(); i++) {
@@ -783,6 +854,510 @@ std::vector<Tensor4dPtr<Ttype> > Net<Ttype, Ptype, RunType>::get_in_list() {
     return _in_tensor_list;
 }
 
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Ptype, RunType>::bind_input(std::string in_name, void* ptr,
+                                              std::vector<int> shape,
+                                              std::vector<std::vector<int>> seq_offset) {
+    if (reinterpret_cast<size_t>(ptr) % MALLOC_ALIGN != 0) {
+        return Status::ANAKINFAIL("bind_input: data pointer is not aligned to MALLOC_ALIGN");
+    }
+    auto tensor_p = get_in(in_name);
+    if (shape.size() != tensor_p->dims()) {
+        return Status::ANAKINFAIL("bind_input: shape dims mismatch with the input tensor");
+    }
+    // edges sharing the input memory (Split, Reshape, Flatten, Gather outputs, in-place
+    // consumers, slices of it) would keep reading the old buffer after the rebind
+    const char* begin = static_cast<const char*>(tensor_p->data());
+    const char* end = begin + tensor_p->capacity();
+    for (auto& executer : _exec_funcs) {
+        for (auto* tensors : {&executer.ins, &executer.outs}) {
+            for (auto& tensor : *tensors) {
+                const char* data = static_cast<const char*>(tensor->data());
+                if (tensor != tensor_p && begin != nullptr && data >= begin && data < end) {
+                    return Status::ANAKINFAIL("bind_input: input shares memory with other edges");
+                }
+            }
+        }
+    }
+    Shape bind_shape(shape, tensor_p->get_layout());
+    tensor_p->set_external_data(static_cast<typename Tensor4d<Ttype>::BaseDtype>(ptr),
+                                bind_shape.count() * tensor_p->get_dtype_size());
+    tensor_p->reshape(bind_shape);
+    tensor_p->set_seq_offset(seq_offset);
+    return Status::OK();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Ptype, RunType>::bind_output(std::string out_name, void* ptr, size_t capacity) {
+    if (reinterpret_cast<size_t>(ptr) % MALLOC_ALIGN != 0) {
+        return Status::ANAKINFAIL("bind_output: data pointer is not aligned to MALLOC_ALIGN");
+    }
+    auto tensor_p = get_out(out_name);
+    if (capacity < tensor_p->valid_size() * tensor_p->get_dtype_size()) {
+        return Status::ANAKINFAIL("bind_output: capacity is smaller than the output");
+    }
+    // an output reusing the memory of another edge (in-place ops, memory optimizer) is not
+    // written by its own producer, rebinding it alone would lose the result
+    const void* data = tensor_p->data();
+    for (auto& executer : _exec_funcs) {
+        for (auto& tensor : executer.outs) {
+            if (tensor != tensor_p && data != nullptr && tensor->data() == data) {
+                return Status::ANAKINFAIL("bind_output: output shares memory with other edges");
+            }
+        }
+    }
+    Shape out_shape = tensor_p->valid_shape();
+    tensor_p->set_external_data(static_cast<typename Tensor4d<Ttype>::BaseDtype>(ptr), capacity);
+    tensor_p->reshape(out_shape);
+    drop_shape_cache();
+    return Status::OK();
+}
+
+/// image_preprocess on the input tensor, only host x86 tensors have it
+template<typename Ttype>
+Status preprocess_image(const saber::ImagePreprocessParam& param, const unsigned char* data,
+                        int num, int height, int width, int row_stride, Tensor4d<Ttype>& tensor) {
+    return Status::ANAKINFAIL("feed_image: image preprocessing is only supported on x86");
+}
+
+#ifdef USE_X86_PLACE
+template<>
+Status preprocess_image<X86>(const saber::ImagePreprocessParam& param, const unsigned char* data,
+                             int num, int height, int width, int row_stride, Tensor4d<X86>& tensor) {
+    SaberStatus status = saber::image_preprocess(param, data, num, height, width, row_stride,
+                                                 tensor);
+    if (status == SaberUnImplError) {
+        return Status::ANAKINFAIL("feed_image: input layout is not supported by image preprocessing");
+    }
+    if (status != SaberSuccess) {
+        return Status::ANAKINFAIL("feed_image: invalid image preprocessing parameters");
+    }
+    return Status::OK();
+}
+#endif
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Ptype, RunType>::set_input_preprocess(std::string in_name,
+                                                        const saber::ImagePreprocessParam& param) {
+    auto& ins = _graph_p->get_ins();
+    if (std::find(ins.begin(), ins.end(), in_name) == ins.end()) {
+        return Status::ANAKINFAIL("set_input_preprocess: no input of that name");
+    }
+    _in_preprocess[in_name] = param;
+    return Status::OK();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Ptype, RunType>::feed_image(std::string in_name, const unsigned char* data, int num,
+                                              int height, int width, int row_stride) {
+    auto it = _in_preprocess.find(in_name);
+    if (it == _in_preprocess.end()) {
+        return Status::ANAKINFAIL("feed_image: input has no preprocessing stage");
+    }
+    return preprocess_image<Ttype>(it->second, data, num, height, width, row_stride, *get_in(in_name));
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::unbind(std::string name) {
+    auto& ins = _graph_p->get_ins();
+    bool is_input = std::find(ins.begin(), ins.end(), name) != ins.end();
+    auto tensor_p = is_input ? get_in(name) : get_out(name);
+    tensor_p->set_external_data(nullptr, 0);
+    drop_shape_cache();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::plan_inplace_views() {
+    typedef typename TargetTypeTraits<Ttype>::target_category target_category;
+    detach_inplace_views();
+    _inplace_ops.clear();
+    _inplace_tensors.clear();
+    _inplace_in_shapes.clear();
+    _inplace_in_offsets.clear();
+    _inplace_writes.assign(_exec_funcs.size(), std::vector<int>());
+    _inplace_launched = false;
+    if (!_inplace_views || !std::is_same<target_category, __host_target>::value) {
+        return;
+    }
+    // a view needs memory no other tensor uses: memory optimizer reuse, in-place ops
+    // (Reshape, Split...) and the tensors of earlier planned ops all share data
+    std::unordered_map<const void*, std::set<Tensor4dPtr<Ttype> > > holders;
+    std::unordered_map<Tensor4dPtr<Ttype>, std::string> producer;
+    std::set<Tensor4dPtr<Ttype> > claimed;
+    // outputs of shape const ops are written once per input shape and must stay where
+    // they were written, see plan_shape_const
+    std::set<Tensor4dPtr<Ttype> > shape_const;
+    for (auto& executer : _exec_funcs) {
+        for (auto tensor : executer.ins) {
+            holders[tensor->data()].insert(tensor);
+        }
+        for (auto tensor : executer.outs) {
+            holders[tensor->data()].insert(tensor);
+            producer[tensor] = executer.op_name;
+            if (executer.shape_const) {
+                shape_const.insert(tensor);
+            }
+        }
+    }
+    auto exclusive = [&](Tensor4dPtr<Ttype> tensor) {
+        return tensor->data() != nullptr && holders[tensor->data()].size() == 1
+               && claimed.count(tensor) == 0 && tensor->get_dtype() == AK_FLOAT
+               && producer[tensor] != "Input" && shape_const.count(tensor) == 0;
+    };
+
+    for (int i = 0; i < _exec_funcs.size(); i++) {
+        auto& executer = _exec_funcs[i];
+        bool is_concat = executer.op_name == "Concat";
+        if (!is_concat && executer.op_name != "Slice") {
+            continue;
+        }
+        auto& whole = is_concat ? executer.outs : executer.ins;
+        auto& parts = is_concat ? executer.ins : executer.outs;
+        if (whole.size() != 1 || parts.size() < 2 || !exclusive(whole[0])) {
+            continue;
+        }
+        std::set<Tensor4dPtr<Ttype> > distinct(parts.begin(), parts.end());
+        bool ok = distinct.size() == parts.size();
+        for (int j = 0; ok && j < parts.size(); j++) {
+            ok = exclusive(parts[j]) && parts[j]->get_layout() == whole[0]->get_layout();
+        }
+        // the declared shapes have to fit too, other shapes are checked at each placement
+        if (!ok || !inplace_view_fits(executer)) {
+            continue;
+        }
+        _inplace_ops.push_back(i);
+        claimed.insert(whole[0]);
+        for (auto part : parts) {
+            claimed.insert(part);
+            _inplace_tensors.push_back(part);
+        }
+    }
+
+    // the producers of the aliased tensors and the op itself (writing the Concat output or
+    // the Slice outputs) can move the views when they change shape
+    for (int idx : _inplace_ops) {
+        auto& executer = _exec_funcs[idx];
+        std::set<Tensor4dPtr<Ttype> > aliased(executer.ins.begin(), executer.ins.end());
+        aliased.insert(executer.outs.begin(), executer.outs.end());
+        for (int i = 0; i < _exec_funcs.size(); i++) {
+            for (auto tensor : _exec_funcs[i].outs) {
+                if (aliased.count(tensor) > 0) {
+                    _inplace_writes[i].push_back(idx);
+                    break;
+                }
+            }
+        }
+    }
+    // nothing is placed until the first prediction has shown which producers reshape
+    // their outputs when launched, see update_inplace_views
+    if (!_inplace_ops.empty()) {
+        LOG(INFO) << "in-place views planned for " << _inplace_ops.size() << " Concat/Slice ops";
+    }
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+bool Net<Ttype, Ptype, RunType>::inplace_view_fits(OperatorFunc<Ttype, Ptype>& executer) {
+    bool is_concat = executer.op_name == "Concat";
+    auto& whole = is_concat ? executer.outs : executer.ins;
+    auto& parts = is_concat ? executer.ins : executer.outs;
+    // the parts are contiguous ranges of the whole only if nothing is in front of the axis
+    int axis = (*_graph_p)[executer.name]->template get_attr<int>("axis");
+    Shape whole_shape = whole[0]->valid_shape();
+    bool ok = axis < whole_shape.size() && whole[0]->is_continue_mem();
+    for (int i = 0; ok && i < axis; i++) {
+        ok = whole_shape[i] == 1;
+    }
+    long long total = 0;
+    for (int i = 0; ok && i < parts.size(); i++) {
+        ok = parts[i]->is_continue_mem();
+        total += parts[i]->valid_size();
+    }
+    return ok && total == whole[0]->valid_size();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::place_inplace_views() {
+    for (int idx : _inplace_ops) {
+        auto& executer = _exec_funcs[idx];
+        executer.skip_launch = inplace_view_fits(executer);
+        if (!executer.skip_launch) {
+            // the parts keep their own memory and the op runs
+            continue;
+        }
+        bool is_concat = executer.op_name == "Concat";
+        auto& whole = is_concat ? executer.outs : executer.ins;
+        auto& parts = is_concat ? executer.ins : executer.outs;
+        char* base = static_cast<char*>(whole[0]->mutable_data());
+        size_t offset = 0;
+        for (auto part : parts) {
+            Shape part_shape = part->valid_shape();
+            size_t bytes = part->valid_size() * part->get_dtype_size();
+            // the part's own buffer is kept for the shapes that do not fit
+            part->set_external_data(base + offset, bytes);
+            part->reshape(part_shape);
+            offset += bytes;
+        }
+    }
+    _inplace_placed = true;
+
+    _inplace_in_shapes.clear();
+    _inplace_in_offsets.clear();
+    for (auto& executer : _exec_funcs) {
+        if (executer.op_name == "Input") {
+            for (auto tensor : executer.outs) {
+                _inplace_in_shapes.push_back(tensor->valid_shape());
+                _inplace_in_offsets.push_back(tensor->get_seq_offset());
+            }
+        }
+    }
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::detach_inplace_views() {
+    for (auto tensor : _inplace_tensors) {
+        Shape shape = tensor->valid_shape();
+        tensor->set_external_data(nullptr, 0);
+        // the own buffer was sized for the shapes before the view
+        tensor->reshape(shape);
+    }
+    for (int idx : _inplace_ops) {
+        _exec_funcs[idx].skip_launch = false;
+    }
+    _inplace_placed = false;
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+bool Net<Ttype, Ptype, RunType>::inplace_views_placed() {
+    int idx = 0;
+    for (auto& executer : _exec_funcs) {
+        if (executer.op_name == "Input") {
+            for (auto tensor : executer.outs) {
+                if (idx >= _inplace_in_shapes.size()
+                        || !(tensor->valid_shape() == _inplace_in_shapes[idx])
+                        || tensor->get_seq_offset() != _inplace_in_offsets[idx]) {
+                    return false;
+                }
+                idx++;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::update_inplace_views() {
+    if (_inplace_ops.empty() || inplace_views_placed()) {
+        return;
+    }
+    if (!_inplace_launched) {
+        // the first prediction launches every op for real, so a producer setting its output
+        // shapes in the launch is dropped before it ever writes into a view
+        _inplace_launched = true;
+        return;
+    }
+    // the offsets of the parts depend on the shapes of all of them, so every shape is
+    // inferred before any producer writes; the launches after that have nothing to infer
+    detach_inplace_views();
+    drop_shape_cache();
+    for (auto& executer : _exec_funcs) {
+        if (executer.op_name != "Input" && executer.op_name != "Output"
+                && !executer.shapes_inferred()) {
+            executer.infer_shape();
+        }
+    }
+    place_inplace_views();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::drop_inplace_views(int exec_id) {
+    for (int idx : _inplace_writes[exec_id]) {
+        auto it = std::find(_inplace_ops.begin(), _inplace_ops.end(), idx);
+        if (it == _inplace_ops.end()) {
+            continue;
+        }
+        _inplace_ops.erase(it);
+        auto& executer = _exec_funcs[idx];
+        bool is_concat = executer.op_name == "Concat";
+        auto& parts = is_concat ? executer.ins : executer.outs;
+        for (auto part : parts) {
+            const void* view = part->data();
+            Shape shape = part->valid_shape();
+            part->set_external_data(nullptr, 0);
+            part->reshape(shape);
+            if (executer.skip_launch) {
+                // the producers run so far wrote into the view
+                memcpy(part->mutable_data(), view, part->valid_size() * part->get_dtype_size());
+            }
+            _inplace_tensors.erase(std::find(_inplace_tensors.begin(), _inplace_tensors.end(), part));
+        }
+        executer.skip_launch = false;
+        LOG(INFO) << "in-place views of " << executer.name << " dropped, "
+                  << _exec_funcs[exec_id].name << " writes shapes depending on data";
+    }
+    _inplace_writes[exec_id].clear();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::plan_shape_const() {
+    std::unordered_map<Tensor4dPtr<Ttype>, int> producer;
+    // ops writing each memory block: memory optimizer reuse and in-place ops share data pointers
+    std::unordered_map<const void*, std::vector<int> > writers;
+    for (int i = 0; i < _exec_funcs.size(); i++) {
+        _exec_funcs[i].shape_const = false;
+        _exec_funcs[i].has_cache = false;
+        for (auto tensor : _exec_funcs[i].outs) {
+            producer[tensor] = i;
+            writers[tensor->data()].push_back(i);
+        }
+    }
+    if (!_shape_const_cache) {
+        return;
+    }
+    graph::check_shape_const is_shape_const;
+    auto shape_const_of = [&](OperatorFunc<Ttype, Ptype>& executer) {
+        std::vector<bool> ins_const;
+        for (auto tensor : executer.ins) {
+            auto it = producer.find(tensor);
+            ins_const.push_back(it != producer.end() && _exec_funcs[it->second].shape_const);
+        }
+        return is_shape_const(executer.op_name, ins_const);
+    };
+    // candidates in exec order, then drop the ones sharing memory with an op launched every
+    // prediction (a plan from an older optimizer), and the ones fed by them, until none is left
+    for (auto& executer : _exec_funcs) {
+        executer.shape_const = shape_const_of(executer);
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto& executer : _exec_funcs) {
+            if (!executer.shape_const) {
+                continue;
+            }
+            bool keep = shape_const_of(executer);
+            for (auto tensor : executer.outs) {
+                for (int writer : writers[tensor->data()]) {
+                    keep = keep && tensor->data() != nullptr && _exec_funcs[writer].shape_const;
+                }
+            }
+            if (!keep) {
+                executer.shape_const = false;
+                changed = true;
+            }
+        }
+    }
+
+    int planned = std::count_if(_exec_funcs.begin(), _exec_funcs.end(),
+                                [](OperatorFunc<Ttype, Ptype>& executer) { return executer.shape_const; });
+    if (planned > 0) {
+        LOG(INFO) << planned << " shape const ops are launched once per input shape";
+    }
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::drop_shape_cache() {
+    for (auto& executer : _exec_funcs) {
+        executer.has_cache = false;
+    }
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Net<Ttype, Ptype, RunType>::plan_session_states() {
+    _state_ops.clear();
+    _state_op_slots.clear();
+    _state_widths.clear();
+    for (int i = 0; i < _exec_funcs.size(); i++) {
+        auto* helper = _exec_funcs[i].op->_helper;
+        std::vector<int> sizes = helper != nullptr ? helper->StateSizes() : std::vector<int>();
+        if (sizes.empty()) {
+            continue;
+        }
+        _state_ops.push_back(i);
+        _state_op_slots.push_back(_state_widths.size());
+        _state_widths.insert(_state_widths.end(), sizes.begin(), sizes.end());
+    }
+    _state_tensors.resize(_state_widths.size());
+    _session_planned = true;
+    LOG(INFO) << "session states: " << _state_ops.size() << " ops, " << _state_widths.size() << " slots";
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::shared_ptr<RnnSessionStore> Net<Ttype, Ptype, RunType>::session_store() {
+    if (!_session_store) {
+        _session_store = std::make_shared<RnnSessionStore>();
+    }
+    return _session_store;
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+bool Net<Ttype, Ptype, RunType>::end_session(uint64_t session_id) {
+    return session_store()->end(session_id);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+Status Net<Ttype, Ptype, RunType>::session_prediction(const std::vector<uint64_t>& session_ids) {
+    typedef typename TargetTypeTraits<Ttype>::target_category target_category;
+    if (!std::is_same<target_category, __host_target>::value) {
+        return Status::ANAKINFAIL("session_prediction: sessions are only supported on host targets");
+    }
+    if (!_session_planned) {
+        plan_session_states();
+    }
+    if (_state_ops.empty()) {
+        return Status::ANAKINFAIL("session_prediction: the net has no op carrying state");
+    }
+    // one session per sequence of the batch
+    auto in_p = _in_tensor_list[0];
+    auto offsets = in_p->get_seq_offset();
+    int batch = offsets.empty() ? in_p->num() : offsets.back().size() - 1;
+    if (batch != session_ids.size()) {
+        return Status::ANAKINFAIL("session_prediction: one session id per input sequence");
+    }
+
+    auto store = session_store();
+    store->evict_idle();
+    std::vector<float*> rows(_state_widths.size());
+    for (int s = 0; s < _state_widths.size(); s++) {
+        Shape shape({batch, _state_widths[s], 1, 1}, Layout_NCHW);
+        _state_tensors[s].re_alloc(shape, AK_FLOAT);
+    }
+    for (int i = 0; i < batch; i++) {
+        for (int s = 0; s < _state_widths.size(); s++) {
+            rows[s] = static_cast<float*>(_state_tensors[s].mutable_data()) + i * _state_widths[s];
+        }
+        store->load(session_ids[i], rows, _state_widths);
+    }
+
+    Status status = Status::OK();
+    for (int k = 0; k < _state_ops.size() && status == Status::OK(); k++) {
+        auto* helper = _exec_funcs[_state_ops[k]].op->_helper;
+        int slot_end = k + 1 < _state_ops.size() ? _state_op_slots[k + 1] : _state_widths.size();
+        std::vector<Tensor4dPtr<Ttype> > states;
+        for (int s = _state_op_slots[k]; s < slot_end; s++) {
+            states.push_back(&_state_tensors[s]);
+        }
+        status = helper->BindState(states);
+    }
+    if (status == Status::OK()) {
+        prediction();
+    }
+    for (int k = 0; k < _state_ops.size(); k++) {
+        _exec_funcs[_state_ops[k]].op->_helper->BindState({});
+    }
+    if (status != Status::OK()) {
+        return status;
+    }
+
+    std::vector<const float*> final_rows(_state_widths.size());
+    for (int i = 0; i < batch; i++) {
+        for (int s = 0; s < _state_widths.size(); s++) {
+            final_rows[s] = static_cast<const float*>(_state_tensors[s].data()) + i * _state_widths[s];
+        }
+        store->save(session_ids[i], final_rows, _state_widths);
+    }
+    return Status::OK();
+}
+
 template<typename Ttype, Precision Ptype, OpRunType RunType>
 Tensor4dPtr<Ttype> Net<Ttype, Ptype, RunType>::get_tensor_from_edge(const char* from,
                                                                     const char* to) {
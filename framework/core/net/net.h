@@ -19,8 +19,11 @@
 #include "framework/graph/graph.h"
 #include "framework/core/net/operator_func.h"
 #include "framework/core/net/calibrator_factory.h"
+#include "framework/core/net/rnn_session.h"
+#include "framework/core/alloc_audit.h"
 #include "framework/utils/csv.h"
 #include "saber/core/tensor_op.h"
+#include "saber/funcs/impl/x86/saber_image_preprocess.h"
 
 namespace anakin {
 
@@ -203,6 +206,105 @@ public:
     Tensor4dPtr<Ttype> get_in(std::string in_name);
     std::vector<Tensor4dPtr<Ttype> > get_in_list();
 
+    /**
+     *  \brief Zero-copy input: the input tensor of in_name aliases caller-owned memory ptr
+     *  holding data of shape (and seq_offset), nothing is copied at prediction.
+     *  ptr must be aligned to MALLOC_ALIGN bytes and stay valid until unbind.
+     *  fails if other edges of the graph share the input memory (e.g. a Split right after
+     *  the input), the caller copies the data in then.
+     */
+    Status bind_input(std::string in_name, void* ptr, std::vector<int> shape,
+                      std::vector<std::vector<int>> seq_offset = {});
+
+    /**
+     *  \brief Zero-copy output: the op producing out_name writes straight into ptr.
+     *  capacity is in bytes and must hold the largest output the net can produce,
+     *  fails if the output tensor shares memory with other edges of the graph.
+     */
+    Status bind_output(std::string out_name, void* ptr, size_t capacity);
+
+    /**
+     *  \brief Drop a binding of bind_input/bind_output, the tensor owns memory again.
+     */
+    void unbind(std::string name);
+
+    /**
+     *  \brief Attach an image preprocessing stage to input in_name: feed_image then resizes,
+     *  swaps channels, normalizes and lays out uint8 HWC images straight into the input
+     *  tensor, in one multithreaded pass. Host x86 inputs only.
+     */
+    Status set_input_preprocess(std::string in_name, const saber::ImagePreprocessParam& param);
+
+    /**
+     *  \brief Fill input in_name from num uint8 HWC images of height x width through its
+     *  preprocessing stage, row_stride is in bytes (0 for packed rows).
+     */
+    Status feed_image(std::string in_name, const unsigned char* data, int num,
+                      int height, int width, int row_stride = 0);
+
+    /**
+     *  \brief Turn in-place Concat/Slice on or off, on by default for host targets.
+     *  Producers of a Concat write straight into their slice of its output and Slice outputs
+     *  are views of its input, so both ops become no-ops. The ops are picked at the declared
+     *  shapes, a change of the input shapes moves the views inside the same memory. The first
+     *  prediction runs without views; ops next to a producer whose output shapes depend on
+     *  data (set in its launch or changing at fixed input shapes) run for real from then on.
+     *  A producer growing its output in a launch beyond the view it got still fails. Takes
+     *  effect at the next init.
+     */
+    void set_inplace_views(bool enable) { _inplace_views = enable; }
+
+    /**
+     *  \brief Turn the shape const cache on or off, on by default. PriorBox, AnchorGenerator
+     *  and the ops fed by them only are launched again only when their input shapes change,
+     *  their outputs keep memory of their own. Takes effect at the next init.
+     */
+    void set_shape_const_cache(bool enable) { _shape_const_cache = enable; }
+
+    /**
+     *  \brief Turn the allocation audit on or off, off unless env ANAKIN_ALLOC_AUDIT is set.
+     *  An op launched at the shapes of its previous launch should not allocate: buffers only
+     *  grow, so once the net ran at its max input shapes smaller ones don't allocate either.
+     *  Every op which still allocates then is logged once and counted in alloc_audit().
+     *  Tensor buffers are always counted, all heap allocations with ENABLE_ALLOC_AUDIT.
+     */
+    void set_alloc_audit(bool enable) { _alloc_audit = enable; }
+
+    /**
+     *  \brief Allocations of each op (by node name) in steady state launches since the audit
+     *  was turned on.
+     */
+    const std::unordered_map<std::string, size_t>& alloc_audit() const {
+        return _alloc_audit_counts;
+    }
+
+    /**
+     *  \brief Streaming prediction: sequence i of the inputs is the next chunk of session
+     *  session_ids[i]. Every forward Lstm/Gru starts from the state the session's previous
+     *  chunk left (zeros for a new session) and the final state is kept for its next chunk.
+     *  Chunks of one session must not run concurrently. Host targets only.
+     */
+    Status session_prediction(const std::vector<uint64_t>& session_ids);
+
+    /**
+     *  \brief Forget the state of a session, returns false if it doesn't exist.
+     */
+    bool end_session(uint64_t session_id);
+
+    /**
+     *  \brief Drop the sessions idle for longer than idle_timeout_ms, 10 minutes by default.
+     */
+    void set_session_idle_timeout(int64_t idle_timeout_ms) {
+        session_store()->set_idle_timeout(idle_timeout_ms);
+    }
+
+    /**
+     *  \brief Share the session store with other nets (the threads of a Worker), by default
+     *  every net has its own.
+     */
+    void set_session_store(std::shared_ptr<RnnSessionStore> store) { _session_store = store; }
+    std::shared_ptr<RnnSessionStore> session_store();
+
     /**
      *  \brief Get tensor from a given edge.
      */
@@ -295,6 +397,67 @@ private:
      */
     Status init_env(graph::Graph<Ttype, Ptype>&);
 
+    /**
+     *  \brief Pick the Concat/Slice ops to run in place at the declared shapes and place
+     *  their views, see set_inplace_views.
+     */
+    void plan_inplace_views();
+
+    /**
+     *  \brief Whether the current shapes let the parts of a planned op be contiguous ranges
+     *  of the whole.
+     */
+    bool inplace_view_fits(OperatorFunc<Ttype, Ptype>& executer);
+
+    /**
+     *  \brief Point the parts of the planned ops into the whole at the current shapes,
+     *  ops whose shapes do not fit run on the parts' own memory.
+     */
+    void place_inplace_views();
+
+    /**
+     *  \brief Give the aliased tensors their own memory back, it is not freed by the views.
+     */
+    void detach_inplace_views();
+
+    /**
+     *  \brief Whether the net inputs still have the shapes the views were placed for.
+     */
+    bool inplace_views_placed();
+
+    /**
+     *  \brief Infer all shapes and move the views when the net inputs changed shape.
+     */
+    void update_inplace_views();
+
+    /**
+     *  \brief Whether executer exec_id writes a tensor aliased by a planned op, or is one.
+     */
+    bool writes_inplace_views(int exec_id) {
+        return exec_id < _inplace_writes.size() && !_inplace_writes[exec_id].empty();
+    }
+
+    /**
+     *  \brief Run the planned ops executer exec_id writes for real from now on, the shapes it
+     *  writes depend on data. Parts keep what was written into their views.
+     */
+    void drop_inplace_views(int exec_id);
+
+    /**
+     *  \brief Mark the shape const ops whose outputs no other op writes, see set_shape_const_cache.
+     */
+    void plan_shape_const();
+
+    /**
+     *  \brief Launch every shape const op again at the next prediction.
+     */
+    void drop_shape_cache();
+
+    /**
+     *  \brief Find the ops carrying recurrent state and size the session state slots.
+     */
+    void plan_session_states();
+
 private:
     ///< layout config file path , layout config will be load or create
     std::string _layout_config_path{""};
@@ -319,6 +482,37 @@ private:
 
     bool _need_summary{false};
 
+    ///< preprocessing stages of set_input_preprocess, by input name
+    std::unordered_map<std::string, saber::ImagePreprocessParam> _in_preprocess;
+
+    bool _inplace_views{true};
+    ///< indices in _exec_funcs of the Concat/Slice ops run in place
+    std::vector<int> _inplace_ops;
+    ///< tensors aliased into a Concat output or a Slice input
+    std::vector<Tensor4dPtr<Ttype> > _inplace_tensors;
+    ///< input shapes and seq offsets the views were placed for
+    std::vector<Shape> _inplace_in_shapes;
+    std::vector<std::vector<std::vector<int> > > _inplace_in_offsets;
+    ///< planned ops each executer writes into, by index in _exec_funcs
+    std::vector<std::vector<int> > _inplace_writes;
+    ///< the first prediction after planning ran, views are placed from the next one
+    bool _inplace_launched{false};
+    ///< views are placed at the current shapes
+    bool _inplace_placed{false};
+
+    bool _shape_const_cache{true};
+    bool _alloc_audit{alloc_audit_env()};
+    ///< steady state allocations by node name, see set_alloc_audit
+    std::unordered_map<std::string, size_t> _alloc_audit_counts;
+    ///< streaming sessions: ops carrying state, their first slot, the width of every slot
+    std::shared_ptr<RnnSessionStore> _session_store;
+    bool _session_planned{false};
+    std::vector<int> _state_ops;
+    std::vector<int> _state_op_slots;
+    std::vector<int> _state_widths;
+    ///< one row per sequence of the batch, bound to the ops during session_prediction
+    std::vector<Tensor4d<Ttype> > _state_tensors;
+
 #ifdef ENABLE_OP_TIMER
     std::vector<float> _op_time;
     std::vector<std::string> _op_param;
@@ -4,12 +4,64 @@ namespace anakin {
 
 template<typename Ttype, Precision Ptype>
 void OperatorFunc<Ttype, Ptype>::launch() {
+    if (skip_launch) {
+        return;
+    }
     (*op)(*ctx_p, ins, outs);
 }
 
 template<typename Ttype, Precision Ptype>
 void OperatorFunc<Ttype, Ptype>::infer_shape() {
     op->_helper->InferShape(ins, outs);
+    // assigned in place, so recording again at known shapes doesn't allocate
+    inferred_shapes.resize(ins.size() + outs.size());
+    inferred_offsets.resize(ins.size() + outs.size());
+    for (int i = 0; i < inferred_shapes.size(); i++) {
+        auto& tensor = i < ins.size() ? ins[i] : outs[i - ins.size()];
+        inferred_shapes[i] = tensor->valid_shape();
+        inferred_offsets[i] = tensor->get_seq_offset();
+    }
+    has_inferred = true;
+}
+
+template<typename Ttype, Precision Ptype>
+bool OperatorFunc<Ttype, Ptype>::shapes_inferred() {
+    if (!has_inferred || inferred_shapes.size() != ins.size() + outs.size()) {
+        return false;
+    }
+    for (int i = 0; i < inferred_shapes.size(); i++) {
+        auto& tensor = i < ins.size() ? ins[i] : outs[i - ins.size()];
+        if (!(tensor->valid_shape() == inferred_shapes[i])
+                || tensor->get_seq_offset() != inferred_offsets[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Ttype, Precision Ptype>
+bool OperatorFunc<Ttype, Ptype>::shape_cached() {
+    if (!shape_const || !has_cache) {
+        return false;
+    }
+    for (int i = 0; i < ins.size(); i++) {
+        if (!(ins[i]->valid_shape() == cached_shapes[i])
+                || ins[i]->get_seq_offset() != cached_offsets[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Ttype, Precision Ptype>
+void OperatorFunc<Ttype, Ptype>::cache_shapes() {
+    cached_shapes.clear();
+    cached_offsets.clear();
+    for (auto in : ins) {
+        cached_shapes.push_back(in->valid_shape());
+        cached_offsets.push_back(in->get_seq_offset());
+    }
+    has_cache = true;
 }
 
 #ifdef USE_CUDA
@@ -37,6 +37,23 @@ struct OperatorFunc {
      *  \brief Infer shape.
      */
     void infer_shape();
+
+    /** 
+     *  \brief Whether the inputs and outputs still have the shapes and seq offsets the last
+     *  infer_shape left, so inferring again would change nothing.
+     */
+    bool shapes_inferred();
+
+    /** 
+     *  \brief Whether a shape const op still holds the outputs of its last launch,
+     *  i.e. its inputs have the shapes and seq offsets they had then.
+     */
+    bool shape_cached();
+
+    /** 
+     *  \brief Remember the shapes the outputs of a shape const op were computed for.
+     */
+    void cache_shapes();
     
     ///< op running context.
     OpContextPtr<Ttype> ctx_p;
@@ -60,6 +77,22 @@ struct OperatorFunc {
 
     bool need_sync{false};
 
+    ///< outputs are views of the inputs (in-place Concat/Slice), only the shapes are inferred
+    bool skip_launch{false};
+
+    ///< outputs depend on the input shapes only (PriorBox...) or on such outputs only,
+    ///< they are computed once per input shape, see Net::plan_shape_const
+    bool shape_const{false};
+    ///< input shapes and seq offsets of the last launch of a shape const op
+    bool has_cache{false};
+    std::vector<Shape> cached_shapes;
+    std::vector<std::vector<std::vector<int> > > cached_offsets;
+
+    ///< shapes and seq offsets of the inputs then the outputs right after the last infer_shape
+    bool has_inferred{false};
+    std::vector<Shape> inferred_shapes;
+    std::vector<std::vector<std::vector<int> > > inferred_offsets;
+
     Operator<Ttype, Ptype>* op;
 
     ///< node name
@@ -0,0 +1,78 @@
+#include "framework/core/net/rnn_session.h"
+#include <algorithm>
+#include <cstring>
+
+namespace anakin {
+
+void RnnSessionStore::load(uint64_t id, const std::vector<float*>& rows,
+                           const std::vector<int>& widths) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto it = _sessions.find(id);
+    bool found = it != _sessions.end() && it->second.slots.size() == widths.size();
+
+    for (int s = 0; s < widths.size(); s++) {
+        if (found && it->second.slots[s].size() == widths[s]) {
+            memcpy(rows[s], it->second.slots[s].data(), widths[s] * sizeof(float));
+        } else {
+            memset(rows[s], 0, widths[s] * sizeof(float));
+        }
+    }
+
+    if (it != _sessions.end()) {
+        it->second.last_used = Clock::now();
+    }
+}
+
+void RnnSessionStore::save(uint64_t id, const std::vector<const float*>& rows,
+                           const std::vector<int>& widths) {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto& session = _sessions[id];
+    session.slots.resize(widths.size());
+
+    for (int s = 0; s < widths.size(); s++) {
+        session.slots[s].assign(rows[s], rows[s] + widths[s]);
+    }
+
+    session.last_used = Clock::now();
+}
+
+bool RnnSessionStore::end(uint64_t id) {
+    std::lock_guard<std::mutex> guard(_mut);
+    return _sessions.erase(id) > 0;
+}
+
+int RnnSessionStore::evict_idle() {
+    std::lock_guard<std::mutex> guard(_mut);
+    auto now = Clock::now();
+
+    if (now < _next_scan) {
+        return 0;
+    }
+
+    _next_scan = now + _idle_timeout / 4;
+    int evicted = 0;
+
+    for (auto it = _sessions.begin(); it != _sessions.end();) {
+        if (now - it->second.last_used > _idle_timeout) {
+            it = _sessions.erase(it);
+            evicted++;
+        } else {
+            ++it;
+        }
+    }
+
+    return evicted;
+}
+
+void RnnSessionStore::set_idle_timeout(int64_t idle_timeout_ms) {
+    std::lock_guard<std::mutex> guard(_mut);
+    _idle_timeout = std::chrono::milliseconds(idle_timeout_ms);
+    _next_scan = Clock::time_point();
+}
+
+int RnnSessionStore::size() {
+    std::lock_guard<std::mutex> guard(_mut);
+    return _sessions.size();
+}
+
+} /* namespace anakin */
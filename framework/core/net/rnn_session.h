@@ -0,0 +1,77 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_RNN_SESSION_H
+#define ANAKIN_RNN_SESSION_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "framework/core/thread_safe_macros.h"
+
+namespace anakin {
+
+/**
+ *  \brief recurrent state of streaming sessions, e.g. one per audio stream of a speech model.
+ *  A session holds one row per state slot of the net (hidden and cell of every Lstm, hidden of
+ *  every Gru...), it starts as zeros and takes the final state of each chunk it runs.
+ *  Thread safe, the nets of a Worker share one store so a session can move between threads.
+ *  Sessions not used for idle_timeout are dropped.
+ */
+class RnnSessionStore {
+public:
+    explicit RnnSessionStore(int64_t idle_timeout_ms = 10 * 60 * 1000)
+        : _idle_timeout(std::chrono::milliseconds(idle_timeout_ms)) {}
+
+    /**
+     *  \brief copy the state of session id to rows, rows[s] gets widths[s] floats of slot s.
+     *  New sessions (or sessions of other widths) read zeros.
+     */
+    void load(uint64_t id, const std::vector<float*>& rows, const std::vector<int>& widths);
+
+    /// store rows as the state of session id, creating it if needed.
+    void save(uint64_t id, const std::vector<const float*>& rows, const std::vector<int>& widths);
+
+    /// drop session id, returns false if it doesn't exist.
+    bool end(uint64_t id);
+
+    /**
+     *  \brief drop the sessions idle for longer than the timeout, returns how many.
+     *  The map is scanned at most every quarter of the timeout.
+     */
+    int evict_idle();
+
+    void set_idle_timeout(int64_t idle_timeout_ms);
+
+    /// number of live sessions.
+    int size();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    struct Session {
+        std::vector<std::vector<float> > slots;
+        Clock::time_point last_used;
+    };
+    std::unordered_map<uint64_t, Session> _sessions GUARDED_BY(_mut);
+    Clock::duration _idle_timeout GUARDED_BY(_mut);
+    Clock::time_point _next_scan GUARDED_BY(_mut);
+    std::mutex _mut;
+};
+
+} /* namespace anakin */
+
+#endif
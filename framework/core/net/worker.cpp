@@ -2,40 +2,61 @@
 
 #ifndef USE_SGX
 #include "saber/funcs/timer.h"
+#include "framework/core/numa.h"
+#include <cstdlib>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace anakin {
 
+/// omp team size of the worker thread when its net was created: kernels size per thread
+/// buffers by it (e.g. the winograd scratch), so a cpu lease never goes above it
+thread_local int t_net_threads = 0;
+
 //! \brief a model map between thread_id and net model
 template<typename Ttype, Precision Ptype, OpRunType RunType>
 struct NetGraphWrapper {
     typedef std::thread::id key;
 
-    void initial(std::string model_path, std::unordered_map<std::string, std::vector<int>>& shape_map) EXCLUSIVE_LOCKS_REQUIRED(this->_mut) {
+    /**
+     *  \brief load the model once per numa node, the first thread of a node does the load
+     *  so the weights are first touched (and placed) on that node.
+     */
+    void initial(std::string model_path, int node, std::unordered_map<std::string, std::vector<int>>& shape_map) EXCLUSIVE_LOCKS_REQUIRED(this->_mut) {
         std::lock_guard<std::mutex> guard(this->_mut);
-        if(_graph_map.count(model_path) <= 0) {
-            // graph load is thread safe
-            _graph_map[model_path].load(model_path);
-            for(auto it = shape_map.begin(); it != shape_map.end();) {
-                // thread safe
-                _graph_map[model_path].Reshape(it->first, it->second);
-                ++it;
+        std::string graph_key = model_path + "@node" + std::to_string(node);
+        if(_graph_map.count(graph_key) <= 0) {
+            auto& graph = _graph_map[graph_key];
+            // the optimized graph is cached on disk when ANAKIN_GRAPH_SNAPSHOT_DIR is set
+            const char* snapshot_dir = std::getenv("ANAKIN_GRAPH_SNAPSHOT_DIR");
+            std::string snapshot_key;
+            std::string snapshot_path;
+            // a model that can't be hashed has no key, it goes without the snapshot cache
+            if (snapshot_dir != nullptr
+                    && graph::Graph<Ttype, Ptype>::snapshot_key(model_path, shape_map, snapshot_key)) {
+                snapshot_path = std::string(snapshot_dir) + "/" + snapshot_key + ".anakin.snapshot";
             }
-            // thread safe
-            _graph_map[model_path].Optimize();
-            {// make sure thread safety
-                key id = std::this_thread::get_id();
-                LOG(INFO) << "CURRENT thread ID : " << id;
-                if(_thread_to_net.find(id) == _thread_to_net.end()) {
-                    _thread_to_net[id].init(_graph_map[model_path]);
+            if (snapshot_path.empty() || !graph.load_snapshot(snapshot_path, snapshot_key)) {
+                // graph load is thread safe
+                graph.load(model_path);
+                for(auto it = shape_map.begin(); it != shape_map.end();) {
+                    // thread safe
+                    graph.Reshape(it->first, it->second);
+                    ++it;
+                }
+                // thread safe
+                graph.Optimize();
+                if (!snapshot_path.empty()) {
+                    graph.save_snapshot(snapshot_path, snapshot_key);
                 }
-            }
-        } else {
-            key id = std::this_thread::get_id(); 
-            LOG(INFO) << "CURRENT thread ID : " << id; 
-            if (_thread_to_net.find(id) == _thread_to_net.end()) { 
-                _thread_to_net[id].init(_graph_map[model_path]); 
             }
         }
+        key id = std::this_thread::get_id();
+        LOG(INFO) << "CURRENT thread ID : " << id << " on numa node " << node;
+        if (_thread_to_net.find(id) == _thread_to_net.end()) {
+            _thread_to_net[id].init(_graph_map[graph_key]);
+        }
     }
 
     inline Net<Ttype, Ptype, RunType>& get_net(key id) {
@@ -56,7 +77,87 @@ template<typename Ttype, Precision Ptype, OpRunType RunType>
 using MultiThreadModel = Singleton<NetGraphWrapper<Ttype, Ptype, RunType>>;
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
-Worker<Ttype, Ptype, RunType>::Worker(std::string model_path, int num_thread) : _model_path(model_path), ThreadPool(num_thread) {}
+Worker<Ttype, Ptype, RunType>::Worker(std::string model_path, int num_thread) :
+    ThreadPool(num_thread, std::is_same<Ttype, X86>::value ? GlobalNumaTopology::Global().node_num() : 1),
+    _model_path(model_path),
+    _sessions(std::make_shared<RnnSessionStore>()) {
+    std::string model = model_path.substr(model_path.find_last_of('/') + 1);
+    auto& metrics = GlobalMetrics::Global();
+    _requests = &metrics.counter(metric_name("anakin_requests", "model", model));
+    _dropped = &metrics.counter(metric_name("anakin_dropped", "model", model));
+    _queue_depth = &metrics.gauge(metric_name("anakin_queue_depth", "model", model));
+    _queue_wait_us = &metrics.histogram(metric_name("anakin_queue_wait_us", "model", model));
+    _compute_us = &metrics.histogram(metric_name("anakin_compute_us", "model", model));
+    _cpu_wait_us = &metrics.histogram(metric_name("anakin_cpu_wait_us", "model", model));
+    _cpu_model = GlobalCpuScheduler::Global().model_id(model);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Ptype, RunType>::set_scheduling(float weight, int priority, int max_threads) {
+    GlobalCpuScheduler::Global().configure(_cpu_model, weight, priority, max_threads);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::chrono::steady_clock::time_point Worker<Ttype, Ptype, RunType>::task_queued() {
+    _queue_depth->add(1);
+    return std::chrono::steady_clock::now();
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Ptype, RunType>::task_started(std::chrono::steady_clock::time_point queued) {
+    _queue_depth->add(-1);
+    _queue_wait_us->record(elapsed_us(queued));
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Ptype, RunType>::task_done(std::chrono::steady_clock::time_point start) {
+    int64_t us = elapsed_us(start);
+    _compute_us->record(us);
+    _requests->add();
+    // exponential moving average with weight 1/8, lost updates between threads don't matter
+    int64_t avg = _run_time_us.load(std::memory_order_relaxed);
+    _run_time_us.store(avg == 0 ? us : avg + (us - avg) / 8, std::memory_order_relaxed);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+bool Worker<Ttype, Ptype, RunType>::shed_task() {
+    if (!this->shedding()) {
+        return false;
+    }
+    _dropped->add();
+    return true;
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::chrono::steady_clock::duration Worker<Ttype, Ptype, RunType>::expected_run_time() {
+    return std::chrono::microseconds(_run_time_us.load(std::memory_order_relaxed));
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+CpuLease Worker<Ttype, Ptype, RunType>::acquire_threads() {
+    // only nets running on the host cpu draw from the budget
+    if (!std::is_same<Ttype, typename target_host<Ttype>::type>::value) {
+        return CpuLease();
+    }
+    auto& scheduler = GlobalCpuScheduler::Global();
+    if (!scheduler.enabled()) {
+        return CpuLease();
+    }
+    auto start = std::chrono::steady_clock::now();
+    int node = this->thread_group() % scheduler.node_num();
+    // by default the worker threads of a node split it, as they did before the budget
+    int cap = std::max(1, scheduler.budget(node) / std::max(1, this->group_size(this->thread_group())));
+    if (t_net_threads > 0) {
+        // ANAKIN_CPU_BUDGET may exceed the cores the net was created for
+        cap = std::min(cap, t_net_threads);
+    }
+    CpuLease lease = scheduler.acquire(_cpu_model, node, cap);
+#ifdef USE_OPENMP
+    omp_set_num_threads(lease.threads());
+#endif
+    _cpu_wait_us->record(elapsed_us(start));
+    return lease;
+}
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
 Worker<Ttype, Ptype, RunType>::~Worker() {}
@@ -92,62 +193,188 @@ void Worker<Ttype, Ptype, RunType>::register_interior_edges(std::string bottom,
 }
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
-std::future<std::vector<Tensor4d<typename target_host<Ttype>::type> > > 
-Worker<Ttype, Ptype, RunType>::sync_prediction(std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_ins_list) {
-    auto task = [&](std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins) 
-                                -> std::vector<Tensor4d<typename target_host<Ttype>::type> > {
-        auto& net = MultiThreadModel<Ttype, Ptype, RunType>::Global().get_net(std::this_thread::get_id()); 
-        //fill the graph inputs
-
-        for(int i = 0; i < _inputs_in_order.size(); i++) { 
-            float* data = (float*)(ins[i].mutable_data());
-            for(int j=0; j<10; j++) {
-                LOG(INFO) << "------> data " << data[j];;
-            }
-            auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
-            d_tensor_in_p->reshape(ins[i].valid_shape());
-            d_tensor_in_p->copy_from(ins[i]);
-            d_tensor_in_p->set_seq_offset(ins[i].get_seq_offset());
+std::vector<Tensor4d<typename target_host<Ttype>::type> >
+Worker<Ttype, Ptype, RunType>::host_prediction(std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins,
+                                               const std::vector<uint64_t>* session_ids) {
+    CpuLease lease = acquire_threads();
+    auto start = std::chrono::steady_clock::now();
+    auto& net = MultiThreadModel<Ttype, Ptype, RunType>::Global().get_net(std::this_thread::get_id()); 
+    //fill the graph inputs
+
+    for(int i = 0; i < _inputs_in_order.size(); i++) { 
+        float* data = (float*)(ins[i].mutable_data());
+        for(int j=0; j<10; j++) {
+            DLOG(INFO) << "------> data " << data[j];;
         }
+        auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
+        d_tensor_in_p->reshape(ins[i].valid_shape());
+        d_tensor_in_p->copy_from(ins[i]);
+        d_tensor_in_p->set_seq_offset(ins[i].get_seq_offset());
+    }
 
 //        Context<NV> ctx(0, 0, 0);
 //        saber::SaberTimer<NV> my_time;
 //        my_time.start(ctx);
 #ifdef ENABLE_OP_TIMER
-        Context<Ttype> ctx(0, 0, 0);
-        saber::SaberTimer<Ttype> my_time;
-        my_time.start(ctx);
+    Context<Ttype> ctx(0, 0, 0);
+    saber::SaberTimer<Ttype> my_time;
+    my_time.start(ctx);
 #endif
+    if (session_ids == nullptr) {
         net.prediction();
+    } else {
+        Status status = net.session_prediction(*session_ids);
+        if (status != Status::OK()) {
+            LOG(ERROR) << "session prediction failed: " << status.info();
+            return {};
+        }
+    }
 //
 //        my_time.end(ctx);
 //        LOG(ERROR) << " exec  << time: " << my_time.get_average_ms() << " ms ";
 
 #ifdef ENABLE_OP_TIMER
-        my_time.end(ctx); 
-        {
-            std::lock_guard<std::mutex> guard(_mut); 
-            _thead_id_to_prediction_times_vec_in_ms[std::this_thread::get_id()].push_back(my_time.get_average_ms());
-            LOG(ERROR) << " exec  << time: " << my_time.get_average_ms() << " ms ";
-        }
+    my_time.end(ctx); 
+    {
+        std::lock_guard<std::mutex> guard(_mut); 
+        _thead_id_to_prediction_times_vec_in_ms[std::this_thread::get_id()].push_back(my_time.get_average_ms());
+        LOG(ERROR) << " exec  << time: " << my_time.get_average_ms() << " ms ";
+    }
 #endif
-        // get outputs of graph
-        std::vector<Tensor4d<typename target_host<Ttype>::type>> ret;
-        ret.resize(_outputs_in_order.size());
-        for (int out_idx = 0; out_idx <  _outputs_in_order.size(); out_idx++) {
-            auto d_tensor_out_p = net.get_out(_outputs_in_order[out_idx]);
-            ret[out_idx].re_alloc(d_tensor_out_p->valid_shape());
-            ret[out_idx].copy_from(*d_tensor_out_p);
-            float* data = (float*)(ret[out_idx].mutable_data());
-            LOG(INFO) << "this thread: " << std::this_thread::get_id();
-            for(int i=0; i< 10; i++) {
-                LOG(INFO) << "????? data " << data[i];
+    // get outputs of graph
+    std::vector<Tensor4d<typename target_host<Ttype>::type>> ret;
+    ret.resize(_outputs_in_order.size());
+    for (int out_idx = 0; out_idx <  _outputs_in_order.size(); out_idx++) {
+        auto d_tensor_out_p = net.get_out(_outputs_in_order[out_idx]);
+        ret[out_idx].re_alloc(d_tensor_out_p->valid_shape());
+        ret[out_idx].copy_from(*d_tensor_out_p);
+        float* data = (float*)(ret[out_idx].mutable_data());
+        DLOG(INFO) << "this thread: " << std::this_thread::get_id();
+        for(int i=0; i< 10; i++) {
+            DLOG(INFO) << "????? data " << data[i];
+        }
+    }
+
+    task_done(start);
+    return ret; 
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::future<std::vector<Tensor4d<typename target_host<Ttype>::type> > > 
+Worker<Ttype, Ptype, RunType>::sync_prediction(std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_ins_list,
+                                               const TaskOptions& options) {
+    auto queued = task_queued();
+    auto task = [this, queued](std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins) 
+                                -> std::vector<Tensor4d<typename target_host<Ttype>::type> > {
+        task_started(queued);
+        if (shed_task()) {
+            return {};
+        }
+        return host_prediction(ins);
+    };
+    return this->RunAsyncScheduled(options, task, net_ins_list);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::future<std::vector<Tensor4d<typename target_host<Ttype>::type> > >
+Worker<Ttype, Ptype, RunType>::session_prediction(std::vector<uint64_t> session_ids,
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_ins_list) {
+    auto queued = task_queued();
+    auto task = [this, queued](std::vector<uint64_t>& ids,
+                               std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins)
+                                -> std::vector<Tensor4d<typename target_host<Ttype>::type> > {
+        task_started(queued);
+        return host_prediction(ins, &ids);
+    };
+    return this->RunAsync(task, session_ids, net_ins_list);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+void Worker<Ttype, Ptype, RunType>::callback_prediction(
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_ins_list,
+        PredictionCallback done, std::chrono::steady_clock::time_point deadline, int priority) {
+    auto queued = task_queued();
+    auto task = [this, queued](std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins,
+                               PredictionCallback& done) -> Status {
+        task_started(queued);
+        std::vector<Tensor4d<typename target_host<Ttype>::type> > outs;
+        if (shed_task()) {
+            // can't make the deadline, don't spend a net run on it
+            Status status = Status::ANAKINFAIL("Deadline exceeded before prediction");
+            done(status, outs);
+            return status;
+        }
+        outs = host_prediction(ins);
+        done(Status::OK(), outs);
+        return Status::OK();
+    };
+    // nobody waits on the future, the result goes to done
+    this->RunAsyncScheduled(TaskOptions(priority, deadline), task, net_ins_list, done);
+}
+
+template<typename Ttype, Precision Ptype, OpRunType RunType>
+std::future<Status> Worker<Ttype, Ptype, RunType>::sync_prediction_bind(
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_ins_list,
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_outs_list,
+        const TaskOptions& options) {
+    typedef std::vector<Tensor4d<typename target_host<Ttype>::type> > HostList;
+    auto queued = task_queued();
+    auto task = [this, queued](HostList* ins, HostList* outs) -> Status {
+        task_started(queued);
+        if (shed_task()) {
+            return Status::ANAKINFAIL("Deadline exceeded before prediction");
+        }
+        CpuLease lease = acquire_threads();
+        auto start = std::chrono::steady_clock::now();
+        auto& net = MultiThreadModel<Ttype, Ptype, RunType>::Global().get_net(std::this_thread::get_id());
+        // host memory can only be aliased when the net itself runs on the host
+        bool zero_copy = std::is_same<Ttype, typename target_host<Ttype>::type>::value;
+        std::vector<std::string> bound;
+
+        for (int i = 0; i < _inputs_in_order.size(); i++) {
+            auto& in = (*ins)[i];
+            if (zero_copy && net.bind_input(_inputs_in_order[i], in.mutable_data(),
+                                            in.valid_shape(), in.get_seq_offset()) == Status::OK()) {
+                bound.push_back(_inputs_in_order[i]);
+                continue;
             }
+            auto d_tensor_in_p = net.get_in(_inputs_in_order[i]);
+            d_tensor_in_p->reshape(in.valid_shape());
+            d_tensor_in_p->copy_from(in);
+            d_tensor_in_p->set_seq_offset(in.get_seq_offset());
         }
 
-        return ret; 
+        std::vector<bool> out_bound(_outputs_in_order.size(), false);
+        for (int i = 0; i < _outputs_in_order.size(); i++) {
+            auto& out = (*outs)[i];
+            out_bound[i] = zero_copy && out.capacity() > 0
+                           && net.bind_output(_outputs_in_order[i], out.mutable_data(),
+                                              out.capacity()) == Status::OK();
+            if (out_bound[i]) {
+                bound.push_back(_outputs_in_order[i]);
+            }
+        }
+
+        net.prediction();
+
+        for (int i = 0; i < _outputs_in_order.size(); i++) {
+            auto d_tensor_out_p = net.get_out(_outputs_in_order[i]);
+            auto& out = (*outs)[i];
+            out.reshape(d_tensor_out_p->valid_shape());
+            if (!out_bound[i]) {
+                out.copy_from(*d_tensor_out_p);
+            }
+            out.set_seq_offset(d_tensor_out_p->get_seq_offset());
+        }
+
+        // never leave the net pointing at caller memory between requests
+        for (auto& name : bound) {
+            net.unbind(name);
+        }
+        task_done(start);
+        return Status::OK();
     };
-    return this->RunAsync(task, net_ins_list);
+    return this->RunAsyncScheduled(options, task, &net_ins_list, &net_outs_list);
 }
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
@@ -173,9 +400,13 @@ std::future<std::vector<Tensor4dPtr<Ttype> > > Worker<Ttype, Ptype, RunType>::sy
 }
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
-void Worker<Ttype, Ptype, RunType>::async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type> >& net_ins_list) {
+void Worker<Ttype, Ptype, RunType>::async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type> >& net_ins_list,
+                                                const TaskOptions& options) {
     std::lock_guard<std::mutex> guard(this->_async_que_mut);    
     auto task = [&](std::vector<Tensor4dPtr<typename target_host<Ttype>::type> >& ins) -> std::vector<Tensor4dPtr<Ttype> > {
+            if (shed_task()) {
+                return {};
+            }
             auto& net = MultiThreadModel<Ttype, Ptype, RunType>::Global().get_net(std::this_thread::get_id());
             //fill the graph inputs
             for(int i = 0; i < _inputs_in_order.size(); i++) {
@@ -196,7 +427,7 @@ void Worker<Ttype, Ptype, RunType>::async_prediction(std::vector<Tensor4dPtr<typ
 
             return ret;
         }; 
-    _async_que.push(this->RunAsync(task, net_ins_list)); 
+    _async_que.push(this->RunAsyncScheduled(options, task, net_ins_list)); 
 } 
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
@@ -209,7 +440,23 @@ std::vector<Tensor4dPtr<Ttype> > Worker<Ttype, Ptype, RunType>::async_get_result
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
 void Worker<Ttype, Ptype, RunType>::init() {
-    MultiThreadModel<Ttype, Ptype, RunType>::Global().initial(_model_path, _in_shapes);
+    int node = 0;
+    if (std::is_same<Ttype, X86>::value && this->group_num() > 1) {
+        auto& topo = GlobalNumaTopology::Global();
+        node = this->thread_group();
+        topo.bind_current_thread(node);
+#ifdef USE_OPENMP
+        // the node's cores are shared by the worker threads pinned to it
+        int cores = topo.node(node).cpus.size();
+        omp_set_num_threads(std::max(1, cores / this->group_size(node)));
+#endif
+    }
+#ifdef USE_OPENMP
+    t_net_threads = omp_get_max_threads();
+#endif
+    MultiThreadModel<Ttype, Ptype, RunType>::Global().initial(_model_path, node, _in_shapes);
+    MultiThreadModel<Ttype, Ptype, RunType>::Global().get_net(std::this_thread::get_id())
+        .set_session_store(_sessions);
 }
 
 template<typename Ttype, Precision Ptype, OpRunType RunType>
@@ -27,9 +27,13 @@
 #include <future>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
+#include <atomic>
 #include "framework/core/thread_safe_macros.h"
 #include "framework/core/thread_pool.h"
 #include "framework/core/singleton.h"
+#include "framework/core/metrics.h"
+#include "framework/core/cpu_scheduler.h"
 #include "framework/core/net/operator_func.h"
 #include "framework/core/net/net.h"
 
@@ -65,6 +69,28 @@ namespace anakin {
  *          }
  *          \endcode
  *
+ *  \par NUMA:
+ *      On X86 the worker threads are split into one group per NUMA node. Each thread is pinned
+ *      to its node, every node loads its own copy of the model (so weights are first touched
+ *      and kept in node local memory) and requests go to the node with the fewest pending tasks.
+ *
+ *  \par CPU budget:
+ *      Host nets acquire their intra-op threads from GlobalCpuScheduler for each request, so
+ *      many models in one process share the cores instead of each running full width OpenMP.
+ *      set_scheduling() sets the weight and priority of the model against the others.
+ *      A lease is never wider than the OpenMP team the thread's net was created with.
+ *
+ *  \par Snapshot:
+ *      With env ANAKIN_GRAPH_SNAPSHOT_DIR set, the optimized graph is saved to that directory
+ *      keyed by model hash, input shapes and cpu isa, and later workers load it instead of
+ *      running the graph optimization again.
+ *
+ *  \par Scheduling:
+ *      Requests may carry TaskOptions: the higher priority class is served first and the
+ *      earliest deadline first within a class. A request which can't finish by its deadline,
+ *      judged by the running average compute time of the model, is shed instead of run:
+ *      it returns empty outputs (or a failed status) and counts in anakin_dropped.
+ *
  */
 template<typename Ttype, Precision Ptype, OpRunType RunTyp = OpRunType::ASYNC>
 class Worker : public ThreadPool {
@@ -108,10 +134,12 @@ public:
     /** 
      *  \brief do sync prediction in multi-thread worker useful in sync rpc server. 
      *  \param host net_in_list the inputs of net graph (note: the len of net_in_list should be equal to the net inputs).  
-     *  \return the net graph outputs.
+     *  \param options priority class and deadline of the request.
+     *  \return the net graph outputs, empty if the request was shed.
      */
     std::future<std::vector<Tensor4d<typename target_host<Ttype>::type> > > sync_prediction(\
-        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_in_list);
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_in_list,
+        const TaskOptions& options = TaskOptions());
 
     /** 
      *  \brief Do sync prediction in multi-thread worker useful in sync rpc server, this function need 
@@ -121,12 +149,61 @@ public:
     std::future<std::vector<Tensor4dPtr<Ttype> > > sync_prediction_device(\
         std::vector<Tensor4dPtr<Ttype> >& net_in_list);
 
+    /**
+     *  \brief Zero-copy sync prediction. On host targets the net inputs alias the memory of
+     *  net_in_list and the outputs are written straight into net_out_list, whose tensors must be
+     *  allocated by the caller with enough capacity; both lists must outlive the returned future.
+     *  Device targets and outputs which can't be bound fall back to copies.
+     *  \return Status of the prediction, failed if the request was shed.
+     */
+    std::future<Status> sync_prediction_bind(\
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_in_list,
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_out_list,
+        const TaskOptions& options = TaskOptions());
+
+    /**
+     *  \brief Streaming prediction over sessions, e.g. speech or text streams: sequence i of
+     *  net_in_list is the next chunk of session session_ids[i] and every forward Lstm/Gru goes on
+     *  from the state that session's previous chunk left. The sessions are shared by all the
+     *  threads of the worker, the caller must not have two chunks of one session in flight.
+     *  \return the net graph outputs, empty if the net can't carry sessions.
+     */
+    std::future<std::vector<Tensor4d<typename target_host<Ttype>::type> > > session_prediction(\
+        std::vector<uint64_t> session_ids,
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_in_list);
+
+    /// forget the state of a session once its stream is over.
+    bool end_session(uint64_t session_id) { return _sessions->end(session_id); }
+
+    /// sessions idle for longer than idle_timeout_ms are dropped, 10 minutes by default.
+    void set_session_idle_timeout(int64_t idle_timeout_ms) {
+        _sessions->set_idle_timeout(idle_timeout_ms);
+    }
+
+    /// called from the worker thread once a callback_prediction request is done or dropped.
+    typedef std::function<void(Status, std::vector<Tensor4d<typename target_host<Ttype>::type> >&)> \
+        PredictionCallback;
+
+    /**
+     *  \brief non-blocking prediction for async rpc servers: the net runs in a worker thread,
+     *  which then calls done with the outputs. A request which can't meet deadline is shed,
+     *  done gets a failed status and no outputs.
+     *  \param net_in_list the inputs of net graph, they must stay valid until done is called.
+     */
+    void callback_prediction(std::vector<Tensor4d<typename target_host<Ttype>::type> >& net_in_list,
+                             PredictionCallback done,
+                             std::chrono::steady_clock::time_point deadline = \
+                                 std::chrono::steady_clock::time_point::max(),
+                             int priority = 0);
+
     /** 
      *  \brief do async prediction in multi-thread worker, the result will be save to que 
      *  \param net_in_list the inputs of net graph (note: the len of net_in_list should be equal to the net inputs)  
+     *  \param options priority class and deadline of the request, a shed request gets empty results.
      *  \return void
      */
-    void async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type> >& net_in_list);
+    void async_prediction(std::vector<Tensor4dPtr<typename target_host<Ttype>::type> >& net_in_list,
+                          const TaskOptions& options = TaskOptions());
     
     /** 
      *  \brief Judge if the async queue is empty.
@@ -148,6 +225,15 @@ public:
     template<typename functor, typename ...ParamTypes>
     void register_aux_function(functor function, ParamTypes ...args);
 
+public:
+    /**
+     *  \brief scheduling parameters of the model in the process wide cpu budget.
+     *  \param weight share of the cores against models of the same priority.
+     *  \param priority requests of higher priority models get cores first.
+     *  \param max_threads upper bound of the intra-op threads of one request, 0 for none.
+     */
+    void set_scheduling(float weight, int priority = 0, int max_threads = 0);
+
 public:
     /** 
      *  \brief Threads in worker will sleep time(ms) long.
@@ -163,6 +249,29 @@ public:
 #endif
 
 private:
+    /// metrics bookkeeping when a task is queued, returns the queue time.
+    std::chrono::steady_clock::time_point task_queued();
+
+    /// metrics bookkeeping when a queued task starts in a worker thread.
+    void task_started(std::chrono::steady_clock::time_point queued);
+
+    /// metrics bookkeeping when a net run started at start is done.
+    void task_done(std::chrono::steady_clock::time_point start);
+
+    /// true if the pool shed the running task, which is then counted as dropped.
+    bool shed_task();
+
+    /// running average compute time of a request, the pool sheds against it.
+    virtual std::chrono::steady_clock::duration expected_run_time() override;
+
+    /// lease intra-op threads for a request of the calling worker thread and apply them.
+    CpuLease acquire_threads();
+
+    /// fill the net of the calling thread with ins, run it and copy the outputs to host.
+    /// with session_ids the net runs them as session chunks, see session_prediction.
+    std::vector<Tensor4d<typename target_host<Ttype>::type> > host_prediction(\
+        std::vector<Tensor4d<typename target_host<Ttype>::type> >& ins,
+        const std::vector<uint64_t>* session_ids = nullptr);
 
     /** 
      *  \brief Initial the net resource.
@@ -183,6 +292,19 @@ private:
     std::mutex _async_que_mut;    
     std::vector<std::function<void(void)> > _auxiliary_funcs;
     std::unordered_map<std::string, std::vector<int>> _in_shapes;
+    ///< serving metrics of the model, registered in GlobalMetrics
+    Counter* _requests{nullptr};
+    Counter* _dropped{nullptr};
+    Gauge* _queue_depth{nullptr};
+    LatencyHistogram* _queue_wait_us{nullptr};
+    LatencyHistogram* _compute_us{nullptr};
+    LatencyHistogram* _cpu_wait_us{nullptr};
+    ///< moving average of the compute time of a request in us
+    std::atomic<int64_t> _run_time_us{0};
+    ///< id of the model in GlobalCpuScheduler
+    int _cpu_model{0};
+    ///< streaming sessions, shared by the nets of all the threads
+    std::shared_ptr<RnnSessionStore> _sessions;
 #ifdef ENABLE_OP_TIMER
     std::unordered_map<std::thread::id, std::vector<float>> _thead_id_to_prediction_times_vec_in_ms;
     std::mutex _mut;
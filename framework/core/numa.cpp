@@ -0,0 +1,113 @@
+#include "framework/core/numa.h"
+#include "utils/logger/logger.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+#if defined(__linux__) && !defined(USE_SGX)
+#include <pthread.h>
+#include <sched.h>
+#define ANAKIN_NUMA_SYSFS
+#endif
+
+namespace anakin {
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range[0] == '\n') {
+            continue;
+        }
+
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+NumaTopology::NumaTopology() {
+#ifdef ANAKIN_NUMA_SYSFS
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool has_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string node_list;
+
+    if (online && std::getline(online, node_list)) {
+        for (int id : parse_cpu_list(node_list)) {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+            std::string cpu_list;
+
+            if (!cpulist || !std::getline(cpulist, cpu_list)) {
+                continue;
+            }
+
+            NumaNode node;
+            node.id = id;
+
+            for (int cpu : parse_cpu_list(cpu_list)) {
+                if (!has_mask || CPU_ISSET(cpu, &allowed)) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+
+            // memory-only nodes and nodes outside our cpuset are of no use to workers
+            if (!node.cpus.empty()) {
+                _nodes.push_back(node);
+            }
+        }
+    }
+
+#endif
+
+    if (_nodes.empty()) {
+        NumaNode node;
+        int cpu_num = std::max(1u, std::thread::hardware_concurrency());
+
+        for (int cpu = 0; cpu < cpu_num; cpu++) {
+            node.cpus.push_back(cpu);
+        }
+
+        _nodes.push_back(node);
+    }
+
+    LOG(INFO) << "numa topology: " << _nodes.size() << " node(s)";
+}
+
+bool NumaTopology::bind_current_thread(int idx) const {
+#ifdef ANAKIN_NUMA_SYSFS
+
+    if (_nodes.size() <= 1) {
+        // nothing to gain from pinning on a single node
+        return false;
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+
+    for (int cpu : _nodes[idx].cpus) {
+        CPU_SET(cpu, &mask);
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) != 0) {
+        LOG(WARNING) << "failed to bind thread to numa node " << _nodes[idx].id;
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+} /* namespace anakin */
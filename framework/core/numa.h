@@ -0,0 +1,65 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_NUMA_H
+#define ANAKIN_NUMA_H
+
+#include "anakin_config.h"
+#include <vector>
+#include <string>
+#include "framework/core/singleton.h"
+
+namespace anakin {
+
+/**
+ *  \brief one NUMA node and the cpus of it that this process may run on.
+ */
+struct NumaNode {
+    int id{0};
+    std::vector<int> cpus;
+};
+
+/**
+ *  \brief NUMA topology of the host, read from /sys/devices/system/node.
+ *  When sysfs is not available (non-linux, containers without /sys) the topology
+ *  degenerates to one node holding every cpu, so callers never need a special case.
+ */
+class NumaTopology {
+public:
+    NumaTopology();
+
+    /// number of nodes which own at least one usable cpu.
+    int node_num() const { return _nodes.size(); }
+
+    const NumaNode& node(int idx) const { return _nodes[idx]; }
+
+    /**
+     *  \brief pin the calling thread to the cpus of node idx.
+     *  \return true if the affinity was applied.
+     */
+    bool bind_current_thread(int idx) const;
+
+private:
+    std::vector<NumaNode> _nodes;
+};
+
+/// parse a sysfs cpu list such as "0-3,8,10-11".
+std::vector<int> parse_cpu_list(const std::string& list);
+
+typedef Singleton<NumaTopology> GlobalNumaTopology;
+
+} /* namespace anakin */
+
+#endif
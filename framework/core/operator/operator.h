@@ -100,6 +100,21 @@ public:
         return Status::ANAKINFAIL();
     }
 
+    /**
+     *  \brief Width of one sequence's row of every recurrent state the op can carry between
+     *         launches (hidden, cell ...), empty for stateless ops.
+     */
+    virtual std::vector<int> StateSizes() { return {}; }
+
+    /**
+     *  \brief Bind the state tensors, one per StateSizes entry with one row per sequence of the
+     *         batch: the next launches start from them and leave the final state in them.
+     *         An empty vector unbinds them.
+     */
+    virtual Status BindState(const std::vector<Tensor4dPtr<Ttype> >& states) {
+        return Status::ANAKINFAIL("Op doesn't carry state");
+    }
+
     /** 
      *  \brief Bind parameter pack from graph.
      */
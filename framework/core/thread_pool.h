@@ -17,6 +17,9 @@
 #define ANAKIN_THREAD_POOL_H 
 
 #include "anakin_config.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <thread>
 #include <queue>
@@ -24,15 +27,44 @@
 #include <future>
 #include <mutex> 
 #include <condition_variable>
+#include <memory>
 #include "framework/core/thread_safe_macros.h"
 #include "framework/core/type_traits_extend.h"
 #include "utils/logger/logger.h"
 
 namespace anakin {
 
+/**
+ *  \brief Scheduling class and deadline of a task, see ThreadPool::RunAsyncScheduled.
+ */
+struct TaskOptions {
+    TaskOptions() {}
+    explicit TaskOptions(int priority_in,
+                         std::chrono::steady_clock::time_point deadline_in = \
+                             std::chrono::steady_clock::time_point::max())
+        : priority(priority_in), deadline(deadline_in) {}
+
+    ///< tasks of a higher priority class are served first, a busy class starves lower ones
+    int priority{0};
+    ///< within a class the earliest deadline is served first, tasks without one come last
+    std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+};
+
+/**
+ *  \brief Pool of threads serving tasks from queues.
+ *  Threads may be split into num_group groups (e.g. one per NUMA node), each group owning
+ *  its own queue; a new task goes to the group with the fewest queued and running tasks.
+ *  A queue serves the highest priority class first, earliest deadline first within a class
+ *  and in submission order otherwise. A task which can't finish by its deadline (now plus
+ *  expected_run_time() is past it) is shed: it still runs, so its future is set, but with
+ *  shedding() true so it can return at once.
+ *  Priority classes are strict and don't age: while higher class tasks keep the queue busy,
+ *  a lower class task waits for ever (its deadline only sheds it once it runs), so low
+ *  classes suit background work only.
+ */
 class ThreadPool {
 public:
-    ThreadPool(int num_thread):_num_thread(num_thread) {}
+    ThreadPool(int num_thread, int num_group = 1);
     virtual ~ThreadPool();
 
     void launch();
@@ -48,11 +80,71 @@ public:
      */
     template<typename functor, typename ...ParamTypes>
     typename std::future<typename function_traits<functor>::return_type> RunAsync(functor function, ParamTypes ...args);
+
+    /**
+     *  \brief Lanuch the normal function task in async, in the priority class and with the
+     *  deadline of options.
+     */
+    template<typename functor, typename ...ParamTypes>
+    typename std::future<typename function_traits<functor>::return_type> RunAsyncScheduled(\
+        const TaskOptions& options, functor function, ParamTypes ...args);
     
     /// Stop the pool.
     void stop();
 
+    /// Inside a task: true if the pool shed it, the task should give up its work.
+    static bool shedding() { return task_shed(); }
+
+protected:
+    /// Group index of the calling pool thread, valid inside init() and tasks.
+    static int& thread_group();
+
+    /// Time a task is expected to take once it starts, a task is shed when now plus this
+    /// is past its deadline. Zero by default: only tasks already past their deadline are shed.
+    virtual std::chrono::steady_clock::duration expected_run_time() {
+        return std::chrono::steady_clock::duration::zero();
+    }
+
+    int group_num() const { return _groups.size(); }
+
+    /// Number of pool threads which serve group.
+    int group_size(int group) const;
+
 private:
+    struct Task {
+        TaskOptions options;
+        ///< submission order, ties in class and deadline are served first come first served
+        uint64_t seq;
+        std::function<void(void)> run;
+    };
+
+    /// heap order of the queues: true if a is served after b
+    struct TaskAfter {
+        bool operator()(const Task& a, const Task& b) const {
+            if (a.options.priority != b.options.priority) {
+                return a.options.priority < b.options.priority;
+            }
+            if (a.options.deadline != b.options.deadline) {
+                return a.options.deadline > b.options.deadline;
+            }
+            return a.seq > b.seq;
+        }
+    };
+
+    struct TaskGroup {
+        ///< heap by TaskAfter
+        std::vector<Task> tasks;
+        std::condition_variable cv;
+        ///< queued plus running tasks
+        int load{0};
+    };
+
+    /// Queue task to the least loaded group.
+    void enqueue(std::function<void(void)> task, const TaskOptions& options = TaskOptions()) \
+        EXCLUSIVE_LOCKS_REQUIRED(_mut);
+
+    static bool& task_shed();
+
     /// The initial function should be overrided by user who derive the ThreadPool class.
     virtual void init();
 
@@ -62,10 +154,10 @@ private:
 private:
     int _num_thread;
     std::vector<std::thread> _workers;
-    std::queue<std::function<void(void)> > _tasks GUARDED_BY(_mut);
+    std::vector<std::unique_ptr<TaskGroup> > _groups GUARDED_BY(_mut);
     std::mutex _mut;
-    std::condition_variable _cv;
     bool _stop{false};
+    uint64_t _seq GUARDED_BY(_mut) {0};
 };
 
 } /* namespace anakin */
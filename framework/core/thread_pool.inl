@@ -1,28 +1,67 @@
 
 namespace anakin {
 
+inline ThreadPool::ThreadPool(int num_thread, int num_group):_num_thread(num_thread) {
+    num_group = std::max(1, std::min(num_group, num_thread));
+    for(int i = 0; i < num_group; ++i) {
+        _groups.emplace_back(new TaskGroup());
+    }
+}
+
+inline int& ThreadPool::thread_group() {
+    static thread_local int group = 0;
+    return group;
+}
+
+inline bool& ThreadPool::task_shed() {
+    static thread_local bool shed = false;
+    return shed;
+}
+
+inline int ThreadPool::group_size(int group) const {
+    // threads are split into contiguous ranges, thread i serves group i * num_group / num_thread
+    int num_group = _groups.size();
+    int first = (group * _num_thread + num_group - 1) / num_group;
+    int last = ((group + 1) * _num_thread + num_group - 1) / num_group;
+    return last - first;
+}
+
 inline void ThreadPool::launch() {
     for(size_t i = 0; i<_num_thread; ++i) {
+        int group = i * _groups.size() / _num_thread;
         _workers.emplace_back(
-            [i ,this]() {
-                // initial 
+            [i, group, this]() {
+                thread_group() = group;
+                TaskGroup& tg = *this->_groups[group];
+                // initial
                 this->init();
                 for(;;) {
-                    std::function<void(void)> task;
+                    Task task;
                     {
                         std::unique_lock<std::mutex> lock(this->_mut);
-                        while(!this->_stop && this->_tasks.empty()) { 
-                            this->_cv.wait(lock); 
+                        while(!this->_stop && tg.tasks.empty()) {
+                            tg.cv.wait(lock);
                         }
                         if(this->_stop) {
                             return ;
                         }
-                        task = std::move(this->_tasks.front()); 
-                        this->_tasks.pop();
+                        std::pop_heap(tg.tasks.begin(), tg.tasks.end(), TaskAfter());
+                        task = std::move(tg.tasks.back());
+                        tg.tasks.pop_back();
                     }
+                    auto deadline = task.options.deadline;
+                    task_shed() = deadline != std::chrono::steady_clock::time_point::max()
+                                  && std::chrono::steady_clock::now() + expected_run_time() > deadline;
                     DLOG(INFO) << " Thread (" << i <<") processing";
-                    auxiliary_funcs();
-                    task();
+                    if (!task_shed()) {
+                        auxiliary_funcs();
+                    }
+                    task.run();
+                    task_shed() = false;
+                    {
+                        std::unique_lock<std::mutex> lock(this->_mut);
+                        tg.load--;
+                    }
                 }
             }
         );
@@ -40,39 +79,56 @@ inline void ThreadPool::auxiliary_funcs() {}
 
 inline ThreadPool::~ThreadPool() {
     stop();
-    this->_cv.notify_all();
-    for(auto & worker: _workers){ 
-        worker.join(); 
+    for(auto& group : _groups) {
+        group->cv.notify_all();
+    }
+    for(auto & worker: _workers){
+        worker.join();
     }
 }
 
+inline void ThreadPool::enqueue(std::function<void(void)> task, const TaskOptions& options) {
+    TaskGroup* target = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(this->_mut);
+        target = _groups[0].get();
+        for(auto& group : _groups) {
+            if(group->load < target->load) {
+                target = group.get();
+            }
+        }
+        target->tasks.push_back(Task{options, _seq++, std::move(task)});
+        std::push_heap(target->tasks.begin(), target->tasks.end(), TaskAfter());
+        target->load++;
+    }
+    target->cv.notify_one();
+}
+
 template<typename functor, typename ...ParamTypes>
-inline typename function_traits<functor>::return_type ThreadPool::RunSync(functor function, ParamTypes ...args) 
-                    EXCLUSIVE_LOCKS_REQUIRED(_mut) { 
+inline typename function_traits<functor>::return_type ThreadPool::RunSync(functor function, ParamTypes ...args)
+                    EXCLUSIVE_LOCKS_REQUIRED(_mut) {
     auto task = std::make_shared<std::packaged_task<typename function_traits<functor>::return_type(void)> >( \
             std::bind(function, std::forward<ParamTypes>(args)...)
     );
-    std::future<typename function_traits<functor>::return_type> result = task->get_future(); 
-    { 
-        std::unique_lock<std::mutex> lock(this->_mut);
-        this->_tasks.emplace( [&]() { (*task)(); } );
-    }
-    this->_cv.notify_one();
+    std::future<typename function_traits<functor>::return_type> result = task->get_future();
+    enqueue([&]() { (*task)(); });
     return result.get();
 }
 
 template<typename functor, typename ...ParamTypes>
-inline std::future<typename function_traits<functor>::return_type> ThreadPool::RunAsync(functor function, ParamTypes ...args) 
-                    EXCLUSIVE_LOCKS_REQUIRED(_mut) { 
+inline std::future<typename function_traits<functor>::return_type> ThreadPool::RunAsync(functor function, ParamTypes ...args)
+                    EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+    return RunAsyncScheduled(TaskOptions(), function, std::forward<ParamTypes>(args)...);
+}
+
+template<typename functor, typename ...ParamTypes>
+inline std::future<typename function_traits<functor>::return_type> ThreadPool::RunAsyncScheduled(
+        const TaskOptions& options, functor function, ParamTypes ...args) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
     auto task = std::make_shared<std::packaged_task<typename function_traits<functor>::return_type(void)> >( \
             std::bind(function, std::forward<ParamTypes>(args)...)
     );
-    std::future<typename function_traits<functor>::return_type> result = task->get_future(); 
-    { 
-        std::unique_lock<std::mutex> lock(this->_mut);
-        this->_tasks.emplace( [=]() { (*task)(); } );
-    }
-    this->_cv.notify_one();
+    std::future<typename function_traits<functor>::return_type> result = task->get_future();
+    enqueue([=]() { (*task)(); }, options);
     return result;
 }
 
@@ -17,6 +17,7 @@
 #define ANAKIN_ALGO_H 
 
 #include <queue>
+#include <unordered_set>
 #include "utils/logger/logger.h"
 #include "framework/core/base.h"
 #include "framework/core/type_traits_extend.h"
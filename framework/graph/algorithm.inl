@@ -23,14 +23,14 @@ template<typename VertexNameType,
 template<typename functor, typename ...ParamTypes>
 Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexNameType, VertexType, WeightType, ArcType>::_BFS_Edge(Bool2Type<true>, functor& func, ParamTypes&& ...args) {
     std::queue<VertexNameType> que;
-    std::vector<VertexNameType> backup;
+    std::unordered_set<VertexNameType> backup;
     auto ins = this->_graph->get_graph_ins();
     CHECK_GT(ins.size(), 0) << " The graph don't have any inputs";
     for(int i = 0; i < ins.size(); i++) {
         VertexNameType vertex_name = ins[i];
-        if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) {
+        if(backup.count(vertex_name) == 0) {
             que.push(vertex_name);
-            backup.push_back(vertex_name);
+            backup.insert(vertex_name);
         }
         /*auto arc_outs = this->_graph->get_out_arcs(vertex_name);
         for(auto& arc : arc_outs) {
@@ -53,9 +53,9 @@ Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexName
             }
 
             VertexNameType vertex_name = arc_it->top();
-            if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) { // not find
+            if(backup.count(vertex_name) == 0) { // not find
                 que.push(vertex_name);
-                backup.push_back(vertex_name);
+                backup.insert(vertex_name);
             }
         }
             
@@ -81,14 +81,14 @@ template<typename VertexNameType,
 template<typename functor, typename ...ParamTypes>
 Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexNameType, VertexType, WeightType, ArcType>::_BFS(Bool2Type<true>, functor& func, ParamTypes&& ...args) {
     std::queue<VertexNameType> que;
-    std::vector<VertexNameType> backup;
+    std::unordered_set<VertexNameType> backup;
     auto ins = this->_graph->get_graph_ins();
     CHECK_GT(ins.size(), 0) << " The graph don't have any inputs";
     for(int i = 0; i < ins.size(); i++) {
         VertexNameType vertex_name = ins[i];
-        if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) {
+        if(backup.count(vertex_name) == 0) {
             que.push(vertex_name);
-            backup.push_back(vertex_name);
+            backup.insert(vertex_name);
         }
         // Code below is useful when anakin doesn't define input op
         /*auto arc_outs = this->_graph->get_out_arcs(vertex_name);
@@ -112,9 +112,9 @@ Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexName
         auto arc_out_its = this->_graph->get_out_arc_its(vertex_name);
         for(auto& arc_it : arc_out_its) {
             VertexNameType vertex_name = arc_it->top();
-            if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) { // not find
+            if(backup.count(vertex_name) == 0) { // not find
                 que.push(vertex_name);
-                backup.push_back(vertex_name);
+                backup.insert(vertex_name);
             }
         }
             
@@ -144,14 +144,14 @@ template<typename VertexNameType,
 template<typename functor, typename ...ParamTypes>
 Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexNameType, VertexType, WeightType, ArcType>::_BFS_Edge(Bool2Type<false>, functor& func, ParamTypes&& ...args) {
     std::queue<VertexNameType> que;
-    std::vector<VertexNameType> backup;
+    std::unordered_set<VertexNameType> backup;
     auto ins = this->_graph->get_graph_ins();
     CHECK_GT(ins.size(), 0) << " The graph don't have any inputs";
     for(int i = 0; i < ins.size(); i++) {
         VertexNameType vertex_name = ins[i];
-        if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) {
+        if(backup.count(vertex_name) == 0) {
             que.push(vertex_name);
-            backup.push_back(vertex_name);
+            backup.insert(vertex_name);
         }
         /*auto arc_outs = this->_graph->get_out_arcs(vertex_name);
         for(auto& arc : arc_outs) {
@@ -171,9 +171,9 @@ Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexName
             func(*arc_it, std::forward<ParamTypes>(args)...);
 
             VertexNameType vertex_name = arc_it->top();
-            if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) { // not find
+            if(backup.count(vertex_name) == 0) { // not find
                 que.push(vertex_name);
-                backup.push_back(vertex_name);
+                backup.insert(vertex_name);
             }
         }
             
@@ -188,16 +188,16 @@ template<typename VertexNameType,
          typename ArcType,
          typename functor,
         typename ...ParamTypes>
-void dfs(VertexNameType vertex_name, std::vector<VertexNameType>& backup, functor& func, 
+void dfs(VertexNameType vertex_name, std::unordered_set<VertexNameType>& backup, functor& func, 
     GraphBase<VertexNameType, VertexType, WeightType, ArcType>* graph, ParamTypes&& ...args){
         VertexType& vertex =  (*(graph))[vertex_name];
         func(vertex, std::forward<ParamTypes>(args)...);
-        backup.push_back(vertex_name);
+        backup.insert(vertex_name);
 
         auto arc_out_its = graph->get_out_arc_its(vertex_name);
         for(auto& arc_it : arc_out_its) {
             VertexNameType vertex_name = arc_it->top();
-            if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) { // not find
+            if(backup.count(vertex_name) == 0) { // not find
                 dfs(vertex_name, backup, func, graph, std::forward<ParamTypes>(args)...);
             }
         }
@@ -210,7 +210,7 @@ template<typename VertexNameType,
 template<typename functor, typename ...ParamTypes>
 Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexNameType, VertexType, WeightType, ArcType>::_DFS(Bool2Type<false>, functor& func, ParamTypes&& ...args) {
     //LOG(WARNING) << "Not impl yet , which isn't so important in inference analysis";
-    std::vector<VertexNameType> backup;
+    std::unordered_set<VertexNameType> backup;
 
     auto ins = this->_graph->get_graph_ins();
     CHECK_GT(ins.size(), 0) << " The graph don't have any inputs";
@@ -229,14 +229,14 @@ template<typename VertexNameType,
 template<typename functor, typename ...ParamTypes>
 Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexNameType, VertexType, WeightType, ArcType>::_BFS(Bool2Type<false>, functor& func, ParamTypes&& ...args) {
     std::queue<VertexNameType> que;
-    std::vector<VertexNameType> backup;
+    std::unordered_set<VertexNameType> backup;
     auto ins = this->_graph->get_graph_ins();
     CHECK_GT(ins.size(), 0) << " The graph don't have any inputs";
     for(int i = 0; i < ins.size(); i++) {
         VertexNameType vertex_name = ins[i];
-        if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) {
+        if(backup.count(vertex_name) == 0) {
             que.push(vertex_name);
-            backup.push_back(vertex_name);
+            backup.insert(vertex_name);
         }
         // Code below is useful when anakin doesn't define input op
         /*auto arc_outs = this->_graph->get_out_arcs(vertex_name);
@@ -256,9 +256,9 @@ Algorithm<VertexNameType, VertexType, WeightType, ArcType>& Algorithm<VertexName
         auto arc_out_its = this->_graph->get_out_arc_its(vertex_name);
         for(auto& arc_it : arc_out_its) {
             VertexNameType vertex_name = arc_it->top();
-            if(std::find(backup.begin(), backup.end(), vertex_name) == backup.end()) { // not find
+            if(backup.count(vertex_name) == 0) { // not find
                 que.push(vertex_name);
-                backup.push_back(vertex_name);
+                backup.insert(vertex_name);
             }
         }
             
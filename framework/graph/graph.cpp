@@ -1,4 +1,6 @@
 #include "framework/graph/graph.h"
+#include "framework/graph/graph_snapshot.h"
+#include "framework/core/type_traits_extend.h"
 #include "framework/model_parser/parser/parser.h"
 #include "framework/graph/llvm/scheduler.h"
 #include "framework/graph/llvm/optimizer/conv_elewise_fusion_scheduler.h"
@@ -7,6 +9,9 @@
 #include "framework/graph/llvm/fusion/graph_pattern.h"
 #include "framework/core/operator/operator.h"
 #include "framework/graph/llvm/optimizer/optimize_strategy.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 
 namespace anakin {
 
@@ -49,6 +54,73 @@ Status Graph<Ttype, Ptype>::save(const char* model_path) {
     return parser::save<Ttype>(this, model_path);
 }
 
+template<typename Ttype, Precision Ptype>
+Status Graph<Ttype, Ptype>::save_snapshot(std::string path, std::string key) {
+    if (!statistics.get_info<IS_OPTIMIZED>()) {
+        return Status::ANAKINFAIL("Snapshot of a graph not optimized");
+    }
+    // the payload is a regular optimized model, let the parser write it
+    std::string proto_path = path + ".proto";
+    Status ret = save(proto_path);
+    if (!ret) {
+        return ret;
+    }
+    std::string payload;
+    {
+        std::ifstream proto(proto_path, std::ios::in | std::ios::binary);
+        std::ostringstream buffer;
+        buffer << proto.rdbuf();
+        payload = buffer.str();
+    }
+    std::remove(proto_path.c_str());
+
+    GraphSnapshotHeader header;
+    header.key = key;
+    header.exec_order = _nodes_exec_order;
+    ret = write_graph_snapshot(path, header, payload);
+    if (ret) {
+        LOG(INFO) << "graph snapshot " << key << " saved to " << path;
+    }
+    return ret;
+}
+
+template<typename Ttype, Precision Ptype>
+Status Graph<Ttype, Ptype>::load_snapshot(std::string path, std::string key) {
+    GraphSnapshotHeader header;
+    std::string payload;
+    Status ret = read_graph_snapshot(path, header, payload);
+    if (!ret) {
+        return ret;
+    }
+    if (header.key != key) {
+        LOG(WARNING) << path << " : snapshot of " << header.key << ", expect " << key;
+        return Status::ANAKINFAIL("Snapshot key mismatch");
+    }
+    ret = load(payload.data(), payload.size());
+    if (!ret) {
+        return ret;
+    }
+    for (auto& name : header.exec_order) {
+        if (!this->has_vertex(name)) {
+            LOG(ERROR) << path << " : node " << name << " of exec order not in the graph";
+            return Status::ANAKINFAIL("Snapshot exec order corrupted");
+        }
+    }
+    std::unique_lock<std::mutex> lock(this->_mut);
+    // fusion, exec order and memory plan come from the snapshot, Optimize has nothing to do
+    _nodes_exec_order = header.exec_order;
+    statistics.set_info<IS_OPTIMIZED>(true);
+    _has_graph_optimized = true;
+    LOG(INFO) << "graph snapshot " << key << " loaded from " << path;
+    return Status::OK();
+}
+
+template<typename Ttype, Precision Ptype>
+Status Graph<Ttype, Ptype>::snapshot_key(std::string model_path,
+        const std::unordered_map<std::string, std::vector<int> >& shape_map, std::string& key) {
+    return graph_snapshot_key(model_path, target_name<Ttype>::value, Ptype, shape_map, key);
+}
+
 template<typename Ttype, Precision Ptype>
 std::vector<std::string>& Graph<Ttype, Ptype>::get_nodes_in_order() {
     return _nodes_exec_order;
@@ -388,6 +460,11 @@ Status Graph<Ttype, Ptype>::Optimize(bool with_fusion) EXCLUSIVE_LOCKS_REQUIRED(
                         (fusion_name == "ConvReluPool" || fusion_name == "ConvBatchnormScaleReluPool")) {
                         continue;
                     }
+                    // SequenceConvRelu only has x86 fp32 kernel
+                    if (!(std::is_same<Ttype, X86>::value && Precision::FP32 == Ptype) &&
+                        fusion_name == "SequenceConvRelu") {
+                        continue;
+                    }
                     DLOG(INFO) << " processing in-ordered fusion : " << fusion_name;
                     _vgraph->Match(FusionOpRegister::Global()[fusion_name]);
 
@@ -448,6 +525,12 @@ Status Graph<Ttype, Ptype>::Optimize(bool with_fusion) EXCLUSIVE_LOCKS_REQUIRED(
             statistics.set_info<IS_OPTIMIZED>(true);
             DLOG(INFO) << " model size : " << graph::GraphGlobalMem<Ttype>::Global().get_sum_mbyte() << " mb ";
             statistics.set_info<MODEL_MEM>(graph::GraphGlobalMem<Ttype>::Global().get_sum_mbyte());
+            auto dedup = graph::GraphGlobalMem<Ttype>::Global().get_dedup_stats();
+            if (dedup.shared_blocks > 0) {
+                LOG(INFO) << " weight dedup : " << dedup.shared_blocks << " of "
+                          << dedup.unique_blocks + dedup.shared_blocks << " blocks shared, "
+                          << dedup.saved_bytes / 1e6 << " mb saved";
+            }
 
             DLOG(WARNING) << "Restore graph from virtual graph of ... ";
             restore_from_vgraph(_vgraph);
@@ -678,7 +761,10 @@ Status Graph<Ttype, Ptype>::restore_from_vgraph(VGraph* vgraph) {
         return Status::OK();
     };
     auto interpreter_node = [&, this](node & target_node) -> Status {
-        this->Scanner->BFS(map_node_to_node_ptr, target_node);
+        // vgraph nodes keep the names of the graph nodes, look it up rather than scan the graph
+        if (this->has_vertex(target_node.name)) {
+            map_node_to_node_ptr((*this)[target_node.name], target_node);
+        }
         return Status::OK();
     };
     vgraph->Scanner->BFS(interpreter_node);
@@ -78,6 +78,24 @@ public:
     Status save(const char*  model_path);
 
     Status load(const char* buffer, size_t len);
+
+    /**
+     * \brief save the optimized graph: fused nodes, exec order, memory sharing, layouts,
+     *  precisions and scales. Call it right after Optimize and before Net::init,
+     *  ops fold their weights in place when initialized.
+     */
+    Status save_snapshot(std::string path, std::string key);
+    /**
+     * \brief load a snapshot saved with the same key instead of load + Reshape + Optimize,
+     *  fails when the file is missing, stale or for another key, load the model as usual then.
+     */
+    Status load_snapshot(std::string path, std::string key);
+    /// snapshot key of model_path reshaped by shape_map for this target, precision and cpu,
+    /// fails if the model can't be read.
+    static Status snapshot_key(std::string model_path,
+                               const std::unordered_map<std::string, std::vector<int> >& shape_map,
+                               std::string& key);
+
     void load_calibrator_config(std::string, std::string);
     void load_layout_config(std::string);
 
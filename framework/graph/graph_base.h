@@ -16,6 +16,9 @@
 #ifndef ANAKIN_GRAPH_BASE_H
 #define ANAKIN_GRAPH_BASE_H 
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
 #include "framework/graph/arc.h"
 #include "framework/graph/algorithm.h"
 
@@ -41,6 +44,14 @@ class GraphBase {
     typedef std::list<ArcType> ArcsList;
     ///< ArcsIteratorList stand for the list of Iterator arc 
     typedef std::vector<Arc_iterator<VertexNameType, WeightType, ArcType>> ArcsIteratorList;
+    ///< ArcKey stand for the (bottom, top) of an arc
+    typedef std::pair<VertexNameType, VertexNameType> ArcKey;
+    struct ArcKeyHash {
+        size_t operator()(const ArcKey& key) const {
+            size_t h = std::hash<VertexNameType>()(key.first);
+            return h ^ (std::hash<VertexNameType>()(key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
 public:
     GraphBase();
     GraphBase(size_t size);
@@ -146,6 +157,16 @@ public:
 
     /// algorithm for graph base.
     Algorithm<VertexNameType, VertexType, WeightType, ArcType> *Scanner{nullptr};
+private:
+    /// put arc_it in the arc index.
+    void index_arc(typename ArcsList::iterator arc_it);
+    /// drop arc_it from the arc index, the arc itself stays in _arcs.
+    void unindex_arc(typename ArcsList::iterator arc_it);
+    /// note that the in/out arc list of holder refers to the arc.
+    void add_holder(ArcType& arc, const VertexNameType& holder);
+    /// erase arc_it from _arcs and from the indexes.
+    void erase_arc(typename ArcsList::iterator arc_it);
+
 private:
     ///<  _vertices stand for set of vertices 
     std::unordered_map<VertexNameType, VertexType> _vertices;
@@ -156,6 +177,14 @@ private:
     std::unordered_map<VertexNameType, ArcsIteratorList> _graph_out_arcs;
     ///< _graph_in_arcs : map from vertex's name to it's in arc list
     std::unordered_map<VertexNameType, ArcsIteratorList> _graph_in_arcs;
+    ///< _arc_index : (bottom, top) to the arcs in _arcs, in the order they got the key.
+    ///< update_in/out_arc may give two arcs the same key, find() returns the first one.
+    std::unordered_map<ArcKey, std::vector<typename ArcsList::iterator>, ArcKeyHash> _arc_index;
+    ///< _arc_lists : arc to the vertices whose in/out arc lists hold it
+    std::unordered_map<const ArcType*, std::vector<VertexNameType> > _arc_lists;
+    ///< _arc_holders : vertex name to the vertices whose in/out arc lists may hold an arc of it,
+    ///< so removing a vertex only visits those lists instead of every vertex
+    std::unordered_map<VertexNameType, std::unordered_set<VertexNameType> > _arc_holders;
 };
 
 } /* namespace graph */
@@ -28,6 +28,41 @@ void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::arcs_clear() {
     _arcs.clear();
     _graph_out_arcs.clear();
     _graph_in_arcs.clear();
+    _arc_index.clear();
+    _arc_lists.clear();
+    _arc_holders.clear();
+}
+
+template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
+void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::index_arc(typename ArcsList::iterator arc_it) {
+    _arc_index[ArcKey(arc_it->bottom(), arc_it->top())].push_back(arc_it);
+}
+
+template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
+void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::unindex_arc(typename ArcsList::iterator arc_it) {
+    auto key_it = _arc_index.find(ArcKey(arc_it->bottom(), arc_it->top()));
+    if(key_it == _arc_index.end()) {
+        return;
+    }
+    auto& arcs = key_it->second;
+    arcs.erase(std::remove(arcs.begin(), arcs.end(), arc_it), arcs.end());
+    if(arcs.empty()) {
+        _arc_index.erase(key_it);
+    }
+}
+
+template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
+void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::add_holder(ArcType& arc, const VertexNameType& holder) {
+    _arc_lists[&arc].push_back(holder);
+    _arc_holders[arc.bottom()].insert(holder);
+    _arc_holders[arc.top()].insert(holder);
+}
+
+template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
+void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::erase_arc(typename ArcsList::iterator arc_it) {
+    unindex_arc(arc_it);
+    _arc_lists.erase(&(*arc_it));
+    _arcs.erase(arc_it);
 }
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
@@ -89,6 +124,12 @@ void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::add_alias(Verte
 	_vertices[vertexNameAlias] = _vertices[vertexNameOri];
 	_graph_out_arcs[vertexNameAlias] = _graph_out_arcs[vertexNameOri];
 	_graph_in_arcs[vertexNameAlias] = _graph_in_arcs[vertexNameOri];
+	for(auto& arc_it : _graph_out_arcs[vertexNameAlias]) {
+		add_holder(*arc_it, vertexNameAlias);
+	}
+	for(auto& arc_it : _graph_in_arcs[vertexNameAlias]) {
+		add_holder(*arc_it, vertexNameAlias);
+	}
 }
 
 
@@ -96,13 +137,15 @@ template<typename VertexNameType, typename VertexType, typename WeightType, type
 void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::add_in_arc(ArcType& arc) {
     if(!this->has_arc(arc)){
         _arcs.push_back(arc);
+        index_arc(std::prev(_arcs.end()));
         CHECK(this->has_vertex(arc.bottom()) && this->has_vertex(arc.top())) 
                 << " The arc("<< arc.bottom() <<", "<< arc.top() << ")'s top or bottom is not vertex! ";
     }     
     Arc_iterator<VertexNameType, WeightType, ArcType> arc_iterator = find(arc.bottom(), arc.top()); 
-    auto top_in_arcs = _graph_in_arcs[arc.top()];
+    auto& top_in_arcs = _graph_in_arcs[arc.top()];
     if (std::find(top_in_arcs.begin(), top_in_arcs.end(), arc_iterator) == top_in_arcs.end()){
-        _graph_in_arcs[arc.top()].push_back(arc_iterator);
+        top_in_arcs.push_back(arc_iterator);
+        add_holder(*arc_iterator, arc.top());
     }
     //_graph_in_arcs[arc.top()].push_back(arc_iterator);
 }
@@ -118,7 +161,14 @@ void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::update_in_arc(A
             << " The in arc's index should be between 0 and in arc's sizes";
     for(int i=0; i < in_arc_it_list.size(); i++) {
         if(i == index_of_in_arc) {
-            in_arc_it_list[i]->bottom() = arc.bottom();
+            auto arc_it = in_arc_it_list[i].origin();
+            unindex_arc(arc_it);
+            arc_it->bottom() = arc.bottom();
+            index_arc(arc_it);
+            // every list holding the arc now holds an arc of the new bottom
+            for(auto& holder : _arc_lists[&(*arc_it)]) {
+                _arc_holders[arc.bottom()].insert(holder);
+            }
             break;
         }
     }
@@ -128,12 +178,14 @@ template<typename VertexNameType, typename VertexType, typename WeightType, type
 void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::add_out_arc(ArcType& arc) {
     if(!this->has_arc(arc)){
         _arcs.push_back(arc);
+        index_arc(std::prev(_arcs.end()));
         CHECK(this->has_vertex(arc.bottom()) && this->has_vertex(arc.top())) << " The arc's top or bottom is not vertex! ";
     }     
     Arc_iterator<VertexNameType, WeightType, ArcType> arc_iterator = find(arc.bottom(), arc.top());
-    auto bottom_out_arcs = _graph_out_arcs[arc.bottom()];
+    auto& bottom_out_arcs = _graph_out_arcs[arc.bottom()];
     if (std::find(bottom_out_arcs.begin(), bottom_out_arcs.end(), arc_iterator) == bottom_out_arcs.end()){
-        _graph_out_arcs[arc.bottom()].push_back(arc_iterator);
+        bottom_out_arcs.push_back(arc_iterator);
+        add_holder(*arc_iterator, arc.bottom());
     }
     //_graph_out_arcs[arc.bottom()].push_back(arc_iterator);
 }
@@ -149,7 +201,14 @@ void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::update_out_arc(
             << " The in arc's index should be between 0 and in arc's sizes";
     for(int i=0; i < out_arc_it_list.size(); i++) {
         if(i == index_of_out_arc) {
-            out_arc_it_list[i]->top() = arc.top();
+            auto arc_it = out_arc_it_list[i].origin();
+            unindex_arc(arc_it);
+            arc_it->top() = arc.top();
+            index_arc(arc_it);
+            // every list holding the arc now holds an arc of the new top
+            for(auto& holder : _arc_lists[&(*arc_it)]) {
+                _arc_holders[arc.top()].insert(holder);
+            }
             break;
         }
     }
@@ -163,23 +222,30 @@ void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::remove(VertexNa
     } else {
         iterator it = find(vertexName);
         _vertices.erase(it.origin());
-        // remove corresponding arc which has vertexName
-        for(iterator it = begin(); it!=end(); it++) { 
-            //vertices_ss << " |-- [v_" << index << ": " << it->first << "] \n"; 
-            for(auto arc_it = _graph_in_arcs[it->first].begin(); arc_it != _graph_in_arcs[it->first].end();) {
-                if((*arc_it)->bottom() == vertexName || (*arc_it)->top() == vertexName) {
-                    arc_it = _graph_in_arcs[it->first].erase(arc_it);
-                } else {
-                    ++arc_it;
+        // remove corresponding arc which has vertexName, only the lists that
+        // may hold one of its arcs are visited.
+        auto holders_it = _arc_holders.find(vertexName);
+        if(holders_it != _arc_holders.end()) {
+            for(auto& holder : holders_it->second) {
+                if(!has_vertex(holder)) {
+                    continue;
                 }
-            }
-            for(auto arc_it = _graph_out_arcs[it->first].begin(); arc_it != _graph_out_arcs[it->first].end();) {
-                if((*arc_it)->bottom() == vertexName || (*arc_it)->top() == vertexName) {
-                    arc_it = _graph_out_arcs[it->first].erase(arc_it);
-                } else {
-                    ++arc_it;
+                for(auto arc_it = _graph_in_arcs[holder].begin(); arc_it != _graph_in_arcs[holder].end();) {
+                    if((*arc_it)->bottom() == vertexName || (*arc_it)->top() == vertexName) {
+                        arc_it = _graph_in_arcs[holder].erase(arc_it);
+                    } else {
+                        ++arc_it;
+                    }
+                }
+                for(auto arc_it = _graph_out_arcs[holder].begin(); arc_it != _graph_out_arcs[holder].end();) {
+                    if((*arc_it)->bottom() == vertexName || (*arc_it)->top() == vertexName) {
+                        arc_it = _graph_out_arcs[holder].erase(arc_it);
+                    } else {
+                        ++arc_it;
+                    }
                 }
             }
+            _arc_holders.erase(holders_it);
         }
         // remove corresponding arc in _arcs 
         for(auto& in_arc_it : _graph_in_arcs[vertexName]) {
@@ -210,31 +276,36 @@ template<typename VertexNameType, typename VertexType, typename WeightType, type
 void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::remove(ArcType& arc) {
     if(has_arc(arc)) {
         Arc_iterator<VertexNameType, WeightType, ArcType> it = find(arc.bottom(), arc.top());
-        _arcs.erase(it.origin());
+        erase_arc(it.origin());
     }
 }
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
 void GraphBase<VertexNameType, VertexType, WeightType, ArcType>::remove_byio(ArcType& arc) {
-    if(has_arc(arc)) {
-        Arc_iterator<VertexNameType, WeightType, ArcType> it = find(arc.bottom(), arc.top());
-        _arcs.erase(it.origin());
-    }
     auto bot = arc.bottom();
     auto top = arc.top();
 
+    // drop the list entries before the arc they point to is erased
     for(auto out_arc_it = _graph_out_arcs[bot].begin();
-     out_arc_it != _graph_out_arcs[bot].end(); ++out_arc_it) {
+     out_arc_it != _graph_out_arcs[bot].end();) {
         if(out_arc_it->origin()->top() == top) {
-            _graph_out_arcs[bot].erase(out_arc_it);
+            out_arc_it = _graph_out_arcs[bot].erase(out_arc_it);
+        } else {
+            ++out_arc_it;
         }
     }
     for(auto in_arc_it = _graph_in_arcs[top].begin();
-     in_arc_it != _graph_in_arcs[top].end(); ++in_arc_it) {
+     in_arc_it != _graph_in_arcs[top].end();) {
         if(in_arc_it->origin()->bottom() == bot) {
-            _graph_in_arcs[top].erase(in_arc_it);
+            in_arc_it = _graph_in_arcs[top].erase(in_arc_it);
+        } else {
+            ++in_arc_it;
         }
     }
+    if(has_arc(arc)) {
+        Arc_iterator<VertexNameType, WeightType, ArcType> it = find(arc.bottom(), arc.top());
+        erase_arc(it.origin());
+    }
     
 }
 
@@ -267,12 +338,7 @@ bool GraphBase<VertexNameType, VertexType, WeightType, ArcType>::has_arc(VertexN
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
 bool GraphBase<VertexNameType, VertexType, WeightType, ArcType>::has_arc(ArcType& arc) {
-    Arc_iterator<VertexNameType, WeightType, ArcType> it_end = _arcs.end();
-    Arc_iterator<VertexNameType, WeightType, ArcType> it = std::find(_arcs.begin(), _arcs.end(), arc);
-    if(it != it_end) {
-        return true;
-    }
-    return false;
+    return _arc_index.count(ArcKey(arc.bottom(), arc.top())) > 0;
 }
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
@@ -282,9 +348,11 @@ typename GraphBase<VertexNameType, VertexType, WeightType, ArcType>::iterator Gr
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
 Arc_iterator<VertexNameType, WeightType, ArcType> GraphBase<VertexNameType, VertexType, WeightType, ArcType>::find(VertexNameType vertex_name_0, VertexNameType vertex_name_1) {
-    ArcType arc(vertex_name_0, vertex_name_1);
-    Arc_iterator<VertexNameType, WeightType, ArcType> it  = std::find(_arcs.begin(), _arcs.end(), arc);
-    return it;
+    auto key_it = _arc_index.find(ArcKey(vertex_name_0, vertex_name_1));
+    if(key_it == _arc_index.end()) {
+        return _arcs.end();
+    }
+    return key_it->second.front();
 }
 
 template<typename VertexNameType, typename VertexType, typename WeightType, typename ArcType>
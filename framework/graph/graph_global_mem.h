@@ -20,8 +20,13 @@
 #include <vector>
 #include "framework/core/singleton.h"
 #include "framework/core/parameter.h"
+#include "framework/core/data_types.h"
 #include "utils/logger/logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <mutex>
+#include <unordered_map>
 
 namespace anakin {
 
@@ -41,6 +46,32 @@ enum Level {
 
 namespace graph {
 
+/**
+* \brief weight dedup counters of GraphGlobalMem
+*/
+struct DedupStats {
+    size_t unique_blocks{0};    ///< blocks loaded with content seen for the first time
+    size_t shared_blocks{0};    ///< blocks loaded onto the memory of an identical earlier block
+    size_t saved_bytes{0};      ///< memory the shared blocks don't use right now
+};
+
+/// 64 bit hash of weight bytes, 8 bytes a step.
+inline uint64_t weight_hash(const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = 0xcbf29ce484222325ULL ^ bytes;
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        h = (h ^ word) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    for (; i < bytes; i++) {
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return h ^ (h >> 32);
+}
+
 /**
 * \brief global resource level stage
 */
@@ -86,6 +117,10 @@ private:
 public:
     GraphGlobalMemBase() {
         _res_guard.emplace(nullptr, make_lock());
+#ifndef USE_SGX
+        const char* env = std::getenv("ANAKIN_WEIGHT_DEDUP");
+        _dedup = env != nullptr && std::atoi(env) != 0;
+#endif
     }
 
     ~GraphGlobalMemBase() {}
@@ -109,6 +144,69 @@ public:
         //_push_mem_pool(block_p, DataTypeWarpper<Dtype>());
     }
 
+    /// turn weight dedup on or off for the blocks loaded from now on, env ANAKIN_WEIGHT_DEDUP=1 turns it on.
+    void set_dedup(bool dedup) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut);
+        _dedup = dedup;
+    }
+
+    /**
+     * \brief share the memory of an identical block loaded before, by this graph or another one.
+     *
+     * Called on a block from new_block once its data and shapes are filled. When dedup is on and
+     * an earlier block has the same data type, shapes, scale and bytes, the tensors of block_p drop
+     * their own memory and share the earlier one. The shared memory stays read only: a tensor
+     * written by the func of apply gets a private copy at its first write, a func that only
+     * reads it (or does nothing, like an unimplemented trans_weights) keeps it shared.
+     */
+    void dedup_block(PBlock<Ttype>* block_p) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut);
+        if (!_dedup) {
+            return;
+        }
+        auto& h_tensor = block_p->h_tensor();
+        size_t bytes = h_tensor.shape().count() * h_tensor.get_dtype_size();
+        if (bytes == 0) {
+            return;
+        }
+        uint64_t hash = weight_hash(h_tensor.data(), bytes);
+        auto range = _dedup_index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            DedupEntry& entry = _dedup_keys[it->second];
+            if (!_same_content(entry.reference, *block_p, bytes)) {
+                continue;
+            }
+            void* old_key = block_p->d_tensor().data();
+            _share_block(*block_p, entry.reference);
+            _res_guard.erase(old_key);
+            _dedup_holders[&block_p->d_tensor()] = *block_p;
+            entry.refs++;
+            _dedup_stats.shared_blocks++;
+            _dedup_stats.saved_bytes += bytes;
+            return;
+        }
+        // first block with this content, the reference keeps the memory for later blocks
+        DedupEntry entry;
+        entry.hash = hash;
+        entry.refs = 1;
+        entry.bytes = bytes;
+        entry.reference = PBlock<Ttype>(block_p->data_type());
+        _share_block(entry.reference, *block_p);
+        // shared with itself, so the first write through apply copies as well
+        _share_block(*block_p, entry.reference);
+        void* key = block_p->d_tensor().data();
+        _dedup_holders[&block_p->d_tensor()] = *block_p;
+        _dedup_keys.emplace(key, entry);
+        _dedup_index.emplace(hash, key);
+        _dedup_stats.unique_blocks++;
+    }
+
+    /// dedup counters, saved_bytes goes down again as shared blocks are written and copied.
+    DedupStats get_dedup_stats() EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        std::unique_lock<std::mutex> lock(this->_mut);
+        return _dedup_stats;
+    }
+
     /// apply arbitrary function to two memory block
     /// note: that args may contain target PBlock pointer
     ///       so we need to set mutex for mem management
@@ -124,16 +222,20 @@ public:
             }
             _res_guard[key_1]->template use<L>();
             _res_guard[key_2]->template use<L>();
+            bool dedup_1 = _begin_write(tensor_1.d_tensor());
+            bool dedup_2 = _begin_write(tensor_2.d_tensor());
             func(tensor_1, tensor_2, std::forward<ParamTypes>(args)...);
+            dedup_1 = _end_write<L>(tensor_1.d_tensor(), key_1, dedup_1);
+            dedup_2 = _end_write<L>(tensor_2.d_tensor(), key_2, dedup_2);
             void *new_key_1 = tensor_1.d_tensor().data();
             void *new_key_2 = tensor_2.d_tensor().data();
-            if (new_key_1 != key_1) {
+            if (!dedup_1 && new_key_1 != key_1) {
                 _res_guard.emplace(new_key_1, make_lock()).first->second.swap(_res_guard[key_1]);
                 if (key_1 && _res_guard.erase(key_1) != 1) { // delete old key-vale
                             LOG(FATAL) << "target key_1(" << key_1 << ") doesn't exist.";
                 }
             }
-            if (new_key_2 != key_2) {
+            if (!dedup_2 && new_key_2 != key_2) {
                 _res_guard.emplace(new_key_2, make_lock()).first->second.swap(_res_guard[key_2]);
                 if (key_2 && _res_guard.erase(key_2) != 1) { // delete old key-vale
                             LOG(FATAL) << "target key_2(" << key_2 << ") doesn't exist.";
@@ -152,9 +254,11 @@ public:
         if (_res_guard[key]->template check_access<L>()) {
             std::unique_lock<std::mutex> lock(_res_guard[key]->template get_mut<L>());
             _res_guard[key]->template use<L>();
+            bool dedup = _begin_write(tensor.d_tensor());
             func(tensor, std::forward<ParamTypes>(args)...);
-            void *new_key = tensor.data();
-            if (new_key != key) {
+            dedup = _end_write<L>(tensor.d_tensor(), key, dedup);
+            void *new_key = tensor.d_tensor().data();
+            if (!dedup && new_key != key) {
                 _res_guard.emplace(new_key, make_lock()).first->second.swap(_res_guard[key]);
                 if (key && _res_guard.erase(key) != 1) { // delete old key-vale
                             LOG(FATAL) << "target key(" << key << ") doesn't exist.";
@@ -173,9 +277,11 @@ public:
         if (_res_guard[key]->template check_access<L>()) {
             std::unique_lock<std::mutex> lock(_res_guard[key]->template get_mut<L>());
             _res_guard[key]->template use<L>();
+            bool dedup = _begin_write(tensor);
             func(tensor, std::forward<ParamTypes>(args)...);
+            dedup = _end_write<L>(tensor, key, dedup);
             void *new_key = tensor.data(); // check if tensor data has changed
-            if (key != new_key) {
+            if (!dedup && key != new_key) {
                 _res_guard.emplace(new_key, make_lock()).first->second.swap(_res_guard[key]);
                 if (key && _res_guard.erase(key) != 1) { // delete old key-vale
                             LOG(FATAL) << "target key(" << key << ") doesn't exist.";
@@ -200,16 +306,20 @@ public:
                 }
                 _res_guard[key1]->template use<L>();
                 _res_guard[key2]->template use<L>();
+                bool dedup1 = _begin_write(tensor1);
+                bool dedup2 = _begin_write(tensor2);
                 func(tensor1, tensor2, std::forward<ParamTypes>(args)...);
+                dedup1 = _end_write<L>(tensor1, key1, dedup1);
+                dedup2 = _end_write<L>(tensor2, key2, dedup2);
                 void *new_key1 = tensor1.data(); // check if tensor data has changed
                 void *new_key2 = tensor2.data(); // check if tensor data has changed
-                if (key1 != new_key1) {
+                if (!dedup1 && key1 != new_key1) {
                     _res_guard.emplace(new_key1, make_lock()).first->second.swap(_res_guard[key1]);
                     if (key1 && _res_guard.erase(key1) != 1) { // delete old key-vale
                                 LOG(FATAL) << "target key(" << key1 << ") doesn't exist.";
                     }
                 }
-                if (key2 != new_key2) {
+                if (!dedup2 && key2 != new_key2) {
                     _res_guard.emplace(new_key2, make_lock()).first->second.swap(_res_guard[key2]);
                     if (key2 && _res_guard.erase(key2) != 1) { // delete old key-vale
                                 LOG(FATAL) << "target key(" << key2 << ") doesn't exist.";
@@ -235,6 +345,7 @@ public:
         for (auto block_p : _fp32_mem_pool) {
             sum += block_p->count() * 4;
         }
+        sum -= std::min(sum, _dedup_stats.saved_bytes);
         return sum / 1e6;
     }
 
@@ -253,6 +364,10 @@ public:
             delete block_p;
         }
         _fp32_mem_pool.clear();
+        _dedup_index.clear();
+        _dedup_keys.clear();
+        _dedup_holders.clear();
+        _dedup_stats = DedupStats();
     }
 
     /// get pool size
@@ -260,6 +375,114 @@ public:
     size_t get_pool_size() { return _get_pool_size(DataTypeWarpper<Dtype>()); }
 
 private:
+    /// same data type, shapes, scale and bytes
+    bool _same_content(PBlock<Ttype>& target, PBlock<Ttype>& block, size_t bytes) {
+        auto& lhs = target.h_tensor();
+        auto& rhs = block.h_tensor();
+        return lhs.get_dtype() == rhs.get_dtype()
+               && lhs.shape() == rhs.shape()
+               && lhs.valid_shape() == rhs.valid_shape()
+               && lhs.get_scale() == rhs.get_scale()
+               && memcmp(lhs.data(), rhs.data(), bytes) == 0;
+    }
+
+    template<typename TensorType>
+    static void _share_tensor(TensorType& tensor, TensorType& target) {
+        tensor.share_from(target);
+        tensor.set_shape(target.valid_shape(), target.shape());
+        tensor.set_scale(target.get_scale());
+    }
+
+    /// block (device and host tensor) onto the memory of target
+    static void _share_block(PBlock<Ttype>& block, PBlock<Ttype>& target) {
+        _share_tensor(block.d_tensor(), target.d_tensor());
+        if ((void*)&block.h_tensor() != (void*)&block.d_tensor()) {
+            _share_tensor(block.h_tensor(), target.h_tensor());
+        }
+    }
+
+    /**
+     * \brief called by apply before func: a tensor on deduped memory copies it at its first write
+     * only. so does a host tensor of its own, functors often fill it and copy it to the device.
+     */
+    bool _begin_write(Tensor4d<Ttype>& tensor) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        if (_dedup_keys.count(tensor.data()) == 0) {
+            return false;
+        }
+        tensor.set_copy_on_write(true);
+        _set_host_copy_on_write(tensor, true);
+        return true;
+    }
+
+    /// the same for the host tensor of the block owning tensor, if it has one of its own
+    void _set_host_copy_on_write(Tensor4d<Ttype>& tensor, bool copy_on_write) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        auto holder = _dedup_holders.find(&tensor);
+        if (holder == _dedup_holders.end()) {
+            return;
+        }
+        PBlock<Ttype> block = holder->second;
+        if ((void*)&block.h_tensor() != (void*)&block.d_tensor()) {
+            block.h_tensor().set_copy_on_write(copy_on_write);
+        }
+    }
+
+    /**
+     * \brief called by apply after func, deduped tells what _begin_write returned. true when func
+     * moved tensor off the deduped memory at key: the copy gets its own resource guard, used at
+     * level L, and key stays accessible at L for the blocks still on it.
+     */
+    template<Level L>
+    bool _end_write(Tensor4d<Ttype>& tensor, void* key, bool deduped) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        if (!deduped) {
+            return false;
+        }
+        tensor.set_copy_on_write(false);
+        _set_host_copy_on_write(tensor, false);
+        void* new_key = tensor.data();
+        if (new_key == key) {
+            return false;
+        }
+        _res_guard[new_key].reset(new LevelList());
+        _res_guard[new_key]->template use<L>();
+        auto guard = _res_guard.find(key);
+        if (guard != _res_guard.end()) {
+            guard->second->template check_access<L>() = true;
+        }
+        _leave_dedup(tensor, key);
+        return true;
+    }
+
+    /**
+     * \brief tensor left the deduped memory at key. its host tensor gets a private copy as well,
+     * the memory is dropped from the dedup index with its last user.
+     */
+    void _leave_dedup(Tensor4d<Ttype>& tensor, void* key) EXCLUSIVE_LOCKS_REQUIRED(_mut) {
+        auto entry = _dedup_keys.find(key);
+        auto holder = _dedup_holders.find(&tensor);
+        if (holder != _dedup_holders.end()) {
+            PBlock<Ttype> block = holder->second;
+            if ((void*)&block.h_tensor() != (void*)&block.d_tensor()) {
+                SABER_CHECK(block.h_tensor().unshare());
+            }
+            _dedup_holders.erase(holder);
+        }
+        if (entry->second.refs > 1) {
+            _dedup_stats.saved_bytes -= entry->second.bytes;
+        }
+        if (--entry->second.refs > 0) {
+            return;
+        }
+        auto range = _dedup_index.equal_range(entry->second.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == key) {
+                _dedup_index.erase(it);
+                break;
+            }
+        }
+        _dedup_keys.erase(entry);
+        _res_guard.erase(key);
+    }
+
     /// push int8_mem operaiton
     void _push_mem_pool(PBlock<Ttype> *block_p, DataTypeWarpper<AK_INT8>) {
         _int8_mem_pool.push_back(block_p);
@@ -298,6 +521,21 @@ private:
     std::vector<PBlock<Ttype> *> _fp16_mem_pool GUARDED_BY(_mut);
     ///< _fp32_mem_pool stand for fp32 type memory
     std::vector<PBlock<Ttype> *> _fp32_mem_pool GUARDED_BY(_mut);
+    ///< dedup of loaded weights, see dedup_block
+    struct DedupEntry {
+        uint64_t hash{0};
+        int refs{0};                ///< blocks on the memory
+        size_t bytes{0};
+        PBlock<Ttype> reference;    ///< holds the memory and its shapes for the next match
+    };
+    bool _dedup{false};
+    ///< content hash -> deduped memory (device data pointer), unchanged since loaded
+    std::unordered_multimap<uint64_t, void*> _dedup_index GUARDED_BY(_mut);
+    ///< deduped memory -> its entry
+    std::unordered_map<void*, DedupEntry> _dedup_keys GUARDED_BY(_mut);
+    ///< device tensor of a block on deduped memory -> the block, to reach its host tensor
+    std::unordered_map<void*, PBlock<Ttype>> _dedup_holders GUARDED_BY(_mut);
+    DedupStats _dedup_stats GUARDED_BY(_mut);
     ///< _mut
     std::mutex _mut;
 };
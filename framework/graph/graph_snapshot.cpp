@@ -0,0 +1,175 @@
+#include "framework/graph/graph_snapshot.h"
+#include "utils/logger/logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+#endif
+
+namespace anakin {
+
+namespace graph {
+
+namespace {
+
+const char* kSnapshotMagic = "ANAKIN_GRAPH_SNAPSHOT";
+
+std::string cpu_isa_name() {
+#ifdef USE_X86_PLACE
+    return saber::x86_isa_kernels().isa_name;
+#else
+    return "none";
+#endif
+}
+
+} // namespace
+
+Status hash_file(const std::string& path, uint64_t& hash) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    if (!file) {
+        LOG(WARNING) << path << " : can't be read for the snapshot key.";
+        return Status::ANAKINFAIL("Model can't be read");
+    }
+
+    hash = 14695981039346656037ULL;
+    std::vector<char> chunk(1 << 20);
+
+    while (file) {
+        file.read(chunk.data(), chunk.size());
+        std::streamsize count = file.gcount();
+
+        for (std::streamsize i = 0; i < count; i++) {
+            hash ^= static_cast<unsigned char>(chunk[i]);
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    if (file.bad()) {
+        return Status::ANAKINFAIL("Model read failed");
+    }
+
+    return Status::OK();
+}
+
+Status graph_snapshot_key(const std::string& model_path,
+                          const std::string& target, Precision precision,
+                          const std::unordered_map<std::string, std::vector<int> >& shape_map,
+                          std::string& key) {
+    uint64_t model_hash = 0;
+    Status ret = hash_file(model_path, model_hash);
+
+    if (!ret) {
+        return ret;
+    }
+
+    std::ostringstream stream;
+    stream << kGraphSnapshotFormat << "-" << std::hex << model_hash << std::dec
+        << "-" << target << "-p" << static_cast<int>(precision) << "-" << cpu_isa_name();
+    // unordered_map order is not stable, sort the inputs by name
+    std::vector<std::string> names;
+
+    for (auto& it : shape_map) {
+        names.push_back(it.first);
+    }
+
+    std::sort(names.begin(), names.end());
+
+    for (auto& name : names) {
+        stream << "-" << name;
+
+        for (auto dim : shape_map.at(name)) {
+            stream << "_" << dim;
+        }
+    }
+
+    key = stream.str();
+    return Status::OK();
+}
+
+Status write_graph_snapshot(const std::string& path, const GraphSnapshotHeader& header,
+                            const std::string& payload) {
+    std::string part = path + ".part";
+    {
+        std::ofstream file(part, std::ios::out | std::ios::trunc | std::ios::binary);
+
+        if (!file) {
+            LOG(ERROR) << part << " : can't be created.";
+            return Status::ANAKINFAIL("Snapshot can't be created");
+        }
+
+        file << kSnapshotMagic << " " << kGraphSnapshotFormat << "\n"
+             << header.key << "\n"
+             << header.exec_order.size() << "\n";
+
+        for (auto& name : header.exec_order) {
+            file << name << "\n";
+        }
+
+        file << payload.size() << "\n";
+        file.write(payload.data(), payload.size());
+
+        if (!file) {
+            LOG(ERROR) << part << " : write failed.";
+            std::remove(part.c_str());
+            return Status::ANAKINFAIL("Snapshot write failed");
+        }
+    }
+
+    // another process may write the same snapshot, rename keeps either copy whole
+    if (std::rename(part.c_str(), path.c_str()) != 0) {
+        std::remove(part.c_str());
+        return Status::ANAKINFAIL("Snapshot rename failed");
+    }
+
+    return Status::OK();
+}
+
+Status read_graph_snapshot(const std::string& path, GraphSnapshotHeader& header,
+                           std::string& payload) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    if (!file) {
+        return Status::ANAKINFAIL("Snapshot not found");
+    }
+
+    std::string magic;
+    std::string format;
+    size_t order_size = 0;
+    file >> magic >> format;
+
+    if (magic != kSnapshotMagic || format != kGraphSnapshotFormat) {
+        LOG(WARNING) << path << " : snapshot format " << format << " (expect "
+                     << kGraphSnapshotFormat << "), ignored.";
+        return Status::ANAKINFAIL("Snapshot format mismatch");
+    }
+
+    file.ignore(1);
+    std::getline(file, header.key);
+    file >> order_size;
+    file.ignore(1);
+    header.exec_order.resize(order_size);
+
+    for (auto& name : header.exec_order) {
+        std::getline(file, name);
+    }
+
+    size_t payload_size = 0;
+    file >> payload_size;
+    file.ignore(1);
+    payload.resize(payload_size);
+    file.read(&payload[0], payload_size);
+
+    if (!file || static_cast<size_t>(file.gcount()) != payload_size) {
+        LOG(WARNING) << path << " : truncated snapshot, ignored.";
+        return Status::ANAKINFAIL("Snapshot truncated");
+    }
+
+    return Status::OK();
+}
+
+} /* namespace graph */
+
+} /* namespace anakin */
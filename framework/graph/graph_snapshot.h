@@ -0,0 +1,80 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_GRAPH_SNAPSHOT_H
+#define ANAKIN_GRAPH_SNAPSHOT_H
+
+#include "anakin_config.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "framework/core/base.h"
+#include "framework/core/types.h"
+
+namespace anakin {
+
+namespace graph {
+
+#ifndef ANAKIN_GRAPH_SNAPSHOT_FORMAT
+#define ANAKIN_GRAPH_SNAPSHOT_FORMAT "unknown"
+#endif
+
+/**
+ * \brief format of the snapshot file, a hash of the serializer and optimizer sources
+ *  computed at configure time, so snapshots of another build are rebuilt.
+ */
+const char* const kGraphSnapshotFormat = ANAKIN_GRAPH_SNAPSHOT_FORMAT;
+
+/**
+ * \brief the part of a snapshot that the model proto can't hold.
+ *  file layout:
+ *      ANAKIN_GRAPH_SNAPSHOT <format>\n
+ *      <key>\n
+ *      <exec order size>\n
+ *      <node name>\n ...
+ *      <payload size>\n
+ *      <optimized graph proto, as written by Graph::save>
+ */
+struct GraphSnapshotHeader {
+    std::string key;
+    std::vector<std::string> exec_order;
+};
+
+/// 64 bit FNV-1a of the content of a file, fails if it can't be read.
+Status hash_file(const std::string& path, uint64_t& hash);
+
+/**
+ * \brief key of an optimized graph: snapshot format, model content hash, target,
+ *  precision, cpu isa and the input shapes. Fails if the model can't be read.
+ */
+Status graph_snapshot_key(const std::string& model_path,
+                          const std::string& target, Precision precision,
+                          const std::unordered_map<std::string, std::vector<int> >& shape_map,
+                          std::string& key);
+
+/// write header and payload to path, through a temporary file so readers never see half a snapshot.
+Status write_graph_snapshot(const std::string& path, const GraphSnapshotHeader& header,
+                            const std::string& payload);
+
+/// read a snapshot, fails on a format mismatch or a truncated file.
+Status read_graph_snapshot(const std::string& path, GraphSnapshotHeader& header,
+                           std::string& payload);
+
+} /* namespace graph */
+
+} /* namespace anakin */
+
+#endif
@@ -162,6 +162,13 @@ REGISTER_GRAPH_FUSION_PATTERN(SeqConcatSeqPoolSoftSign)
 .AddConnect("seq_pool_0", "soft_sign_0")
 .CreatePattern([](VGraph* graph) {});
 
+REGISTER_GRAPH_FUSION_PATTERN(SequenceConvRelu)
+.Type(IN_ORDER)
+.AddOpNode("sequence_conv_0",  "SequenceConv")
+.AddOpNode("relu_0", "ReLU")
+.AddConnect("sequence_conv_0", "relu_0")
+.CreatePattern([](VGraph* graph) {});
+
 REGISTER_GRAPH_FUSION_PATTERN(ConvFusion)
 .Type(IN_PARELLEL)
 .AddOpNode("conv_0",  "ConvBatchnormScaleRelu")
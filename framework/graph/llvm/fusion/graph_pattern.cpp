@@ -1,4 +1,6 @@
 #include "framework/graph/llvm/fusion/graph_pattern.h"
+#include <set>
+#include <unordered_set>
 
 namespace anakin {
 
@@ -92,13 +94,26 @@ std::unordered_map<Fusion, std::function<int(VGraph*, Pattern*)>, FusionHash> Fu
 
                     node_merge.mergeNodeNames = pattern_node_name_saves;
                     param_node = node_merge;
+                    vgraph->reindex(param_node.name);
 
                     return 0;
                 } else {
                     return 0; // continue searching
                 }
             };
-            vgraph->Scanner->BFS(search_vgraph, pattern);
+            // only nodes of the pattern's root op can start a match, so seed from the op index
+            // instead of visiting the whole graph. nodes_of_op keeps the order the nodes were
+            // added in, which for a vgraph built by Graph is the BFS order of the old scan.
+            auto pattern_ins = pattern->get_graph_ins();
+            CHECK_EQ(pattern_ins.size(), 1) << " The IN_ORDER pattern graph should only have one input";
+            std::string root_op = (*pattern)[pattern_ins[0]].opName;
+            for (auto& name : vgraph->nodes_of_op(root_op)) {
+                // merged by an earlier match of this pass
+                if (!vgraph->has_vertex(name) || (*vgraph)[name].opName != root_op) {
+                    continue;
+                }
+                search_vgraph((*vgraph)[name], pattern);
+            }
             return 0;
         }
     },
@@ -106,9 +121,15 @@ std::unordered_map<Fusion, std::function<int(VGraph*, Pattern*)>, FusionHash> Fu
         IN_PARELLEL,
         [](VGraph * vgraph, Pattern * pattern) ->int {
             //function: check accessible between node and nodelist
-            auto table = vgraph -> connect_table();
             //auto table = std::map<std::pair<std::string, std::string>, int>();
+            //the table is O(V^2), it's only built when a multi-input pattern needs it
+            std::map<std::pair<std::string, std::string>, int> table;
+            bool table_ready = false;
             auto check_accessible_node_and_nodelist = [&](std::string name, std::vector<std::string> namelist) -> bool {
+                if (!table_ready) {
+                    table = vgraph -> connect_table();
+                    table_ready = true;
+                }
                 for (std::string another_name : namelist){
                     if (table[{name, another_name}] || table[{another_name, name}]){
                         return true;
@@ -467,38 +488,56 @@ std::unordered_map<Fusion, std::function<int(VGraph*, Pattern*)>, FusionHash> Fu
                     
                     
                     (*vgraph)[node_merge.name] = node_merge;
+                    vgraph -> reindex(node_merge.name);
                     
                     return 0;
                 } else {
                     return 0;
                 }
             };
-            vgraph->Scanner->DFS(search_vgraph_from_onenode, pattern);
+            if (pattern -> size() != 1) {
+                LOG(WARNING)<<"pattern node > 1, fusion searching will use search_vgraph";
+                return 0;
+            }
+            //only parents of the nodes of the pattern's op can merge something,
+            //seed from them in the order their children were added
+            std::vector<std::string> parents;
+            std::unordered_set<std::string> parent_set;
+            for (auto& name : vgraph -> nodes_of_op(pattern -> begin() -> second.opName)){
+                for (auto& arc_it : vgraph -> get_in_arc_its(name)){
+                    if (parent_set.insert(arc_it -> bottom()).second){
+                        parents.push_back(arc_it -> bottom());
+                    }
+                }
+            }
+            for (auto& name : parents){
+                if (vgraph -> has_vertex(name)){
+                    search_vgraph_from_onenode((*vgraph)[name], pattern);
+                }
+            }
             //vgraph->Scanner->DFS(search_vgraph, pattern);
             
             //test in and out arc
-            std::vector<std::pair<std::string, std::string>> out_arc_vec;
-            std::vector<std::pair<std::string, std::string>> in_arc_vec;
+            std::set<std::pair<std::string, std::string>> out_arc_set;
+            std::set<std::pair<std::string, std::string>> in_arc_set;
             for (auto vert=vgraph->begin(); vert!=vgraph->end(); ++vert){
-                auto out_arc = vgraph -> get_out_arc_its(vert->first);
+                auto& out_arc = vgraph -> get_out_arc_its(vert->first);
                 for (auto arc : out_arc){
-                    out_arc_vec.push_back({vert->first, arc->top()});
+                    out_arc_set.insert({vert->first, arc->top()});
                 }
-                auto in_arc = vgraph -> get_in_arc_its(vert->first);
+                auto& in_arc = vgraph -> get_in_arc_its(vert->first);
                 for (auto arc : in_arc){
-                    in_arc_vec.push_back({arc->bottom(), vert->first});
+                    in_arc_set.insert({arc->bottom(), vert->first});
                 }
             }
-            for (int i=0; i<in_arc_vec.size(); ++i){
-                //LOG(INFO)<< "in_arcs:"<<"{"<<in_arc_vec[i].first<<","<<in_arc_vec[i].second<<"}";
-                if (std::find(out_arc_vec.begin(), out_arc_vec.end(), in_arc_vec[i]) == out_arc_vec.end()){
-                    LOG(INFO)<< "not in out_arcs:"<<"{"<<in_arc_vec[i].first<<","<<in_arc_vec[i].second<<"}";
+            for (auto& in_arc : in_arc_set){
+                if (out_arc_set.count(in_arc) == 0){
+                    LOG(INFO)<< "not in out_arcs:"<<"{"<<in_arc.first<<","<<in_arc.second<<"}";
                 }
             }
-            for (int i=0; i<out_arc_vec.size(); ++i){
-                //LOG(INFO)<< "out_arcs:"<<"{"<<out_arc_vec[i].first<<","<<out_arc_vec[i].second<<"}";
-                if (std::find(in_arc_vec.begin(), in_arc_vec.end(), out_arc_vec[i]) == in_arc_vec.end()){
-                    LOG(INFO)<< "not in in_arcs:"<<"{"<<out_arc_vec[i].first<<","<<out_arc_vec[i].second<<"}";
+            for (auto& out_arc : out_arc_set){
+                if (in_arc_set.count(out_arc) == 0){
+                    LOG(INFO)<< "not in in_arcs:"<<"{"<<out_arc.first<<","<<out_arc.second<<"}";
                 }
             }
             return 0;
@@ -129,6 +129,8 @@ void ConvElsFusionScheduler::Run() {
 		node_eltwise.opName = "Gather"; // change eltwise op to Gather op
 		node_eltwise.mergeNodes.clear();
 		node_eltwise.mergeNodeNames.clear();
+		_vgraph->reindex(tmp_pair.conv_name);
+		_vgraph->reindex(tmp_pair.eltwise_name);
 	}
 	// set exec order for vgraph
 	auto exec_node_order = this->get_exec_node_in_order();
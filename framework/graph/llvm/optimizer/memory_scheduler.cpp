@@ -308,6 +308,23 @@ void MemoryScheduler::launch(node& node_arg) {
 
     this->free(io_out);
 
+    // outputs of shape const nodes are kept between predictions, nothing may reuse them
+    std::vector<bool> ins_const;
+    for (auto& arc_it : _vgraph->get_in_arc_its(node_arg.name)) {
+        ins_const.push_back(_shape_const_nodes.count(arc_it->bottom()) > 0);
+    }
+    if (_shape_const(node_arg.opName, ins_const)) {
+        _shape_const_nodes.insert(node_arg.name);
+        // self shared outputs are views of a kept input already
+        if (!_need_self_shared(node_arg)) {
+            for (auto& io_tmp : io_out) {
+                if (!this->is_fixed(io_tmp)) {
+                    _fix_io_res.push_back(io_tmp);
+                }
+            }
+        }
+    }
+
     // used for memory analysis
     set_fix_io(io_out);
 
@@ -20,6 +20,8 @@
 #include "framework/graph/llvm/schedule_base.h"
 #include "framework/graph/llvm/virtual_graph.h"
 #include "framework/graph/llvm/scheduler.h"
+#include <algorithm>
+#include <unordered_set>
 
 namespace anakin {
 
@@ -77,6 +79,40 @@ struct check_self_shared {
     }
 };
 
+/**
+ * \brief check_shape_const struct
+ *  used to find the nodes computed once per input shape: ops whose outputs depend on
+ *  the shapes of their inputs only (prior boxes, anchors), and ops fed by them only.
+ *  The memory of their outputs is never reused, it keeps the result between predictions.
+ */
+struct check_shape_const {
+    /// ops : PriorBox and AnchorGenerator
+    std::vector<std::string> ops{
+        "PriorBox",
+        "AnchorGenerator"
+    };
+    /**
+     * \brief whether op_name only reads the shapes of its inputs
+     */
+    inline bool shape_only(const std::string& op_name) {
+        return std::find(ops.begin(), ops.end(), op_name) != ops.end();
+    }
+    /**
+     * \brief whether a node of op_name is shape const
+     * \param ins_const stand for whether each input comes from a shape const node
+     * \return bool
+     */
+    inline bool operator()(const std::string& op_name, const std::vector<bool>& ins_const) {
+        if (shape_only(op_name)) {
+            return true;
+        }
+        if (op_name == "Input" || op_name == "Output" || ins_const.empty()) {
+            return false;
+        }
+        return std::find(ins_const.begin(), ins_const.end(), false) == ins_const.end();
+    }
+};
+
 class MemoryScheduler;
 
 /**
@@ -164,6 +200,8 @@ public:
 private:
     IOBlockResource _io_block_res;
     check_self_shared _need_self_shared;
+    check_shape_const _shape_const;
+    std::unordered_set<std::string> _shape_const_nodes;
     std::map<io, int> io_number_map;
 };
 
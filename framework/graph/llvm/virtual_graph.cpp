@@ -1,6 +1,7 @@
 #include "framework/graph/llvm/virtual_graph.h"
 #include "framework/graph/llvm/fusion/graph_pattern.h"
 #include <stack>
+#include <unordered_set>
 
 namespace anakin {
 
@@ -91,43 +92,69 @@ bool VGraph::check_accessible(std::string bottom, std::string top){
 }
 
 std::map<std::pair<std::string, std::string>, int> VGraph::connect_table(){
+        // pairs not in the table are not connected, operator[] of the callers reads them as 0
         std::map<std::pair<std::string, std::string>, int> table_map;
-        for (auto node0 = this -> begin(); node0 != this -> end(); ++node0){
-            for (auto node1 = this -> begin(); node1 != this -> end(); ++node1){
-                table_map[{node0->first,node1->first}] = 0;
-            }
-        }
         for (auto gnode = this -> begin(); gnode != this -> end(); ++gnode){
 
             std::stack<std::string> stk;
-            auto out_arc_its = this -> get_out_arc_its(gnode->first);
+            auto& out_arc_its = this -> get_out_arc_its(gnode->first);
             table_map[{gnode->first, gnode->first}] = 1;
 
 
             for (auto arc : out_arc_its){
                 stk.push(arc->top());
             }
-            std::vector<std::string> flag;
+            std::unordered_set<std::string> flag;
             while (!stk.empty()){
                 std::string topname = stk.top();
                 stk.pop();
-                if (std::find(flag.begin(), flag.end(), topname) != flag.end()){
+                if (!flag.insert(topname).second){
                     continue;
                 }
                 table_map[{gnode->first, topname}] = 1;
-                //if (gnode->first=="conv_4e_3x3")
-                   // LOG(INFO)<<"add node:"<<topname;
 
-                auto out_arc_its = this -> get_out_arc_its(topname);
+                auto& out_arc_its = this -> get_out_arc_its(topname);
                 for (auto arc : out_arc_its){
                     stk.push(arc->top());
                 }
-                flag.push_back(topname);
             }
         }
         return table_map;
 }
 
+void VGraph::add_vertex(std::string vertex_name, node vertex) {
+    if (!has_vertex(vertex_name)) {
+        _op_nodes[vertex.opName].push_back(vertex_name);
+    }
+
+    GraphBase<std::string, node, io>::add_vertex(vertex_name, vertex);
+}
+
+std::vector<std::string> VGraph::nodes_of_op(const std::string& op_name) {
+    std::vector<std::string> ret;
+    auto it = _op_nodes.find(op_name);
+
+    if (it == _op_nodes.end()) {
+        return ret;
+    }
+
+    // drop the nodes removed or moved to another op since they were indexed
+    std::unordered_set<std::string> seen;
+
+    for (auto& name : it->second) {
+        if (has_vertex(name) && (*this)[name].opName == op_name && seen.insert(name).second) {
+            ret.push_back(name);
+        }
+    }
+
+    it->second = ret;
+    return ret;
+}
+
+void VGraph::reindex(const std::string& vertex_name) {
+    _op_nodes[(*this)[vertex_name].opName].push_back(vertex_name);
+}
+
 void VGraph::register_outs(std::string bottom, std::string top) {
     std::pair<std::string, std::string> arc_tmp(bottom, top);
 
@@ -152,6 +152,18 @@ public:
 
     virtual bool directed() { return true; }
 
+    /// add vertex and index it by its op name
+    virtual void add_vertex(std::string vertex_name, node vertex);
+
+    /**
+    * \brief names of the nodes whose op is op_name, in the order they were added.
+    * this is where the fusion matcher seeds from instead of scanning the whole graph.
+    */
+    std::vector<std::string> nodes_of_op(const std::string& op_name);
+
+    /// must be called after the opName of vertex_name is changed in place
+    void reindex(const std::string& vertex_name);
+
     /**
     * \brief Match graph
     * search the vgraph and find the matched vgraph_pattern, 
@@ -200,6 +212,8 @@ private:
 	std::vector<std::string> _nodes_exec_order;
     ///< origin edge map to new edge after fusion
     std::unordered_map<std::string, std::string> _fusion_edge_map;
+    ///< op name to node names, may hold removed or renamed nodes until nodes_of_op compacts it
+    std::unordered_map<std::string, std::vector<std::string> > _op_nodes;
 };
 
 
@@ -197,6 +197,7 @@ NodeIO<Ttype, Ptype>& NodeIO<Ttype, Ptype>::operator>>(const NodeProto& node_pro
                         block->d_tensor().set_shape(saber_valid_shape);
                         block->h_tensor().set_shape(saber_valid_shape);
                     }
+                    graph::GraphGlobalMem<Ttype>::Global().dedup_block(block);
 
                     node_p->set_attr(key, *block);
                 }
@@ -236,6 +237,7 @@ NodeIO<Ttype, Ptype>& NodeIO<Ttype, Ptype>::operator>>(const NodeProto& node_pro
                         block->d_tensor().set_shape(saber_valid_shape);
                         block->h_tensor().set_shape(saber_valid_shape);
                     }
+                    graph::GraphGlobalMem<Ttype>::Global().dedup_block(block);
 
                     node_p->set_attr(key, *block);
                 }
@@ -0,0 +1,98 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "framework/operators/fusion_ops/sequence_conv_relu.h"
+
+namespace anakin {
+
+namespace ops {
+
+#define INSTANCE_SEQUENCE_CONV_RELU(Ttype, Ptype) \
+template<> \
+void SequenceConvRelu<Ttype, Ptype>::operator()(OpContext<Ttype>& ctx, \
+    const std::vector<Tensor4dPtr<Ttype> >& ins, \
+    std::vector<Tensor4dPtr<Ttype> >& outs) { \
+    auto* impl = \
+        static_cast<SequenceConvReluHelper<Ttype, Ptype>*>(this->_helper); \
+    auto& param = \
+        static_cast<SequenceConvReluHelper<Ttype, Ptype>*>(this->_helper)->_param_sequence_conv_relu; \
+    impl->_funcs_sequence_conv_relu(ins, outs, param, ctx); \
+}
+
+template<typename Ttype, Precision Ptype>
+Status SequenceConvReluHelper<Ttype, Ptype>::InitParam() {
+    DLOG(WARNING) << "Parsing SequenceConvRelu op parameter.";
+
+    auto context_length = GET_PARAMETER(int, context_length);
+    auto context_start = GET_PARAMETER(int, context_start);
+    auto context_stride = GET_PARAMETER(int, context_stride);
+    auto padding_trainable = GET_PARAMETER(bool, padding_trainable);
+    auto bias_term = GET_PARAMETER(bool, bias_term);
+    CHECK(!padding_trainable) << "SequenceConvRelu not support padding_trainable";
+
+    using pblock_type = PBlock<Ttype>;
+    auto filter_tensor = GET_PARAMETER(pblock_type, weight_1);
+    Tensor4d<Ttype>* bias = nullptr;
+
+    if (bias_term) {
+        auto bias_block = GET_PARAMETER(pblock_type, weight_2);
+        bias = &(bias_block.d_tensor());
+    }
+
+    SequenceConvParam<Ttype> param(&(filter_tensor.d_tensor()), context_length, context_start,
+                                   context_stride, padding_trainable, nullptr, bias_term, bias,
+                                   Active_relu);
+    _param_sequence_conv_relu = param;
+    return Status::OK();
+}
+
+template<typename Ttype, Precision Ptype>
+Status SequenceConvReluHelper<Ttype, Ptype>::Init(OpContext<Ttype>& ctx,
+        const std::vector<Tensor4dPtr<Ttype> >& ins,
+        std::vector<Tensor4dPtr<Ttype> >& outs) {
+    SABER_CHECK(_funcs_sequence_conv_relu.init(ins, outs, _param_sequence_conv_relu,
+                SPECIFY, SABER_IMPL, ctx));
+    return Status::OK();
+}
+
+template<typename Ttype, Precision Ptype>
+Status SequenceConvReluHelper<Ttype, Ptype>::InferShape(const
+        std::vector<Tensor4dPtr<Ttype> >& ins,
+        std::vector<Tensor4dPtr<Ttype> >& outs) {
+    SABER_CHECK(_funcs_sequence_conv_relu.compute_output_shape(ins, outs,
+                _param_sequence_conv_relu));
+    return Status::OK();
+}
+
+#ifdef USE_X86_PLACE
+INSTANCE_SEQUENCE_CONV_RELU(X86, Precision::FP32);
+template class SequenceConvReluHelper<X86, Precision::FP32>;
+ANAKIN_REGISTER_OP_HELPER(SequenceConvRelu, SequenceConvReluHelper, X86, Precision::FP32);
+#endif
+
+//! register op
+ANAKIN_REGISTER_OP(SequenceConvRelu)
+.Doc("SequenceConvRelu fusion operator")
+#ifdef USE_X86_PLACE
+.__alias__<X86, Precision::FP32>("sequence_conv_relu")
+#endif
+.num_in(1)
+.num_out(1)
+.Args<int>("context_length", " context length ")
+.Args<int>("context_start", " context start ")
+.Args<float>("relu_0_alpha", " alpha for relu");
+
+} /* namespace ops */
+
+} /* namespace anakin */
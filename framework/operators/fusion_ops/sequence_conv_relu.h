@@ -0,0 +1,97 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_OPERATOR_SEQUENCE_CONV_RELU_H
+#define ANAKIN_OPERATOR_SEQUENCE_CONV_RELU_H
+
+#include "framework/core/base.h"
+#include "framework/core/data_types.h"
+#include "framework/core/operator/operator.h"
+#include "utils/logger/logger.h"
+#include "saber/funcs/sequence_conv.h"
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, Precision Ptype>
+class SequenceConvReluHelper;
+
+/**
+ * \brief SequenceConvRelu implementation class
+ * public inherit Operator
+ */
+template<typename Ttype, Precision Ptype>
+class SequenceConvRelu : public Operator<Ttype, Ptype> {
+public:
+    SequenceConvRelu() {}
+
+    /// forward impl
+    virtual void operator()(OpContext<Ttype>& ctx,
+                            const std::vector<Tensor4dPtr<Ttype> >& ins,
+                            std::vector<Tensor4dPtr<Ttype> >& outs) {
+        LOG(ERROR) << "Not Impl Yet Operator SequenceConvRelu< Ttype("
+                   << target_name<Ttype>::value << "), Precision("<< Ptype <<") >";
+    }
+
+    friend class SequenceConvReluHelper<Ttype, Ptype>;
+};
+
+/**
+ * \brief SequenceConvRelu helper class to implement SequenceConv with fused relu
+ * public inherit OperatorHelper
+ * including init resource and shape size in SequenceConvRelu context
+ */
+template<typename Ttype, Precision Ptype>
+class SequenceConvReluHelper : public OperatorHelper<Ttype, Ptype> {
+public:
+    SequenceConvReluHelper() = default;
+
+    ~SequenceConvReluHelper() {}
+
+    Status InitParam() override;
+
+    /**
+    * \brief initial all the resource needed by SequenceConvRelu
+    * \param ctx stand for SequenceConvRelu operation context
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status Init(OpContext<Ttype>& ctx,
+                const std::vector<Tensor4dPtr<Ttype> >& ins,
+                std::vector<Tensor4dPtr<Ttype> >& outs) override;
+
+    /**
+    * \brief infer the shape of output and input.
+    * \param ins stand for input tensor vector
+    * \param outs stand for output tensor vector
+    * \return status
+    */
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype> >& outs) override;
+
+public:
+    ///< _param_sequence_conv_relu stand for SequenceConvRelu parameter
+    saber::SequenceConvParam<Ttype> _param_sequence_conv_relu;
+    ///< _funcs_sequence_conv_relu stand for SequenceConvRelu function
+    saber::SequenceConv<Ttype, PrecisionWrapper<Ptype>::saber_type> _funcs_sequence_conv_relu;
+};
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+#endif
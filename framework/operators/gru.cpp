@@ -80,6 +80,26 @@ Status GruHelper<Ttype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype>
     return Status::OK();
 }
 
+template<typename Ttype, Precision Ptype>
+std::vector<int> GruHelper<Ttype, Ptype>::StateSizes() {
+    return {_param_gru.bias()->valid_size() / 3};
+}
+
+template<typename Ttype, Precision Ptype>
+Status GruHelper<Ttype, Ptype>::BindState(const std::vector<Tensor4dPtr<Ttype> >& states) {
+    if (states.empty()) {
+        _param_gru.state_hidden = nullptr;
+        return Status::OK();
+    }
+
+    if (_param_gru.is_reverse || states.size() != 1) {
+        return Status::ANAKINFAIL("Gru state needs a forward gru and one hidden tensor");
+    }
+
+    _param_gru.state_hidden = states[0];
+    return Status::OK();
+}
+
 #ifdef USE_CUDA
 INSTANCE_GRU(NV, Precision::FP32);
 template class GruHelper<NV, Precision::FP32>;
@@ -87,6 +87,18 @@ public:
     Status InferShape(const std::vector<Tensor4dPtr<Ttype> >& ins,
                       std::vector<Tensor4dPtr<Ttype> >& outs) override;
 
+    /**
+    * \brief widths of the hidden state of one sequence, streaming sessions
+    */
+    std::vector<int> StateSizes() override;
+
+    /**
+    * \brief carry the hidden state of every sequence in states across launches
+    * \param states hidden state tensors, empty unbinds them
+    * \return status
+    */
+    Status BindState(const std::vector<Tensor4dPtr<Ttype> >& states) override;
+
 public:
     ///< _param_gru stand for Gru parameter
     saber::GruParam<Ttype> _param_gru;
@@ -80,6 +80,33 @@ Status LstmHelper<Ttype, Ptype>::InferShape(const std::vector<Tensor4dPtr<Ttype>
     return Status::OK();
 }
 
+template<typename Ttype, Precision Ptype>
+std::vector<int> LstmHelper<Ttype, Ptype>::StateSizes() {
+    int hidden_size = _param_lstm.bias()->valid_size() / (_param_lstm.with_peephole ? 7 : 4);
+    return {hidden_size, hidden_size};
+}
+
+template<typename Ttype, Precision Ptype>
+Status LstmHelper<Ttype, Ptype>::BindState(const std::vector<Tensor4dPtr<Ttype> >& states) {
+    if (states.empty()) {
+        _param_lstm.state_hidden = nullptr;
+        _param_lstm.state_cell = nullptr;
+        return Status::OK();
+    }
+
+    if (_param_lstm.is_reverse || _param_lstm.num_direction != 1 || states.size() != 2) {
+        return Status::ANAKINFAIL("Lstm state needs a forward lstm, one hidden and one cell tensor");
+    }
+
+    if (_param_lstm.skip_num > 1) {
+        return Status::ANAKINFAIL("Lstm state doesn't support skip mode");
+    }
+
+    _param_lstm.state_hidden = states[0];
+    _param_lstm.state_cell = states[1];
+    return Status::OK();
+}
+
 #ifdef AMD_GPU
 INSTANCE_LSTM(AMD, Precision::FP32);
 template class LstmHelper<AMD, Precision::FP32>;
@@ -88,6 +88,18 @@ public:
     Status InferShape(const std::vector<Tensor4dPtr<Ttype> >& ins,
                       std::vector<Tensor4dPtr<Ttype> >& outs) override;
 
+    /**
+    * \brief widths of the hidden and cell state of one sequence, streaming sessions
+    */
+    std::vector<int> StateSizes() override;
+
+    /**
+    * \brief carry the hidden and cell state of every sequence in states across launches
+    * \param states hidden and cell state tensors, empty unbinds them
+    * \return status
+    */
+    Status BindState(const std::vector<Tensor4dPtr<Ttype> >& states) override;
+
 public:
     ///< _param_lstm stand for Lstm parameter
     saber::LstmParam<Ttype> _param_lstm;
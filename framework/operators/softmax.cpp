@@ -35,8 +35,20 @@ template<typename Ttype, Precision Ptype>
 Status SoftmaxHelper<Ttype, Ptype>::InitParam() {
     DLOG(WARNING) << "Parsing Softmax op parameter.";
     auto axis = GET_PARAMETER(int, axis);
-
-    SoftmaxParam<Ttype> param_softmax(axis);
+    float scale = 1.f;
+    if (CHECK_PARAMETER(scale)) {
+        scale = GET_PARAMETER(float, scale);
+    }
+    bool log_softmax = false;
+    if (CHECK_PARAMETER(log_softmax)) {
+        log_softmax = GET_PARAMETER(bool, log_softmax);
+    }
+    // only the x86 kernels scale the logits or take the log
+    if (!std::is_same<Ttype, X86>::value && (scale != 1.f || log_softmax)) {
+        return Status::ANAKINFAIL("Softmax scale and log_softmax are only implemented on x86");
+    }
+
+    SoftmaxParam<Ttype> param_softmax(axis, scale, log_softmax);
     _param_softmax = param_softmax;
     return Status::OK();
 }
@@ -67,6 +79,9 @@ Status SoftmaxHelper<X86, Precision::INT8>::Init(OpContext<X86>& ctx,
 template<typename Ttype, Precision Ptype>
 Status SoftmaxHelper<Ttype, Ptype>::Init(OpContext<Ttype> &ctx, const std::vector<Tensor4dPtr<Ttype>> &ins,
                            std::vector<Tensor4dPtr<Ttype>> &outs) {
+    if (ins.size() > 1) {
+        return Status::ANAKINFAIL("Softmax mask input is only implemented on x86");
+    }
     SABER_CHECK(_funcs_softmax.init(ins, outs, _param_softmax, STATIC, SABER_IMPL, ctx));
     return Status::OK();
 }
@@ -108,6 +123,9 @@ template <>
 Status SoftmaxHelper<ARM, Precision::FP32>::Init(OpContext<ARM> &ctx, \
     const std::vector<Tensor4dPtr<ARM> >& ins, \
     std::vector<Tensor4dPtr<ARM> >& outs) {
+    if (ins.size() > 1) {
+        return Status::ANAKINFAIL("Softmax mask input is only implemented on x86");
+    }
     SABER_CHECK(_funcs_softmax.init(ins, outs, _param_softmax, SPECIFY, SABER_IMPL, ctx));
     return Status::OK();
 }
@@ -120,6 +138,9 @@ template <>
 Status SoftmaxHelper<AMD, Precision::FP32>::Init(OpContext<AMD> &ctx, \
     const std::vector<Tensor4dPtr<AMD> >& ins, \
     std::vector<Tensor4dPtr<AMD> >& outs) {
+    if (ins.size() > 1) {
+        return Status::ANAKINFAIL("Softmax mask input is only implemented on x86");
+    }
     SABER_CHECK(_funcs_softmax.init(ins, outs, _param_softmax, SPECIFY, VENDER_IMPL, ctx));
     return Status::OK();
 }
@@ -128,7 +149,7 @@ ANAKIN_REGISTER_OP_HELPER(Softmax, SoftmaxHelper, AMD, Precision::FP32);
 
 //! register op
 ANAKIN_REGISTER_OP(Softmax)
-.Doc("Softmax operator")
+.Doc("Softmax operator, an optional second input is an additive mask on x86")
 #ifdef USE_CUDA
 .__alias__<NV, Precision::FP32>("softmax")
 #endif
@@ -146,9 +167,11 @@ ANAKIN_REGISTER_OP(Softmax)
 #ifdef AMD_GPU
 .__alias__<AMD, Precision::FP32>("softmax")
 #endif
-.num_in(1)
+.num_in(2)
 .num_out(1)
-.Args<int>("axis", " axis ");
+.Args<int>("axis", " axis ")
+.Args<float>("scale", " logits are scale * input, 1 by default ")
+.Args<bool>("log_softmax", " output log(softmax) ");
 
 } /* namespace ops */
 
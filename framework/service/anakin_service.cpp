@@ -1,4 +1,5 @@
 #include "framework/service/anakin_service.h"
+#include <bvar/bvar.h>
 
 namespace anakin {
 
@@ -16,14 +17,33 @@ void AnakinService<Ttype, Ptype, RunP>::initial(std::string model_name,
         int thread_num) {
     _worker_map[model_name] = std::make_shared<Worker<Ttype, Ptype, OpRunType::ASYNC> >(model_path,
                               thread_num);
+    _serialize_us[model_name] = &GlobalMetrics::Global().histogram(
+            metric_name("anakin_serialize_us", "model", model_name));
 }
 
+template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
+void AnakinService<Ttype, Ptype, RunP>::set_model_share(std::string model_name, float weight,
+        int priority, int max_threads) {
+    _worker_map[model_name]->set_scheduling(weight, priority, max_threads);
+}
+
+namespace {
+
+void print_metrics(std::ostream& os, void*) {
+    os << GlobalMetrics::Global().dump_text();
+}
+
+} // namespace
+
 template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
 void AnakinService<Ttype, Ptype, RunP>::launch() {
     for (auto it = _worker_map.begin(); it != _worker_map.end();) {
         it->second->launch();
         it++;
     }
+    GlobalMetrics::Global().start_sampler();
+    // listed on the builtin /vars page of the server, plain text at /vars/anakin_metrics
+    static bvar::PassiveStatus<std::string> metrics_var("anakin_metrics", print_metrics, nullptr);
 }
 
 template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
@@ -52,14 +72,113 @@ void AnakinService<Ttype, Ptype, RunP>::register_interior_edges(std::string mode
     _worker_map[model_name]->register_interior_edges(edge_start, edge_end);
 }
 
+namespace {
+
+/// ieee 754 half to float.
+inline float half_to_float(uint16_t h) {
+    uint32_t sign = (h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t bits = 0;
+
+    if (exp == 0x1f) {
+        bits = sign | 0x7f800000u | (mant << 13);
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    } else if (mant != 0) {
+        // subnormal, normalize it
+        exp = 113;
+        while (!(mant & 0x400)) {
+            mant <<= 1;
+            exp--;
+        }
+        bits = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+    } else {
+        bits = sign;
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+} // namespace
+
+template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
+inline Status AnakinService<Ttype, Ptype, RunP>::extract_raw_tensor(
+    butil::IOBuf& attachment, const Data& data,
+    Tensor4d<typename target_host<Ttype>::type>& tensor,
+    std::vector<butil::IOBuf>& raw_holder) {
+    typedef typename target_host<Ttype>::type Ttype_H;
+    std::vector<int> dims(data.shape().begin(), data.shape().end());
+    while (dims.size() < 4) {
+        dims.insert(dims.begin(), 1);
+    }
+    saber::Shape tensor_shape(dims);
+    size_t count = tensor_shape.count();
+    size_t elem_size = data.dtype() == DT_FLOAT16 ? 2 : (data.dtype() == DT_INT8 ? 1 : 4);
+    if (count * elem_size != data.raw_bytes() || attachment.size() < data.raw_bytes()) {
+        LOG(ERROR) << "raw tensor of " << count << " elements, " << data.raw_bytes()
+                   << " bytes, attachment left " << attachment.size() << " bytes";
+        return Status::ANAKINFAIL("Raw tensor size mismatch");
+    }
+    butil::IOBuf piece;
+    attachment.cutn(&piece, data.raw_bytes());
+
+    if (data.dtype() == DT_FLOAT32) {
+        const char* bytes = piece.backing_block_num() == 1 ? piece.backing_block(0).data() : nullptr;
+        if (bytes != nullptr && reinterpret_cast<size_t>(bytes) % sizeof(float) == 0) {
+            // the tensor is built over the received block, no copy at all
+            Tensor4d<Ttype_H> received(const_cast<char*>(bytes), Ttype_H(), 0, tensor_shape);
+            tensor = received;
+            raw_holder.push_back(piece);
+        } else {
+            tensor.re_alloc(tensor_shape);
+            piece.copy_to(tensor.mutable_data(), data.raw_bytes());
+        }
+        return Status::OK();
+    }
+
+    // fp16/int8 payloads only save bandwidth, the nets take fp32 inputs
+    tensor.re_alloc(tensor_shape);
+    float* out = static_cast<float*>(tensor.mutable_data());
+    std::vector<char> buf(data.raw_bytes());
+    piece.copy_to(buf.data(), buf.size());
+    if (data.dtype() == DT_FLOAT16) {
+        const uint16_t* in = reinterpret_cast<const uint16_t*>(buf.data());
+        for (size_t i = 0; i < count; i++) {
+            out[i] = half_to_float(in[i]);
+        }
+    } else {
+        const int8_t* in = reinterpret_cast<const int8_t*>(buf.data());
+        float scale = data.scale() == 0.f ? 1.f : data.scale();
+        for (size_t i = 0; i < count; i++) {
+            out[i] = in[i] * scale;
+        }
+    }
+    return Status::OK();
+}
+
 template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
-inline void AnakinService<Ttype, Ptype, RunP>::extract_request(
-    const RPCRequest* request,
-    std::vector<Tensor4d<typename target_host<Ttype>::type> >& inputs) {
+inline Status AnakinService<Ttype, Ptype, RunP>::extract_request(
+    brpc::Controller* cntl, const RPCRequest* request,
+    std::vector<Tensor4d<typename target_host<Ttype>::type> >& inputs,
+    std::vector<butil::IOBuf>& raw_holder) {
+    // shares the blocks of the request attachment, raw tensors are cut from it in order
+    butil::IOBuf attachment = cntl->request_attachment();
     for (int i = 0; i < request->inputs_size(); i++) {
-        LOG(INFO) << "Get " << i << "input";
+        DLOG(INFO) << "Get " << i << "input";
         auto& io = request->inputs(i);
         auto& data = io.tensor();
+        if (data.raw_bytes() > 0) {
+            Tensor4d<typename target_host<Ttype>::type> h_tensor;
+            Status ret = extract_raw_tensor(attachment, data, h_tensor, raw_holder);
+            if (!ret) {
+                return ret;
+            }
+            inputs.push_back(h_tensor);
+            continue;
+        }
         auto& shape = data.shape();
         saber::Shape tensor_shape({shape[0], shape[1], shape[2], shape[3]});
         Tensor4d<typename target_host<Ttype>::type> h_tensor;
@@ -69,23 +188,26 @@ inline void AnakinService<Ttype, Ptype, RunP>::extract_request(
         DLOG(INFO) << "h_data: " << h_data << "data_p: " << data.data().data();
 
         for (int j = 0; j < 10; j++) {
-            LOG(INFO) << "  \\__ request data[" << j << "]: " << data.data(j);
+            DLOG(INFO) << "  \\__ request data[" << j << "]: " << data.data(j);
         }
 
         memcpy(h_data, data.data().data(), shape[0]*shape[1]*shape[2]*shape[3]*h_tensor.get_dtype_size());
 
         for (int j = 0; j < 10; j++) {
-            LOG(WARNING) << "  \\__ copy to inputs data[" << j << "]: " << h_data[j];
+            DLOG(WARNING) << "  \\__ copy to inputs data[" << j << "]: " << h_data[j];
         }
 
         inputs.push_back(h_tensor);
     }
+    return Status::OK();
 }
 
 template<typename Ttype, Precision Ptype, ServiceRunPattern RunP>
 inline void AnakinService<Ttype, Ptype, RunP>::fill_response_data(
+    brpc::Controller* cntl,
     int request_id,
     std::string model_name,
+    bool raw_outputs,
     RPCResponse* response,
     std::vector<Tensor4d<typename target_host<Ttype>::type> >& outputs) {
     response->set_model(model_name);
@@ -93,13 +215,25 @@ inline void AnakinService<Ttype, Ptype, RunP>::fill_response_data(
     int count = 0;
 
     for (auto& h_out : outputs) {
-        LOG(INFO) << "Get " << count << " output";
+        DLOG(INFO) << "Get " << count << " output";
         count++;
         // copy to host
         auto shape = h_out.valid_shape();
         // fill response
         IO* output = response->add_outputs();
         Data* data = output->mutable_tensor();
+
+        if (raw_outputs) {
+            for (auto dim : shape) {
+                data->add_shape(dim);
+            }
+            size_t bytes = h_out.valid_size() * h_out.get_dtype_size();
+            data->set_dtype(DT_FLOAT32);
+            data->set_raw_bytes(bytes);
+            cntl->response_attachment().append(h_out.data(), bytes);
+            continue;
+        }
+
         data->add_shape(shape[0]);
         data->add_shape(shape[1]);
         data->add_shape(shape[2]);
@@ -110,7 +244,7 @@ inline void AnakinService<Ttype, Ptype, RunP>::fill_response_data(
             data->add_data(((float*)(h_out.mutable_data()))[j]);
         }
 
-        LOG(INFO) << " output size: " << data->data_size();
+        DLOG(INFO) << " output size: " << data->data_size();
     }
 }
 
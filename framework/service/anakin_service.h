@@ -17,6 +17,8 @@
 #define ANAKIN_SERVICE_H 
 
 #include <brpc/server.h>
+#include <chrono>
+#include <memory>
 
 #include "framework/service/monitor.h"
 #include "framework/core/net/worker.h"
@@ -43,6 +45,12 @@ public:
 
     void launch();
 
+    /**
+     *  \brief share of the process cpu budget of a model, see CpuScheduler.
+     *  models default to weight 1, priority 0 and no thread cap.
+     */
+    void set_model_share(std::string model_name, float weight, int priority = 0, int max_threads = 0);
+
     void Reshape(std::string model_name, std::string in_name, std::vector<int> in_shape);
 
     void register_inputs(std::string model_name, std::vector<std::string> in_names);
@@ -62,13 +70,27 @@ public:
     }
 
 private:
-    void extract_request(const RPCRequest* request, 
-                         std::vector<Tensor4d<typename target_host<Ttype>::type> >& inputs);
-    void fill_response_data(int request_id, std::string model_name, 
-                            RPCResponse* response, 
+    /**
+     *  \brief get the input tensors of a request.
+     *  raw tensors are cut from the attachment, fp32 ones are used in place when the bytes are
+     *  contiguous and aligned (raw_holder keeps them alive), fp16/int8 ones are converted to fp32.
+     */
+    Status extract_request(brpc::Controller* cntl, const RPCRequest* request,
+                           std::vector<Tensor4d<typename target_host<Ttype>::type> >& inputs,
+                           std::vector<butil::IOBuf>& raw_holder);
+    Status extract_raw_tensor(butil::IOBuf& attachment, const Data& data,
+                              Tensor4d<typename target_host<Ttype>::type>& tensor,
+                              std::vector<butil::IOBuf>& raw_holder);
+    void fill_response_data(brpc::Controller* cntl, int request_id, std::string model_name, 
+                            bool raw_outputs, RPCResponse* response, 
                             std::vector<Tensor4d<typename target_host<Ttype>::type> >& outputs);
     void fill_response_exec_info(RPCResponse* response);
 
+    /// request/response (de)serialization time of a model, in microseconds.
+    LatencyHistogram& serialize_histogram(const std::string& model_name) {
+        return *_serialize_us[model_name];
+    }
+
 private:
     void _evaluate(::google::protobuf::RpcController* controller_base, 
                           const RPCRequest* request, 
@@ -79,19 +101,36 @@ private:
         brpc::ClosureGuard done_guard(done);
         brpc::Controller* cntl = static_cast<brpc::Controller*>(controller_base);
         // receive remote call from client.
-        LOG(INFO) << "Received request[log_id=" << cntl->log_id() << "] from " << cntl->remote_side();
+        DLOG(INFO) << "Received request[log_id=" << cntl->log_id() << "] from " << cntl->remote_side();
         if (!cntl->request_attachment().empty()) { 
-            LOG(INFO) << " |-- (attached=" << cntl->request_attachment() << ")"; 
+            DLOG(INFO) << " |-- (attached=" << cntl->request_attachment().size() << " bytes)"; 
         }
         std::string model_name = request->model();
         int request_id = request->request_id();
-        LOG(INFO) <<" |-- Get model: "<<model_name << " id: " << request_id; 
+        DLOG(INFO) <<" |-- Get model: "<<model_name << " id: " << request_id; 
         std::vector<Tensor4d<typename target_host<Ttype>::type> > inputs;
-        extract_request(request, inputs);
-        auto ret = _worker_map[model_name]->sync_prediction(inputs);
+        std::vector<butil::IOBuf> raw_holder;
+        auto serialize_start = std::chrono::steady_clock::now();
+        Status status = extract_request(cntl, request, inputs, raw_holder);
+        if (!status) {
+            cntl->SetFailed(brpc::EREQUEST, "%s", status.info());
+            return;
+        }
+        uint64_t serialize_us = elapsed_us(serialize_start);
+        TaskOptions options(request->priority());
+        if (request->timeout_ms() > 0) {
+            options.deadline = serialize_start + std::chrono::milliseconds(request->timeout_ms());
+        }
+        auto ret = _worker_map[model_name]->sync_prediction(inputs, options);
         auto results = ret.get();
-        LOG(ERROR) << "do infer over! thread id: " << std::this_thread::get_id();
-        fill_response_data(request_id, model_name, response, results);
+        if (results.empty()) {
+            cntl->SetFailed(brpc::ERPCTIMEDOUT, "Deadline exceeded before prediction");
+            return;
+        }
+        DLOG(INFO) << "do infer over! thread id: " << std::this_thread::get_id();
+        serialize_start = std::chrono::steady_clock::now();
+        fill_response_data(cntl, request_id, model_name, request->raw_outputs(), response, results);
+        serialize_histogram(model_name).record(serialize_us + elapsed_us(serialize_start));
         fill_response_exec_info(response);
     }
 
@@ -100,15 +139,54 @@ private:
                           RPCResponse* response, 
                           ::google::protobuf::Closure* done,
                           ServiceRunPatternToType<ServiceRunPattern::ASYNC>) {
-        // make sure that done will be invoked
+        // done is invoked here on error, otherwise by the worker thread once the response is filled
         brpc::ClosureGuard done_guard(done);
         brpc::Controller* cntl = static_cast<brpc::Controller*>(controller_base);
+        auto start = std::chrono::steady_clock::now();
+        std::string model_name = request->model();
+        int request_id = request->request_id();
+        auto worker_it = _worker_map.find(model_name);
+        if (worker_it == _worker_map.end()) {
+            cntl->SetFailed(brpc::EREQUEST, "Unknown model %s", model_name.c_str());
+            return;
+        }
+        std::vector<Tensor4d<typename target_host<Ttype>::type> > inputs;
+        auto raw_holder = std::make_shared<std::vector<butil::IOBuf> >();
+        Status status = extract_request(cntl, request, inputs, *raw_holder);
+        if (!status) {
+            cntl->SetFailed(brpc::EREQUEST, "%s", status.info());
+            return;
+        }
+        uint64_t serialize_us = elapsed_us(start);
+        LatencyHistogram* serialize = &serialize_histogram(model_name);
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        if (request->timeout_ms() > 0) {
+            deadline = start + std::chrono::milliseconds(request->timeout_ms());
+        }
+        bool raw_outputs = request->raw_outputs();
+        // request, response and cntl stay alive until done runs, raw_holder keeps the raw inputs
+        auto on_done = [this, cntl, response, done, raw_holder, request_id, model_name, raw_outputs,
+                        serialize, serialize_us](
+                Status status, std::vector<Tensor4d<typename target_host<Ttype>::type> >& outputs) {
+            brpc::ClosureGuard worker_done_guard(done);
+            if (!status) {
+                cntl->SetFailed(brpc::ERPCTIMEDOUT, "%s", status.info());
+                return;
+            }
+            auto fill_start = std::chrono::steady_clock::now();
+            fill_response_data(cntl, request_id, model_name, raw_outputs, response, outputs);
+            fill_response_exec_info(response);
+            serialize->record(serialize_us + elapsed_us(fill_start));
+        };
+        worker_it->second->callback_prediction(inputs, on_done, deadline, request->priority());
+        done_guard.release();
     }
 
 
 
 private:
     std::unordered_map<std::string, std::shared_ptr<Worker<Ttype, Ptype, OpRunType::ASYNC> > > _worker_map;
+    std::unordered_map<std::string, LatencyHistogram*> _serialize_us;
     Monitor<Ttype> _monitor;
     int _dev_id;
 };
@@ -17,62 +17,83 @@
 #define ANAKIN_MONITOR_H 
 
 #include "framework/service/device_info.h"
+#include "framework/core/metrics.h"
+#include <condition_variable>
 
 namespace anakin {
 
 namespace rpc {
 
-/// monitor thread pool
+/**
+ * \brief device monitor: a thread inquires the device info every interval and sleeps in between.
+ *  The values are also published as gauges of GlobalMetrics.
+ */
 template<typename Ttype>
 class Monitor {
 public:
     Monitor(){}
-    ~Monitor(){}
+    ~Monitor() {
+        {
+            std::lock_guard<std::mutex> guard(_mut);
+            _stop = true;
+        }
+        _cv.notify_all();
+        if (_monitor_thread) {
+            _monitor_thread->join();
+            delete _monitor_thread;
+        }
+    }
 
     template<Info ...infos>
     void create_instance(int dev_id, int interval_time_in_sec) {
         _id = dev_id;
         _monitor_thread = new std::thread([this](int dev_id, int time) {
             DevInfo<infos...> dev_info_pack;
-            std::chrono::time_point<sys_clock> start = sys_clock::now(); 
-            for(;;) {
-                double elapsed_time_ms =\
-                        std::chrono::duration_cast<std::chrono::milliseconds>(sys_clock::now()-start).count();
-                if(elapsed_time_ms  > time * 1000) {
-                    dev_info_pack.template inquiry<Ttype>(dev_id);
-                    _name = dev_info_pack.template get<DEV_NAME>();
-                    _temp = dev_info_pack.template get<DEV_TMP>();
-                    _mem_free = dev_info_pack.template get<DEV_MEM_FREE>();
-                    _mem_used = dev_info_pack.template get<DEV_MEM_USED>();
-                    LOG(INFO) << "Device ("<<dev_id << ")";
-                    LOG(INFO) << "|-- Temp  : \t"<<_temp;
-                    LOG(INFO) << "|-- Free  : \t"<<_mem_free;
-                    LOG(INFO) << "`-- Used  : \t"<<_mem_used;
-
-                    start = sys_clock::now();
-                }
+            std::string device = std::to_string(dev_id);
+            auto& metrics = GlobalMetrics::Global();
+            Gauge& temp = metrics.gauge(metric_name("anakin_device_temp", "device", device));
+            Gauge& mem_free = metrics.gauge(metric_name("anakin_device_mem_free", "device", device));
+            Gauge& mem_used = metrics.gauge(metric_name("anakin_device_mem_used", "device", device));
+            std::unique_lock<std::mutex> lock(_mut);
+            while (!_stop) {
+                lock.unlock();
+                dev_info_pack.template inquiry<Ttype>(dev_id);
+                lock.lock();
+                _name = dev_info_pack.template get<DEV_NAME>();
+                _temp = dev_info_pack.template get<DEV_TMP>();
+                _mem_free = dev_info_pack.template get<DEV_MEM_FREE>();
+                _mem_used = dev_info_pack.template get<DEV_MEM_USED>();
+                temp.set(_temp);
+                mem_free.set(_mem_free);
+                mem_used.set(_mem_used);
+                DLOG(INFO) << "Device (" << dev_id << ") temp: " << _temp
+                           << " free: " << _mem_free << " used: " << _mem_used;
+                // sleep until the next inquiry (or until destruction) instead of spinning on the clock
+                _cv.wait_for(lock, std::chrono::seconds(time), [this]() { return _stop; });
             }
         }, dev_id, interval_time_in_sec);
     }
 
     int get_id() { return _id; } 
 
-    std::string get_name() { return _name; }
+    std::string get_name() { std::lock_guard<std::mutex> guard(_mut); return _name; }
 
-    float get_temp() { return _temp; }
+    float get_temp() { std::lock_guard<std::mutex> guard(_mut); return _temp; }
 
-    float get_mem_free() { return _mem_free; }
+    float get_mem_free() { std::lock_guard<std::mutex> guard(_mut); return _mem_free; }
 
-    float get_mem_used() { return _mem_used; }
+    float get_mem_used() { std::lock_guard<std::mutex> guard(_mut); return _mem_used; }
 
 private:
-    typedef std::chrono::system_clock sys_clock;
     int _id{-1};   // device id (represent as device num id)
     std::string _name{"unknown"};     // device name
     float _temp{-1000};     // device temperature Celsius degree
     float _mem_free{-1}; // device memory free bytes
     float _mem_used{-1};
-    std::thread* _monitor_thread;
+    std::thread* _monitor_thread{nullptr};
+    std::mutex _mut;
+    std::condition_variable _cv;
+    bool _stop{false};
 }; 
 
 } /* namespace rpc */
@@ -21,6 +21,12 @@ namespace anakin{
 
 namespace saber{
 
+/// buffer allocations made by the calling thread, read by the allocation audit of Net.
+inline size_t& thread_buffer_allocs() {
+    static thread_local size_t count = 0;
+    return count;
+}
+
 template <typename TargetType>
 class Buffer {
 public:
@@ -132,6 +138,7 @@ public:
                     "buffer is not declared in current device, could not re_alloc buffer";
                 clean();
                 API::mem_alloc(&_data, size);
+                thread_buffer_allocs()++;
                 _capacity = size;
             } else {
                 return SaberOutOfAuthority;
@@ -147,6 +154,7 @@ public:
     SaberStatus alloc(size_t size){
         clean();
         API::mem_alloc(&_data, size);
+        thread_buffer_allocs()++;
         _capacity = size;
         _own_data = true;
         _count = size;
@@ -33,6 +33,12 @@ public:
         return *_g_env;
     }
     static void env_init(int max_stream = 4) {
+        init_devices(max_stream);
+    }
+    static void env_exit() {};
+private:
+    Env() {}
+    static void init_devices(int max_stream) {
         Devs& devs = cur_env();
         if (devs.size() > 0) {
             return;
@@ -53,11 +59,14 @@ public:
         devs[cur_id].create_stream();
         LOG(INFO) << "dev size = " << devs.size() << ", current device id: " << cur_id;
     }
-    static void env_exit() {};
-private:
-    Env() {}
 };
 
+#ifdef USE_X86_PLACE
+/// besides the devices, picks the isa kernel table for the running cpu
+template<>
+void Env<X86>::env_init(int max_stream);
+#endif  // USE_X86_PLACE
+
 #ifdef USE_MLU
 template<>
 void Env<MLU>::env_init(int max_stream);
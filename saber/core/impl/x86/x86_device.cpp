@@ -1,4 +1,8 @@
 #include "core/device.h"
+#include "core/env.h"
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+#endif
 namespace anakin{
 
 namespace saber{
@@ -30,6 +34,14 @@ void Device<X86>::get_info() {
 template void Device<X86>::get_info();
 template void Device<X86>::create_stream();
 
+#ifdef USE_X86_PLACE
+template <>
+void Env<X86>::env_init(int max_stream) {
+    init_devices(max_stream);
+    x86_isa_dispatch_init();
+}
+#endif
+
 } //namespace saber
 
 } //namespace anakin
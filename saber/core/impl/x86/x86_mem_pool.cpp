@@ -0,0 +1,359 @@
+#include "saber/core/impl/x86/x86_mem_pool.h"
+#include "saber/core/common.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#if defined(__linux__) && !defined(USE_SGX)
+#include <sys/mman.h>
+#define ANAKIN_X86_MMAP
+#endif
+
+namespace anakin {
+namespace saber {
+
+namespace {
+
+const size_t kAlign = 64;
+const size_t kPage = 4096;
+const size_t kHugePage = 2UL << 20;
+/// blocks above this size are not pooled, they are freed as soon as released.
+const size_t kMaxPooled = 1UL << 30;
+const int kClassNum = (30 - 6) * 4 + 5;
+/// only small blocks are worth a per-thread cache, big ones are rare and go to the shared pool.
+const size_t kThreadCacheMaxBlock = 256UL << 10;
+const size_t kThreadCacheBytes = 4UL << 20;
+const size_t kThreadCacheDepth = 8;
+
+enum BlockKind {
+    BLOCK_MALLOC = 0,
+    BLOCK_THP,      ///< mmap, advised to transparent hugepages
+    BLOCK_HUGETLB   ///< mmap, MAP_HUGETLB
+};
+
+/// lives in the kAlign bytes just in front of the pointer handed out.
+struct BlockHeader {
+    void* raw;
+    size_t block;     ///< usable bytes
+    size_t mapped;    ///< bytes obtained from the system
+    int size_class;   ///< -1 if not pooled
+    int kind;
+};
+static_assert(sizeof(BlockHeader) <= kAlign, "block header must fit in the alignment gap");
+
+inline BlockHeader* header_of(void* ptr) {
+    return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - kAlign);
+}
+
+inline size_t round_up(size_t n, size_t align) {
+    return (n + align - 1) / align * align;
+}
+
+/**
+ * four classes per power of two: a request in (2^k, 2^(k+1)] is rounded to a multiple of 2^(k-2),
+ * so at most 25% of a block is wasted.
+ */
+int size_class(size_t n, size_t* block) {
+    if (n <= kAlign) {
+        *block = kAlign;
+        return 0;
+    }
+
+    if (n > kMaxPooled) {
+        *block = round_up(n, kAlign);
+        return -1;
+    }
+
+    int lg = 63 - __builtin_clzl(n - 1);
+    size_t step = (size_t)1 << (lg - 2);
+    *block = round_up(n, step);
+    return (lg - 6) * 4 + (int)(*block >> (lg - 2)) - 4;
+}
+
+} // namespace
+
+struct X86MemPool::Impl {
+    std::mutex mut;
+    std::vector<void*> bins[kClassNum];
+    std::atomic<size_t> alloc_count{0};
+    std::atomic<size_t> pool_hits{0};
+    std::atomic<size_t> bytes_in_use{0};
+    std::atomic<size_t> peak_bytes_in_use{0};
+    std::atomic<size_t> bytes_cached{0};
+    std::atomic<size_t> bytes_reserved{0};
+    std::atomic<size_t> hugepage_bytes{0};
+
+    void* system_alloc(size_t block, int cls, HugePageMode mode);
+    void system_free(void* ptr);
+    void take(void* ptr);
+};
+
+void* X86MemPool::Impl::system_alloc(size_t block, int cls, HugePageMode mode) {
+    size_t mapped = block + kAlign;
+    size_t reserved = mapped;
+    void* raw = nullptr;
+    char* ptr = nullptr;
+    int kind = BLOCK_MALLOC;
+#ifdef ANAKIN_X86_MMAP
+
+    if (block >= kHugePage && mode != HUGEPAGE_NONE) {
+        // reserve address space, the block itself starts on a 2MB boundary and the header
+        // gets the 4KB page in front of it, so no hugepage is spent on the header
+        size_t huge = round_up(block, kHugePage);
+        mapped = huge + 2 * kHugePage;
+        raw = mmap(nullptr, mapped, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if (raw != MAP_FAILED) {
+            ptr = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(raw) + kPage, kHugePage));
+            kind = BLOCK_THP;
+
+            if (mode == HUGEPAGE_EXPLICIT) {
+                if (mmap(ptr, huge, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0) != MAP_FAILED) {
+                    kind = BLOCK_HUGETLB;
+                } else {
+                    // no hugepage reserved: a failed MAP_FIXED may drop the range, map it back
+                    mmap(ptr, huge, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE,
+                         -1, 0);
+                }
+            }
+
+            size_t rw_size = kind == BLOCK_HUGETLB ? kPage : huge + kPage;
+
+            if (mprotect(ptr - kPage, rw_size, PROT_READ | PROT_WRITE) != 0) {
+                munmap(raw, mapped);
+                ptr = nullptr;
+            } else {
+                if (kind == BLOCK_THP) {
+                    madvise(ptr, huge, MADV_HUGEPAGE);
+                }
+
+                reserved = huge + kPage;
+                hugepage_bytes += huge;
+            }
+        }
+    }
+
+#endif
+
+    if (ptr == nullptr) {
+        kind = BLOCK_MALLOC;
+        mapped = block + kAlign;
+        reserved = mapped;
+
+        if (posix_memalign(&raw, kAlign, mapped) != 0) {
+            return nullptr;
+        }
+
+        ptr = static_cast<char*>(raw) + kAlign;
+    }
+
+    BlockHeader* head = header_of(ptr);
+    head->raw = raw;
+    head->block = block;
+    head->mapped = mapped;
+    head->size_class = cls;
+    head->kind = kind;
+    bytes_reserved += reserved;
+    return ptr;
+}
+
+void X86MemPool::Impl::system_free(void* ptr) {
+    BlockHeader* head = header_of(ptr);
+
+    if (head->kind == BLOCK_MALLOC) {
+        bytes_reserved -= head->mapped;
+        ::free(head->raw);
+        return;
+    }
+
+#ifdef ANAKIN_X86_MMAP
+    size_t huge = round_up(head->block, kHugePage);
+    bytes_reserved -= huge + kPage;
+    hugepage_bytes -= huge;
+    munmap(head->raw, head->mapped);
+#endif
+}
+
+void X86MemPool::Impl::take(void* ptr) {
+    size_t used = bytes_in_use += header_of(ptr)->block;
+    size_t peak = peak_bytes_in_use;
+
+    while (used > peak && !peak_bytes_in_use.compare_exchange_weak(peak, used)) {}
+}
+
+/// set once the thread cache is destroyed, blocks released later (static tensors) skip it.
+static thread_local bool t_cache_dead = false;
+
+/// per-thread free lists of small blocks, flushed to the shared pool when the thread exits.
+struct X86MemPoolThreadCache {
+    std::vector<void*> bins[kClassNum];
+    size_t bytes{0};
+
+    ~X86MemPoolThreadCache() {
+        X86MemPool& pool = X86MemPool::global();
+        std::lock_guard<std::mutex> guard(pool._impl->mut);
+
+        for (int i = 0; i < kClassNum; ++i) {
+            pool._impl->bins[i].insert(pool._impl->bins[i].end(), bins[i].begin(), bins[i].end());
+            bins[i].clear();
+        }
+
+        t_cache_dead = true;
+    }
+};
+
+static X86MemPoolThreadCache* thread_cache() {
+    if (t_cache_dead) {
+        return nullptr;
+    }
+
+    static thread_local X86MemPoolThreadCache cache;
+    return &cache;
+}
+
+std::string MemPoolStats::to_string() const {
+    std::ostringstream os;
+    os << "alloc: " << alloc_count << " hit: " << pool_hits
+       << " in_use: " << bytes_in_use << " peak: " << peak_bytes_in_use
+       << " cached: " << bytes_cached << " reserved: " << bytes_reserved
+       << " hugepage: " << hugepage_bytes;
+    return os.str();
+}
+
+X86MemPool::X86MemPool() : _impl(new Impl), _hugepage_mode(HUGEPAGE_TRANSPARENT),
+    _cache_limit(4UL << 30), _enabled(true) {
+    const char* mode = std::getenv("ANAKIN_X86_HUGEPAGE");
+
+    if (mode != nullptr) {
+        std::string m(mode);
+        _hugepage_mode = m == "none" ? HUGEPAGE_NONE :
+                         (m == "explicit" ? HUGEPAGE_EXPLICIT : HUGEPAGE_TRANSPARENT);
+    }
+
+    const char* enable = std::getenv("ANAKIN_X86_MEM_POOL");
+    _enabled = enable == nullptr || std::string(enable) != "0";
+}
+
+X86MemPool& X86MemPool::global() {
+    // never destroyed: thread caches and static tensors release blocks during exit
+    static X86MemPool* pool = new X86MemPool();
+    return *pool;
+}
+
+void* X86MemPool::alloc(size_t size) {
+    size_t block = 0;
+    int cls = _enabled ? size_class(size, &block) : -1;
+
+    if (cls < 0) {
+        block = round_up(std::max(size, kAlign), kAlign);
+    }
+
+    _impl->alloc_count++;
+    void* ptr = nullptr;
+
+    if (cls >= 0) {
+        X86MemPoolThreadCache* local = thread_cache();
+
+        if (local != nullptr && !local->bins[cls].empty()) {
+            ptr = local->bins[cls].back();
+            local->bins[cls].pop_back();
+            local->bytes -= block;
+        } else {
+            std::lock_guard<std::mutex> guard(_impl->mut);
+            auto& shared = _impl->bins[cls];
+
+            if (!shared.empty()) {
+                ptr = shared.back();
+                shared.pop_back();
+            }
+        }
+
+        if (ptr != nullptr) {
+            _impl->pool_hits++;
+            _impl->bytes_cached -= block;
+        }
+    }
+
+    if (ptr == nullptr) {
+        ptr = _impl->system_alloc(block, cls, _hugepage_mode);
+
+        if (ptr == nullptr) {
+            LOG(ERROR) << "x86 mem pool out of memory, request " << size << " bytes, "
+                       << stats().to_string();
+            return nullptr;
+        }
+    }
+
+    _impl->take(ptr);
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void X86MemPool::free(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    BlockHeader* head = header_of(ptr);
+    int cls = head->size_class;
+    size_t block = head->block;
+    _impl->bytes_in_use -= block;
+
+    if (cls < 0) {
+        _impl->system_free(ptr);
+        return;
+    }
+
+    X86MemPoolThreadCache* local = thread_cache();
+
+    if (local != nullptr && block <= kThreadCacheMaxBlock
+            && local->bins[cls].size() < kThreadCacheDepth
+            && local->bytes + block <= kThreadCacheBytes) {
+        local->bins[cls].push_back(ptr);
+        local->bytes += block;
+        _impl->bytes_cached += block;
+        return;
+    }
+
+    if (_impl->bytes_cached + block > _cache_limit) {
+        _impl->system_free(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(_impl->mut);
+    _impl->bins[cls].push_back(ptr);
+    _impl->bytes_cached += block;
+}
+
+void X86MemPool::release_cached() {
+    std::lock_guard<std::mutex> guard(_impl->mut);
+
+    for (int i = 0; i < kClassNum; ++i) {
+        for (void* ptr : _impl->bins[i]) {
+            _impl->bytes_cached -= header_of(ptr)->block;
+            _impl->system_free(ptr);
+        }
+
+        _impl->bins[i].clear();
+    }
+}
+
+MemPoolStats X86MemPool::stats() {
+    MemPoolStats s;
+    s.alloc_count = _impl->alloc_count;
+    s.pool_hits = _impl->pool_hits;
+    s.bytes_in_use = _impl->bytes_in_use;
+    s.peak_bytes_in_use = _impl->peak_bytes_in_use;
+    s.bytes_cached = _impl->bytes_cached;
+    s.bytes_reserved = _impl->bytes_reserved;
+    s.hugepage_bytes = _impl->hugepage_bytes;
+    return s;
+}
+
+} //namespace saber
+} //namespace anakin
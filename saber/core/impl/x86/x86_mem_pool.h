@@ -0,0 +1,89 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_CORE_IMPL_X86_X86_MEM_POOL_H
+#define ANAKIN_SABER_CORE_IMPL_X86_X86_MEM_POOL_H
+
+#include <cstddef>
+#include <string>
+
+namespace anakin {
+namespace saber {
+
+enum HugePageMode {
+    HUGEPAGE_NONE = 0,      ///< plain 64 bytes aligned blocks
+    HUGEPAGE_TRANSPARENT,   ///< 2MB aligned blocks advised to THP (default)
+    HUGEPAGE_EXPLICIT       ///< MAP_HUGETLB, falls back to THP when no hugepage is reserved
+};
+
+struct MemPoolStats {
+    size_t alloc_count{0};      ///< mem_alloc calls
+    size_t pool_hits{0};        ///< allocations served from a cached block
+    size_t bytes_in_use{0};     ///< bytes of blocks handed out
+    size_t peak_bytes_in_use{0};
+    size_t bytes_cached{0};     ///< bytes of free blocks kept in the pool
+    size_t bytes_reserved{0};   ///< bytes currently obtained from the system
+    size_t hugepage_bytes{0};   ///< part of bytes_reserved backed by hugepages
+
+    std::string to_string() const;
+};
+
+/**
+ * \brief size-class pooling allocator behind TargetWrapper<X86>::mem_alloc/mem_free.
+ * Blocks are 64 bytes aligned; requests are rounded to one of four classes per power of
+ * two, blocks of 2MB and more are hugepage backed. Freed blocks go to a per-thread cache
+ * first and to the shared pool after, so re_alloc/reshape churn does not reach malloc.
+ * Memory is zeroed on allocation like fast_malloc.
+ * The hugepage mode may also be set by env ANAKIN_X86_HUGEPAGE=none|thp|explicit,
+ * and pooling disabled by ANAKIN_X86_MEM_POOL=0.
+ */
+class X86MemPool {
+public:
+    static X86MemPool& global();
+
+    void* alloc(size_t size);
+
+    void free(void* ptr);
+
+    void set_hugepage_mode(HugePageMode mode) { _hugepage_mode = mode; }
+
+    HugePageMode hugepage_mode() const { return _hugepage_mode; }
+
+    /// free blocks above limit bytes are returned to the system instead of cached.
+    void set_cache_limit(size_t limit) { _cache_limit = limit; }
+
+    /// return every cached block of the shared pool to the system.
+    void release_cached();
+
+    MemPoolStats stats();
+
+private:
+    X86MemPool();
+    X86MemPool(const X86MemPool&);
+    X86MemPool& operator=(const X86MemPool&);
+
+    struct Impl;
+    Impl* _impl;
+    HugePageMode _hugepage_mode;
+    size_t _cache_limit;
+    bool _enabled;
+
+    friend struct X86MemPoolThreadCache;
+};
+
+} //namespace saber
+} //namespace anakin
+
+#endif //ANAKIN_SABER_CORE_IMPL_X86_X86_MEM_POOL_H
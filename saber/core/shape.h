@@ -46,38 +46,41 @@ public:
                     << _layout->inner_c();
         }
     }
+    // _layout points to a shared immutable layout object, see create_layout
     ~Shape() {
-        delete _layout;
         _layout = nullptr;
     }
 
     Shape(const Shape& right)
-        : std::vector<int>(right) {
-        this->clear();
+        : std::vector<int>(right), _layout(right._layout) {}
 
-        for (int i = 0; i < right.size(); ++i) {
-            this->push_back(right[i]);
+    Shape(Shape&& right)
+        : std::vector<int>(std::move(right)), _layout(right._layout) {}
+
+    Shape& operator=(const Shape& right) {
+        if (this == &right) {
+            return *this;
         }
 
-        create_layout(right.get_layout());
+        // assignment in place reuses the capacity, it doesn't allocate once the dims are known
+        this->assign(right.begin(), right.end());
+        _layout = right._layout;
+        return *this;
     }
 
-    Shape& operator=(const Shape& right) {
-        this->clear();
-
-        for (int i = 0; i < right.size(); ++i) {
-            this->push_back(right[i]);
+    Shape& operator=(Shape&& right) {
+        if (this == &right) {
+            return *this;
         }
 
-        delete _layout;
-        _layout = nullptr;
-        create_layout(right.get_layout());
+        vector::operator=(std::move(right));
+        _layout = right._layout;
         return *this;
     }
-    Shape operator+(const Shape& shape) {
+    Shape operator+(const Shape& shape) const {
 
         Shape tmp_shape(*this);
-        int* p = data();
+        const int* p = data();
 
         for (size_t i = 0; i < size(); i++) {
             tmp_shape[i] = p[i] + shape[i];
@@ -86,10 +89,10 @@ public:
         return tmp_shape;
     }
 
-    Shape operator-(const Shape& shape) {
+    Shape operator-(const Shape& shape) const {
 
         Shape tmp_shape(*this);
-        int* p = data();
+        const int* p = data();
 
         for (size_t i = 0; i < size(); i++) {
             tmp_shape[i] = p[i] - shape[i];
@@ -416,7 +419,6 @@ public:
 
     void set_layout(LayoutType layout_type, std::vector<int> new_shape = {}) {
         Shape sh = *this;
-        Layout* layout = this->_layout;
         create_layout(layout_type);
 
         if (sh._layout == nullptr || sh.empty()) {
@@ -463,8 +465,6 @@ public:
         if (_layout->depth_index() != -1) {
             this->data()[_layout->depth_index()] = sh.depth();
         }
-
-        delete layout;
     }
 
     static Shape zero(const Shape& right) {
@@ -498,7 +498,7 @@ public:
         return sh;
     }
 
-    int get_layout_aligned_length() {
+    int get_layout_aligned_length() const {
         return _layout->aligned_length();
     }
 #ifndef USE_SGX
@@ -516,11 +516,15 @@ public:
 protected:
     Layout* _layout{nullptr};
 private:
+    // layouts have no state, every shape of a layout type shares one object so building,
+    // copying and assigning shapes don't allocate a layout each time
+    template <typename LayoutT>
+    static Layout* shared_layout() {
+        static LayoutT layout;
+        return &layout;
+    }
+
     void create_layout(LayoutType layout_type) {
-//        if(this->_layout != nullptr){
-//            delete this->_layout;
-//            this->_layout = nullptr;
-//        }
 
         switch (layout_type) {
         case Layout_invalid:
@@ -530,59 +534,59 @@ private:
             break;
 
         case Layout_W:
-            this->_layout = new W();
+            this->_layout = shared_layout<W>();
             break;
 
         case Layout_HW:
-            this->_layout = new HW();
+            this->_layout = shared_layout<HW>();
             break;
 
         case Layout_WH:
-            this->_layout = new WH();
+            this->_layout = shared_layout<WH>();
             break;
 
         case Layout_NC:
-            this->_layout = new NC();
+            this->_layout = shared_layout<NC>();
             break;
 
         case Layout_NH:
-            this->_layout = new NH();
+            this->_layout = shared_layout<NH>();
             break;
 
         case Layout_NW:
-            this->_layout = new NW();
+            this->_layout = shared_layout<NW>();
             break;
 
         case Layout_NHW:
-            this->_layout = new NHW();
+            this->_layout = shared_layout<NHW>();
             break;
 
         case Layout_NCHW:
-            this->_layout = new NCHW();
+            this->_layout = shared_layout<NCHW>();
             break;
 
         case Layout_NHWC:
-            this->_layout = new NHWC();
+            this->_layout = shared_layout<NHWC>();
             break;
 
         case Layout_NCHW_C4:
-            this->_layout = new NCHW_C4();
+            this->_layout = shared_layout<NCHW_C4>();
             break;
 
         case Layout_NCHW_C8:
-            this->_layout = new NCHW_C8();
+            this->_layout = shared_layout<NCHW_C8>();
             break;
 
         case Layout_NCHW_C16:
-            this->_layout = new NCHW_C16();
+            this->_layout = shared_layout<NCHW_C16>();
             break;
 
         case Layout_NCHW_C8R:
-            this->_layout = new NCHW_C8R();
+            this->_layout = shared_layout<NCHW_C8R>();
             break;
 
         case Layout_NCHW_C16R:
-            this->_layout = new NCHW_C16R();
+            this->_layout = shared_layout<NCHW_C16R>();
             break;
         }
     }
@@ -23,6 +23,10 @@
 #include "saber/core/impl/amd/utils/amd_common.h"
 #endif
 
+#ifdef USE_X86_PLACE
+#include "saber/core/impl/x86/x86_mem_pool.h"
+#endif
+
 namespace anakin {
 namespace saber {
 
@@ -79,10 +83,17 @@ struct TargetWrapper<TargetType, __host_target> {
     }
 
     /**
-     * \brief wrapper of memory allocate function, with alignment of 16 bytes
+     * \brief wrapper of memory allocate function, with alignment of 64 bytes,
+     * X86 memory comes from the pooling allocator X86MemPool
      *
     */
     static void mem_alloc(void** ptr, size_t n) {
+#ifdef USE_X86_PLACE
+        if (std::is_same<TargetType, X86>::value) {
+            *ptr = X86MemPool::global().alloc(n);
+            return;
+        }
+#endif
         *ptr = (void*)fast_malloc(n);
 
     }
@@ -93,6 +104,12 @@ struct TargetWrapper<TargetType, __host_target> {
     */
     static void mem_free(void* ptr) {
         if (ptr != nullptr) {
+#ifdef USE_X86_PLACE
+            if (std::is_same<TargetType, X86>::value) {
+                X86MemPool::global().free(ptr);
+                return;
+            }
+#endif
             fast_free(ptr);
         }
     }
@@ -158,6 +158,7 @@ public:
         _dtype = type;
         _type_len = type_length(type);
         if (_buf->get_capacity() < _shape.count() * _type_len) {
+            _copy_before_write();
             if (_is_shared || _is_subbuf) {
                 LOG(FATAL) << "tensor is shared, memory can not be re-alloced";
                 return SaberOutOfAuthority;
@@ -316,6 +317,7 @@ public:
         //if (_is_subbuf || _is_shared) {
         //    return SaberOutOfAuthority;
         //}
+        _copy_before_write();
         CHECK_EQ(_is_shared || _is_subbuf, false) << "shared tensor could not re_alloc";
         if (type != AK_INVALID) {
             _dtype = type;
@@ -360,6 +362,9 @@ public:
             CHECK_EQ(_valid_shape + _offset <= _shape, true) << \
                 "valid_shape + offet should <= shape";
         }
+        if (_shape.count() * _type_len > _buf->get_capacity()) {
+            _copy_before_write();
+        }
         bool exceed_flag = _shape.count() * _type_len > _buf->get_capacity() \
             && (_is_subbuf || _is_shared);
         //if (exceed_flag) {
@@ -426,14 +431,14 @@ public:
     /**
      *  \brief Return tensor shape, entire memory buffer shape.
      */
-    Shape shape() const{
+    const Shape& shape() const{
         return _shape;
     }
 
     /**
      *  \brief Return valid shape of tensor
      */
-    Shape valid_shape() const {
+    const Shape& valid_shape() const {
         return _valid_shape;
     }
 
@@ -450,7 +455,7 @@ public:
     /**
      *  \brief Return tensor offset, which holds the offset in each dim.
      */
-    Shape offset() const {
+    const Shape& offset() const {
         return _offset;
     }
 
@@ -466,7 +471,7 @@ public:
      * \brief get sequence offset, lot tensor
      * @return
      */
-    std::vector<std::vector<int>> get_seq_offset() const {
+    const std::vector<std::vector<int>>& get_seq_offset() const {
         return _seq_offset;
     }
 
@@ -475,7 +480,7 @@ public:
      * @param seq_offset
      * @return
      */
-    SaberStatus set_seq_offset(std::vector<std::vector<int>> seq_offset) {
+    SaberStatus set_seq_offset(const std::vector<std::vector<int>>& seq_offset) {
         _seq_offset = seq_offset;
         return SaberSuccess;
     }
@@ -610,6 +615,7 @@ public:
         //sync();
         CHECK_EQ(device_id(), API::get_device_id()) << \
             "tensor is not declared in current device";
+        _copy_before_write();
         if (_buf->get_capacity() == 0){
             if (std::is_same<TargetType, MLU>::value) {
                 reshape(_valid_shape);
@@ -663,6 +669,65 @@ public:
         return SaberSuccess;
     }
 
+    /**
+     *  \brief Give a tensor that shares its buffer (share_from) a private copy of it,
+     *  later writes and re_alloc don't touch the tensors it was shared with.
+     */
+    SaberStatus unshare() {
+        if (!_is_shared) {
+            return SaberSuccess;
+        }
+        CHECK(!_is_subbuf && !_external) << "only a tensor sharing a whole buffer could unshare";
+        std::shared_ptr<Buffer<TargetType>> buf =
+            std::make_shared<Buffer<TargetType>>(_buf->get_capacity());
+        SABER_CHECK(buf->sync_copy_from(*_buf));
+        _buf = buf;
+        _is_shared = false;
+        return SaberSuccess;
+    }
+
+    /**
+     *  \brief While set, the first write (mutable_data, copy_from, re_alloc or a reshape
+     *  beyond the buffer) unshares the buffer before it, reads keep sharing it.
+     */
+    void set_copy_on_write(bool copy_on_write) {
+        _copy_on_write = copy_on_write;
+    }
+
+
+    /**
+     *  \brief Point the tensor at external memory of capacity bytes, the memory is not owned
+     *  and is never freed by the tensor. Pass nullptr to drop the external memory, the buffer
+     *  the tensor held before is restored, or a new one is allocated if keep_own was false.
+     */
+    SaberStatus set_external_data(BaseDtype ptr, size_t capacity, bool keep_own = true) {
+        if (ptr == nullptr) {
+            if (!_external) {
+                return SaberSuccess;
+            }
+            _external = false;
+            if (_detached_buf != nullptr) {
+                _buf = _detached_buf;
+                _is_shared = _detached_shared;
+                _detached_buf.reset();
+                return SaberSuccess;
+            }
+            _buf = std::make_shared<Buffer<TargetType>>();
+            _is_shared = false;
+            return _buf->re_alloc(_shape.count() * _type_len);
+        }
+
+        if (!_external) {
+            _detached_buf = keep_own ? _buf : nullptr;
+            _detached_shared = _is_shared;
+            _external = true;
+        }
+        _buf = std::make_shared<Buffer<TargetType>>(ptr, capacity, API::get_device_id());
+        _is_shared = true;
+        _is_subbuf = false;
+        _offset = Shape::zero(_shape);
+        return SaberSuccess;
+    }
 
     SaberStatus share_sub_buffer(const Tensor& tensor, Shape valid_shape, Shape offset) {
 
@@ -695,6 +760,7 @@ public:
         CHECK_EQ(tensor.get_dtype(), _dtype) << "data type should be the same";
         CHECK_EQ(valid_size(), tensor.valid_size()) \
             << "sizes of two valid shapes must be the same";
+        _copy_before_write();
 
         if (_buf->get_capacity() == 0) {
             reshape(_valid_shape);
@@ -871,6 +937,7 @@ public:
         CHECK_EQ(tensor.get_dtype(), _dtype) << "data type should be the same";
         CHECK_EQ(valid_size(), tensor.valid_size()) \
             << "sizes of two valid shapes must be the same";
+        _copy_before_write();
 
         if (_buf->get_capacity() == 0) {
             reshape(_valid_shape);
@@ -1087,6 +1154,19 @@ private:
     ///< share sub-buffer flag.
     bool _is_subbuf{false};
     bool _is_shared{false};
+    ///< buffer held before set_external_data, restored when the external memory is dropped.
+    std::shared_ptr<Buffer<TargetType>> _detached_buf{nullptr};
+    bool _detached_shared{false};
+    bool _external{false};
+    ///< see set_copy_on_write
+    bool _copy_on_write{false};
+
+    void _copy_before_write() {
+        if (_copy_on_write) {
+            _copy_on_write = false;
+            SABER_CHECK(unshare());
+        }
+    }
 
     //! lot tensor
     std::vector<std::vector<int>> _seq_offset;
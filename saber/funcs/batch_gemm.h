@@ -87,7 +87,7 @@ private:
 #endif
 
 #ifdef USE_X86_PLACE
-//#include "saber/funcs/impl/x86/vender_batch_gemm.h"
+#include "saber/funcs/impl/x86/saber_batch_gemm.h"
 #endif
 
 #endif
@@ -3,12 +3,9 @@
 #include "saber/funcs/impl/x86/saber_activation.h"
 #include "saber/funcs/impl/x86/saber_normal_activation.h"
 #include "mkl.h"
-#include "saber/funcs/impl/x86/saber_avx512_funcs.h"
 #include "saber/funcs/impl/x86/saber_avx2_funcs.h"
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
 #include "saber/funcs/debug.h"
-#if defined(__AVX2__) and defined(__FMA__)
-#include "saber/funcs/impl/x86/saber_avx2_funcs.h"
-#endif
 
 
 namespace anakin {
@@ -21,6 +18,7 @@ SaberStatus SaberActivation<X86, OpDtype>::init(
     ActivationParam<X86>& param,
     Context<X86>& ctx) {
     this->_ctx = &ctx;
+    x86_isa_record("Activation");
     return create(inputs, outputs, param, ctx);
 }
 
@@ -140,16 +138,7 @@ SaberStatus SaberActivation<X86, OpDtype>::dispatch(
             OpDataType* input_data = (OpDataType*)inputs[vc]->mutable_data();
             OpDataType* output_data = (OpDataType*)outputs[vc]->mutable_data();
             outputs[vc]->set_posstive_flag(true);
-#if defined(__AVX2__) and defined(__FMA__)
-            avx2_vector_relu(input_data, len, output_data);
-#else
-            #pragma omp parallel for schedule(static)
-
-            for (size_t i = 0; i < len; i++) {
-                output_data[i] = input_data[i] > (OpDataType)0 ? input_data[i] : (OpDataType)0;
-            }
-
-#endif
+            x86_isa_kernels().vector_relu(input_data, len, output_data);
         }
     }
 
@@ -175,17 +164,7 @@ SaberStatus SaberActivation<X86, OpDtype>::dispatch(
             const OpDataType* input_data = (OpDataType*)inputs[i]->data();
             outputs[i]->set_posstive_flag(true);
             OpDataType* output_data = (OpDataType*)outputs[i]->mutable_data();
-#if defined(__AVX512F__)
-            avx512_vector_sigmoid(input_data, len, output_data);
-#elif defined(__AVX2__) and defined(__FMA__)
-            avx2_vector_sigmoid(input_data, len, output_data);
-#else
-
-            for (size_t j = 0; j < len; j++) {
-                output_data[j] = 1.0f / (1.0f + exp(-input_data[j]));
-            }
-
-#endif
+            x86_isa_kernels().vector_sigmoid(input_data, len, output_data);
         }
     }
 
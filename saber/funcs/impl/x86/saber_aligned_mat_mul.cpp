@@ -1,4 +1,5 @@
 #include "saber/funcs/impl/x86/saber_aligned_mat_mul.h"
+#include "saber/funcs/impl/x86/saber_batch_gemm.h"
 #include "mkl.h"
 #if defined(__AVX2__) and defined(__FMA__)
 #include "saber/funcs/impl/x86/saber_avx2_funcs.h"
@@ -56,6 +57,14 @@ SaberStatus SaberAlignedMatMul<X86, OpDtype>::dispatch(
     int ldb = param.is_transpose_Y ? K : N;
     int ldc = N;
     int seq_num = seq_offset_0.size() - 1;
+
+    if (use_batch_small_gemm(M, N, K)) {
+        batch_small_gemm_strided(param.is_transpose_X, param.is_transpose_Y, M, N, K, _alpha,
+                                 src0, lda, batch_A * inner_A, src1, ldb, batch_B * inner_B,
+                                 _beta, dst, ldc, M * N, seq_num);
+        return SaberSuccess;
+    }
+
     for (int i = 0; i < seq_num; i++) {
         cblas_sgemm(CblasRowMajor, _trans_a, _trans_b, M, N, K_A, _alpha, src0 + i * batch_A * inner_A, lda, src1 + i * batch_B * inner_B, ldb, _beta, dst + i * M * N, ldc);
     }
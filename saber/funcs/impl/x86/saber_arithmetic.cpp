@@ -1,9 +1,7 @@
 
 #include "saber/funcs/impl/x86/saber_arithmetic.h"
 #include "mkl.h"
-#if defined(__AVX2__) and defined(__FMA__)
-#include "saber/funcs/impl/x86/saber_avx2_funcs.h"
-#endif
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
 #include <cmath>
 
 namespace anakin{
@@ -16,6 +14,7 @@ SaberStatus SaberArithmetic<X86, OpDtype>::init(
         ArithmeticParam<X86> &param,
         Context<X86> &ctx) {
     this->_ctx = &ctx;
+    x86_isa_record("Arithmetic");
     return create(inputs, outputs, param, ctx);
 }
 
@@ -54,14 +53,7 @@ SaberStatus SaberArithmetic<X86, OpDtype>::dispatch(
             auto input_1 = input_data_1 + seq_offset_1[i] * inner_size;
             auto out = output_data + seq_offset_0[i] * inner_size;
             int len = std::min(len_0, len_1);
-#if defined(__AVX2__) and defined(__FMA__)
-            avx2_vector_sum(input_0, input_1, len, out);
-#else
-#pragma omp parallel for schedule(static)
-            for (int j = 0; j < len; j++) {
-                out[j] = input_0[j] + input_1[j];
-            }
-#endif
+            x86_isa_kernels().vector_sum(input_0, input_1, len, out);
             if (len_0 > len) {
                 memcpy(out + len, input_0 + len, sizeof(OpDataType) * (len_0 -len));
             }
@@ -80,14 +72,7 @@ SaberStatus SaberArithmetic<X86, OpDtype>::dispatch(
             auto input_1 = input_data_1 + seq_offset_1[i] * inner_size;
             auto out = output_data + seq_offset_0[i] * inner_size;
             int len = std::min(len_0, len_1);
-#if defined(__AVX2__) and defined(__FMA__)
-            avx2_vector_sub(input_0, input_1, len, out);
-#else
-#pragma omp parallel for schedule(static)
-            for (int j = 0; j < len; j++) {
-                out[j] = input_0[j] - input_1[j];
-            }
-#endif
+            x86_isa_kernels().vector_sub(input_0, input_1, len, out);
             if (len_0 > len) {
                 memcpy(out + len, input_0 + len, sizeof(OpDataType) * (len_0 -len));
             }
@@ -104,14 +89,7 @@ SaberStatus SaberArithmetic<X86, OpDtype>::dispatch(
             auto input_1 = input_data_1 + seq_offset_1[i] * inner_size;
             auto out = output_data + seq_offset_0[i] * inner_size;
             int len = std::min(len_0, len_1);
-#if defined(__AVX2__) and defined(__FMA__)
-            avx2_vector_mul(input_0, input_1, len, out);
-#else
-#pragma omp parallel for schedule(static)
-            for (int j = 0; j < len; j++) {
-                out[j] = input_0[j] * input_1[j];
-            }
-#endif
+            x86_isa_kernels().vector_mul(input_0, input_1, len, out);
             if (len_0 > len) {
                 memcpy(out + len, input_0 + len, sizeof(OpDataType) * (len_0 -len));
             }
@@ -16,43 +16,6 @@ inline void avx2_save_mask(__m256& in, float* out, int length) {
     _mm256_maskstore_ps(out, vec_mask, in);
 }
 
-void avx2_vector_relu(const float* in, int length, float* out) {
-    int remainder = length % 8;
-    int round_length = length / 8 * 8;
-    __m256 zero = _mm256_setzero_ps();
-    #pragma omp parallel for schedule(static)
-
-    for (int i = 0; i < length; i += 8) {
-        __m256 temp = _mm256_loadu_ps(&in[i]);
-        _mm256_storeu_ps(&out[i], _mm256_max_ps(zero, temp));
-    }
-
-    if (remainder > 0) {
-        __m256i vec_mask = _m256_continue_mask_m256i(remainder);
-        __m256 temp = _mm256_maskload_ps(&in[round_length], vec_mask);
-        _mm256_maskstore_ps(&out[round_length], vec_mask, _mm256_max_ps(zero, temp));
-    }
-
-};
-
-void avx2_vector_sigmoid(const float* in, int length, float* out) {
-    int remainder = length % 8;
-    int round_length = length / 8 * 8;
-    #pragma omp parallel for schedule(static)
-
-    for (int i = 0; i < length; i += 8) {
-        __m256 temp = _mm256_loadu_ps(&in[i]);
-        _mm256_storeu_ps(&out[i], Sigmoid(temp));
-    }
-
-    if (remainder > 0) {
-        __m256i vec_mask = _m256_continue_mask_m256i(remainder);
-        __m256 temp = _mm256_maskload_ps(&in[round_length], vec_mask);
-        _mm256_maskstore_ps(&out[round_length], vec_mask, Sigmoid(temp));
-    }
-
-};
-
 void avx2_vector_soft_sign(const float* in, int length, float* out) {
     int remainder = length % 8;
     int round_length = length / 8 * 8;
@@ -406,70 +369,6 @@ void avx2_vector_sum(const float* in_0,
     }
 }
 
-void avx2_vector_sum(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out) {
-    int round_dim = len / 8 * 8;
-    int remainder = len % 8;
-    __m256i mask_m256i = _m256_continue_mask_m256i(remainder);
-
-    for (int k = 0; k < round_dim; k += 8) {
-        __m256 a = _mm256_loadu_ps(&in_0[k]);
-        __m256 b = _mm256_loadu_ps(&in_1[k]);
-        _mm256_storeu_ps(&out[k], _mm256_add_ps(a, b));
-    }
-
-    if (remainder > 0) {
-        __m256 a = _mm256_maskload_ps(&in_0[round_dim], mask_m256i);
-        __m256 b = _mm256_maskload_ps(&in_1[round_dim], mask_m256i);
-        _mm256_maskstore_ps(out + round_dim, mask_m256i, _mm256_add_ps(a, b));
-    }
-}
-
-void avx2_vector_sub(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out) {
-    int round_dim = len / 8 * 8;
-    int remainder = len % 8;
-    __m256i mask_m256i = _m256_continue_mask_m256i(remainder);
-
-    for (int k = 0; k < round_dim; k += 8) {
-        __m256 a = _mm256_loadu_ps(&in_0[k]);
-        __m256 b = _mm256_loadu_ps(&in_1[k]);
-        _mm256_storeu_ps(&out[k], _mm256_sub_ps(a, b));
-    }
-
-    if (remainder > 0) {
-        __m256 a = _mm256_maskload_ps(&in_0[round_dim], mask_m256i);
-        __m256 b = _mm256_maskload_ps(&in_1[round_dim], mask_m256i);
-        _mm256_maskstore_ps(out + round_dim, mask_m256i, _mm256_sub_ps(a, b));
-    }
-}
-
-
-void avx2_vector_mul(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out) {
-    int round_dim = len / 8 * 8;
-    int remainder = len % 8;
-    __m256i mask_m256i = _m256_continue_mask_m256i(remainder);
-
-    for (int k = 0; k < round_dim; k += 8) {
-        __m256 a = _mm256_loadu_ps(&in_0[k]);
-        __m256 b = _mm256_loadu_ps(&in_1[k]);
-        _mm256_storeu_ps(&out[k], _mm256_mul_ps(a, b));
-    }
-
-    if (remainder > 0) {
-        __m256 a = _mm256_maskload_ps(&in_0[round_dim], mask_m256i);
-        __m256 b = _mm256_maskload_ps(&in_1[round_dim], mask_m256i);
-        _mm256_maskstore_ps(out + round_dim, mask_m256i, _mm256_mul_ps(a, b));
-    }
-}
-
 }
 }
 #endif
@@ -22,8 +22,6 @@ inline bool avx2_can_used(){
 #if defined(__AVX2__) and defined(__FMA__)
 void avx2_vector_softmax_stride(const float* in, int col, int row, float* out);
 void avx2_vector_softmax(const float* in, int length, float* out);
-void avx2_vector_relu(const float* in, int length, float* out);
-void avx2_vector_sigmoid(const float* in, int length, float* out);
 void avx2_sequence_softmax(const float* data, std::vector<int>& seq_offset, float* out);
 void avx2_lstm_bias_and_act(const float* hidden_in, const float* bias_data, float* out,
                             float* cell_data, const int seq_num, const int hidden_size, const int with_peephole);
@@ -56,29 +54,6 @@ void avx2_vector_sum(const float* in_0,
                   const int len,
                   float* out);
 
-/* Calculate the sum of two vectors
- * z[i] =  x[i] + y[i]
- * */
-void avx2_vector_sum(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out);
-
-/* Calculate the sub of two vectors
- * z[i] =  x[i] - y[i]
- * */
-void avx2_vector_sub(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out);
-
-/* Calculate the product of two vectors
- * z[i] =  x[i] * y[i]
- * */
-void avx2_vector_mul(const float* in_0,
-                     const float* in_1,
-                     const int len,
-                     float* out);
 #endif
 }
 }
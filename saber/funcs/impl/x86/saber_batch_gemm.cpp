@@ -0,0 +1,123 @@
+#include "saber/funcs/impl/x86/saber_batch_gemm.h"
+#include "saber/funcs/impl/x86/anakin_thread.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace anakin {
+namespace saber {
+
+namespace {
+
+inline int packed_ld(int n, int width) {
+    return (n + width - 1) / width * width;
+}
+
+/// op(B) into rows of ld floats, ld = packed_ld(n, width).
+void pack_b(bool trans_b, int n, int k, const float* b, int ldb, int ld, float* pack) {
+    for (int p = 0; p < k; p++) {
+        float* dst = pack + p * ld;
+
+        if (trans_b) {
+            for (int j = 0; j < n; j++) {
+                dst[j] = b[j * ldb + p];
+            }
+        } else {
+            memcpy(dst, b + p * ldb, n * sizeof(float));
+        }
+
+        std::fill(dst + n, dst + ld, 0.f);
+    }
+}
+
+/// per thread pack buffer, grows to the largest op(B) seen and is kept.
+float* pack_buffer(size_t size) {
+    static thread_local std::vector<float> buffer;
+
+    if (buffer.size() < size) {
+        buffer.resize(size);
+    }
+
+    return buffer.data();
+}
+
+struct PointerBatch {
+    const float* const* a;
+    const float* const* b;
+    float* const* c;
+    const float* mat_a(int i) const { return a[i]; }
+    const float* mat_b(int i) const { return b[i]; }
+    float* mat_c(int i) const { return c[i]; }
+};
+
+struct StridedBatch {
+    const float* a;
+    size_t stride_a;
+    const float* b;
+    size_t stride_b;
+    float* c;
+    size_t stride_c;
+    const float* mat_a(int i) const { return a + i * stride_a; }
+    const float* mat_b(int i) const { return b + i * stride_b; }
+    float* mat_c(int i) const { return c + i * stride_c; }
+};
+
+template <typename Batch>
+void run_batch(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+               int lda, int ldb, float beta, int ldc, const Batch& mats, int batch) {
+    if (m <= 0 || n <= 0 || batch <= 0) {
+        return;
+    }
+
+    const X86IsaKernels& kernels = x86_isa_kernels();
+    const int a_rs = trans_a ? 1 : lda;
+    const int a_ks = trans_a ? lda : 1;
+    const int pb_ld = packed_ld(n, kernels.vec_width);
+    const size_t pack_size = (size_t)std::max(k, 1) * pb_ld;
+    const int row_blocks = (m + kIsaGemmRows - 1) / kIsaGemmRows;
+
+    if (batch >= anakin_get_max_threads() || row_blocks == 1) {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < batch; i++) {
+            float* pb = pack_buffer(pack_size);
+            pack_b(trans_b, n, k, mats.mat_b(i), ldb, pb_ld, pb);
+            IsaGemmOperands op{mats.mat_a(i), a_rs, a_ks, pb, pb_ld, mats.mat_c(i), ldc, k,
+                               alpha, beta};
+            kernels.small_gemm(op, n, 0, m);
+        }
+    } else {
+        // too few matrices for the team, split the rows of each one
+        float* pb = pack_buffer(pack_size);
+
+        for (int i = 0; i < batch; i++) {
+            pack_b(trans_b, n, k, mats.mat_b(i), ldb, pb_ld, pb);
+            IsaGemmOperands op{mats.mat_a(i), a_rs, a_ks, pb, pb_ld, mats.mat_c(i), ldc, k,
+                               alpha, beta};
+            #pragma omp parallel for schedule(static)
+            for (int blk = 0; blk < row_blocks; blk++) {
+                kernels.small_gemm(op, n, blk * kIsaGemmRows,
+                                   std::min(m, (blk + 1) * kIsaGemmRows));
+            }
+        }
+    }
+}
+
+} // namespace
+
+void batch_small_gemm(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                      const float* const* a, int lda, const float* const* b, int ldb,
+                      float beta, float* const* c, int ldc, int batch) {
+    PointerBatch mats{a, b, c};
+    run_batch(trans_a, trans_b, m, n, k, alpha, lda, ldb, beta, ldc, mats, batch);
+}
+
+void batch_small_gemm_strided(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                              const float* a, int lda, size_t stride_a,
+                              const float* b, int ldb, size_t stride_b,
+                              float beta, float* c, int ldc, size_t stride_c, int batch) {
+    StridedBatch mats{a, stride_a, b, stride_b, c, stride_c};
+    run_batch(trans_a, trans_b, m, n, k, alpha, lda, ldb, beta, ldc, mats, batch);
+}
+
+}
+}
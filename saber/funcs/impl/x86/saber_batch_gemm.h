@@ -0,0 +1,99 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_BATCH_GEMM_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_BATCH_GEMM_H
+
+#include "saber/core/tensor.h"
+#include "saber/funcs/batch_gemm.h"
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i] for every i < batch, row major.
+ * op(A) is m x k, op(B) is k x n, op transposes when trans is set.
+ *
+ * Made for many small matrices (attention heads, match pyramids): op(B) is packed into
+ * vector aligned panels and the small_gemm kernel of the selected isa table (register
+ * blocks of up to 4 rows x 2 vectors) runs the whole k loop per block, with no blas call
+ * per matrix. Matrices are spread over
+ * the omp threads, a batch smaller than the team splits the rows of each matrix instead.
+ */
+void batch_small_gemm(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                      const float* const* a, int lda, const float* const* b, int ldb,
+                      float beta, float* const* c, int ldc, int batch);
+
+/// same with the matrices at a fixed stride from a, b and c.
+void batch_small_gemm_strided(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                              const float* a, int lda, size_t stride_a,
+                              const float* b, int ldb, size_t stride_b,
+                              float beta, float* c, int ldc, size_t stride_c, int batch);
+
+/// true when m, n, k are small enough for batch_small_gemm to beat a blas call per matrix.
+/// the scalar table never does, the callers keep cblas_sgemm then.
+inline bool use_batch_small_gemm(int m, int n, int k) {
+    return x86_isa_kernels().vec_width > 1 && (size_t)m * n * k <= 128 * 128 * 128;
+}
+
+template<typename inDtype,
+        typename outDtype>
+class BatchGemm<X86, SABER_IMPL, inDtype, outDtype>
+        : public BatchMatrixFunc<X86, inDtype, outDtype> {
+
+public:
+    BatchGemm() = default;
+    ~BatchGemm() = default;
+
+    SaberStatus init(const bool trans_a, const bool trans_b, const int max_batch,
+                     Context<X86> ctx) {
+        _ctx = ctx;
+        _trans_a = trans_a;
+        _trans_b = trans_b;
+        return SaberSuccess;
+    }
+
+    SaberStatus dispatch(const outDtype alpha, const outDtype beta,
+                         const inDtype* a[], const inDtype* b[],
+                         const int m, const int n, const int k,
+                         outDtype* c[], const int batch) {
+        CHECK(a != nullptr && b != nullptr && c != nullptr);
+        int lda = (!_trans_a) ? k : m;
+        int ldb = (!_trans_b) ? n : k;
+        batch_small_gemm(_trans_a, _trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, n, batch);
+        return SaberSuccess;
+    }
+
+    /// a holds the batch pointers of A, then of B, then of C
+    SaberStatus dispatch(const outDtype alpha, const outDtype beta,
+                         inDtype* a[],
+                         const int m, const int n, const int k,
+                         const int batch) {
+        CHECK(a != nullptr);
+        return dispatch(alpha, beta, (const inDtype**)a, (const inDtype**)(a + batch),
+                        m, n, k, a + 2 * batch, batch);
+    }
+
+private:
+    Context<X86> _ctx;
+    bool _trans_a{false};
+    bool _trans_b{false};
+};
+
+}
+}
+
+#endif
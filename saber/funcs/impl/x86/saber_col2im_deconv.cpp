@@ -1,187 +1,121 @@
 
 #include "saber/funcs/impl/x86/saber_col2im_deconv.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace anakin {
 namespace saber {
 
-void fill_bias_relu(float* tensor, const float* bias, int channel, int channel_size,
-                    bool flag_relu) {
-    float* data = tensor;
-
-    for (int j = 0; j < channel; ++j) {
-        for (int i = 0; i < channel_size; i++) {
-            data[i] += bias[j];
-
-            if (flag_relu) {
-                data[i] = data[i] > 0 ? data[i] : 0.f;
-            }
+namespace {
+
+/// output rows of one channel per col2im task
+const int kRowBlock = 4;
+/// the column buffers of the images of one col2im pass stay under this many floats
+const size_t kColBufferFloats = 16 << 20;
+
+/// geometry of the column matrix of one image: every output channel has kernel_h * kernel_w
+/// planes of height_col x width_col (the input size)
+struct Col2ImShape {
+    int height;
+    int width;
+    int kernel_h;
+    int kernel_w;
+    int pad_h;
+    int pad_w;
+    int stride_h;
+    int stride_w;
+    int dilation_h;
+    int dilation_w;
+    int height_col;
+    int width_col;
+};
+
+/**
+ * one output row of one channel. x = i * stride_w + phase: the taps of a kernel column all
+ * land on one phase, so each phase is accumulated contiguously (vectorized) in its own plane
+ * of buf, the planes are then interleaved into the row with bias and relu.
+ */
+void col2im_row(const float* col, const Col2ImShape& s, int y, float bias, bool with_relu,
+                float* buf, float* out) {
+    const int phase_len = (s.width + s.stride_w - 1) / s.stride_w;
+    const int plane_size = s.height_col * s.width_col;
+    memset(buf, 0, s.stride_w * phase_len * sizeof(float));
+
+    for (int kh = 0; kh < s.kernel_h; kh++) {
+        int t = y + s.pad_h - kh * s.dilation_h;
+
+        if (t < 0 || t % s.stride_h != 0 || t / s.stride_h >= s.height_col) {
+            continue;
         }
 
-        data += channel_size;
-    }
-}
-
-void fill_relu(float* tensor, int channel, int channel_size,
-               bool flag_relu) {
-    float* data = tensor;
-
-    for (int j = 0; j < channel; ++j) {
-        for (int i = 0; i < channel_size; i++) {
-            if (flag_relu) {
-                data[i] = data[i] > 0 ? data[i] : 0.f;
+        const float* col_row = col + (size_t)kh * s.kernel_w * plane_size + (t / s.stride_h) * s.width_col;
+
+        for (int kw = 0; kw < s.kernel_w; kw++, col_row += plane_size) {
+            int offset = kw * s.dilation_w - s.pad_w;
+            int phase = ((offset % s.stride_w) + s.stride_w) % s.stride_w;
+            int base = (offset - phase) / s.stride_w;
+            int phase_width = (s.width - phase + s.stride_w - 1) / s.stride_w;
+            int w_begin = std::max(0, -base);
+            int w_end = std::min(s.width_col, phase_width - base);
+            float* dst = buf + phase * phase_len + base;
+            #pragma omp simd
+            for (int w = w_begin; w < w_end; w++) {
+                dst[w] += col_row[w];
             }
         }
-
-        data += channel_size;
     }
-}
 
+    for (int phase = 0; phase < s.stride_w; phase++) {
+        const float* src = buf + phase * phase_len;
+        int phase_width = (s.width - phase + s.stride_w - 1) / s.stride_w;
 
-inline bool is_a_ge_zero_and_a_lt_b(int a, int b) {
-    return static_cast<unsigned>(a) < static_cast<unsigned>(b);
-}
-
-template <typename Dtype>
-void col2im(const Dtype* data_col, const int channels,
-            const int height, const int width, const int kernel_h, const int kernel_w,
-            const int pad_h, const int pad_w,
-            const int stride_h, const int stride_w,
-            const int dilation_h, const int dilation_w,
-            Dtype* data_im) {
-
-    memset(data_im, 0, height * width * channels * sizeof(Dtype));
-    const int output_h = (height + 2 * pad_h - (dilation_h * (kernel_h - 1) + 1)) / stride_h + 1;
-    const int output_w = (width + 2 * pad_w - (dilation_w * (kernel_w - 1) + 1)) / stride_w + 1;
-    const int channel_size = height * width;
-
-    for (int channel = channels; channel--; data_im += channel_size) {
-        for (int kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
-            for (int kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
-                int input_row = -pad_h + kernel_row * dilation_h;
-
-                for (int output_rows = output_h; output_rows; output_rows--) {
-                    if (!is_a_ge_zero_and_a_lt_b(input_row, height)) {
-                        data_col += output_w;
-                    } else {
-                        int input_col = -pad_w + kernel_col * dilation_w;
-
-                        for (int output_col = output_w; output_col; output_col--) {
-                            if (is_a_ge_zero_and_a_lt_b(input_col, width)) {
-                                data_im[input_row * width + input_col] += *data_col;
-                            }
-
-                            data_col++;
-                            input_col += stride_w;
-                        }
-                    }
-
-                    input_row += stride_h;
-                }
-            }
-        }
-    }
-}
-
-template <typename Dtype>
-void col2im_par(const Dtype* data_col, const int channels,
-                const int height, const int width, const int kernel_h, const int kernel_w,
-                const int pad_h, const int pad_w,
-                const int stride_h, const int stride_w,
-                const int dilation_h, const int dilation_w,
-                Dtype* data_im, bool with_bias = false, const Dtype* bias = nullptr) {
-    int dil_patch_h = (kernel_h - 1) * dilation_h + 1;
-    int dil_patch_w = (kernel_w - 1) * dilation_w + 1;
-    int height_col = (height + 2 * pad_h - dil_patch_h) / stride_h + 1;
-    int width_col = (width + 2 * pad_w - dil_patch_w) / stride_w + 1;
-    long chunk_len = kernel_h * kernel_w;
-
-    if (with_bias) {
-        int channel_size = width * height;
-        #pragma omp parallel for schedule(static) if(channels>1)
-
-        for (int j = 0; j < channels; ++j) {
-            float* data_out = data_im + j * channel_size;
-            float value = bias[j];
-
-            for (int i = 0; i < channel_size; i++) {
-                data_out[i] = value;
+        if (with_relu) {
+            for (int i = 0; i < phase_width; i++) {
+                float v = src[i] + bias;
+                out[i * s.stride_w + phase] = v > 0.f ? v : 0.f;
             }
-        }
-    } else {
-        memset(data_im, 0, height * width * channels * sizeof(Dtype));
-    }
-
-    #pragma omp parallel for schedule(static)
-
-    for (int idx = 0; idx < channels; ++idx) {
-        for (int inner_idx = 0; inner_idx < chunk_len; ++inner_idx) {
-            int c = idx * chunk_len + inner_idx;
-            int w_offset = c % kernel_w;
-            int h_offset = (c / kernel_w) % kernel_h;
-            int c_im = c / kernel_h / kernel_w;
-
-            const int hc0 = h_offset * dilation_h - pad_h;
-            const int wc0 = w_offset * dilation_w - pad_w;
-
-            for (int h = 0; h < height_col; ++h) {
-                for (int w = 0; w < width_col; ++w) {
-                    int h_pad = h * stride_h + hc0;
-                    const int srow_offset = (c_im * height + h_pad) * width;
-                    const int row_offset = (c * height_col + h) * width_col;
-                    int w_pad = w * stride_w + wc0;
-
-                    if ((((unsigned)h_pad) < ((unsigned)height)) && (((unsigned)w_pad) < ((unsigned)width))) {
-                        data_im[srow_offset + w_pad] += data_col[row_offset + w];
-                    }
-                }
+        } else {
+            for (int i = 0; i < phase_width; i++) {
+                out[i * s.stride_w + phase] = src[i] + bias;
             }
         }
     }
 }
 
-template <typename Dtype>
-void col2im_par_me(const Dtype* data_col, const int channels,
-                   const int height, const int width, const int kernel_h, const int kernel_w,
-                   const int pad_h, const int pad_w,
-                   const int stride_h, const int stride_w,
-                   const int dilation_h, const int dilation_w,
-                   Dtype* data_im) {
-
-    memset(data_im, 0, height * width * channels * sizeof(Dtype));
-    const int output_h = (height + 2 * pad_h - (dilation_h * (kernel_h - 1) + 1)) / stride_h + 1;
-    const int output_w = (width + 2 * pad_w - (dilation_w * (kernel_w - 1) + 1)) / stride_w + 1;
-    const int channel_size = height * width;
-    #pragma omp parallel for schedule(static)
-
-    for (int channel = channels; channel > 0 ; channel--) {
-        for (int kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
-            for (int kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
-                int input_row = -pad_h + kernel_row * dilation_h;
-                float* data_im_to = data_im + (channels - channel) * channel_size;
-
-                for (int output_rows = output_h; output_rows; output_rows--) {
-                    if (!is_a_ge_zero_and_a_lt_b(input_row, height)) {
-                        data_col += output_w;
-                    } else {
-                        int input_col = -pad_w + kernel_col * dilation_w;
-
-                        for (int output_col = output_w; output_col; output_col--) {
-                            if (is_a_ge_zero_and_a_lt_b(input_col, width)) {
-                                data_im_to[input_row * width + input_col] += *data_col;
-                            }
-
-                            data_col++;
-                            input_col += stride_w;
-                        }
-                    }
-
-                    input_row += stride_h;
+/**
+ * col2im of num images with fused bias and relu, the tasks are (image, channel, block of
+ * output rows): each one gathers its rows from the column planes of its channel and writes
+ * them once, so there are no write conflicts and no zero-fill or bias pass over the output.
+ */
+void col2im_bias_relu(const float* col, int num, int channels, const Col2ImShape& s,
+                      const float* bias, bool with_relu, float* im) {
+    const int row_blocks = (s.height + kRowBlock - 1) / kRowBlock;
+    const size_t col_channel = (size_t)s.kernel_h * s.kernel_w * s.height_col * s.width_col;
+    const size_t im_channel = (size_t)s.height * s.width;
+    const int buf_size = s.stride_w * ((s.width + s.stride_w - 1) / s.stride_w);
+
+    #pragma omp parallel for collapse(3) schedule(static)
+    for (int n = 0; n < num; n++) {
+        for (int c = 0; c < channels; c++) {
+            for (int rb = 0; rb < row_blocks; rb++) {
+                static thread_local std::vector<float> buf;
+                buf.resize(buf_size);
+                const float* col_c = col + (n * (size_t)channels + c) * col_channel;
+                float* im_c = im + (n * (size_t)channels + c) * im_channel;
+                float b = bias != nullptr ? bias[c] : 0.f;
+                int y_end = std::min(s.height, (rb + 1) * kRowBlock);
+
+                for (int y = rb * kRowBlock; y < y_end; y++) {
+                    col2im_row(col_c, s, y, b, with_relu, buf.data(), im_c + y * s.width);
                 }
             }
         }
     }
 }
 
+} // namespace
+
 template <>
 SaberStatus SaberCol2ImDeconv<AK_FLOAT>::create(const std::vector<Tensor<X86> *>& inputs,
         std::vector<Tensor<X86>*>& outputs,
@@ -205,7 +139,10 @@ SaberStatus SaberCol2ImDeconv<AK_FLOAT>::create(const std::vector<Tensor<X86> *>
         CHECK_EQ(chout % param.group, 0) << "output channel or group size error";
     }
 
-    Shape workspace_shape({1, 1, 1, param.group* _m * _n});
+    // several images share a col2im pass as long as their column buffers stay small
+    size_t image_col = (size_t)param.group * _m * _n;
+    _batch_block = std::max(1, std::min(inputs[0]->num(), (int)(kColBufferFloats / image_col)));
+    Shape workspace_shape({1, 1, 1, (int)(_batch_block * image_col)});
     workspace_tensor.re_alloc(workspace_shape, AK_FLOAT);
 
     _gemm.init(true, false, _m, _n, _k, *(this->_ctx));
@@ -247,35 +184,29 @@ SaberStatus SaberCol2ImDeconv<AK_FLOAT>::dispatch(const std::vector<Tensor<X86>
     const float* din = static_cast<const float*>(inputs[0]->data());
     float* dout = static_cast<float*>(outputs[0]->mutable_data());
     const float* weights = static_cast<const float*>(param.weight()->data());
+    const float* bias = bias_term ? static_cast<const float*>(param.bias()->data()) : nullptr;
     float* workspace_ptr = static_cast<float*>(workspace_tensor.mutable_data());
-
-    for (int i = 0; i < num; ++i) {
-        const float* din_batch = din + i * chin * hin * win;
-        float* dout_batch = dout + i * chout * hout * wout;
-
-        float* col_data = workspace_ptr;
-
-        for (int g = 0; g < param.group; ++g) {
-            const float* din_group = din_batch + g * group_size_in;
-            const float* weights_group = weights + g * group_size_weights;
-            float* coldata_group = col_data + g * group_size_coldata;
-            _gemm.dispatch(1.f, 0.f, weights_group, din_group, coldata_group);
-        }
-
-        if (bias_term) {
-            col2im_par(col_data, chout, hout, wout, _kh, _kw, param.pad_h, param.pad_w, \
-                       param.stride_h, param.stride_w, param.dilation_h, param.dilation_w, \
-                       dout_batch, bias_term, static_cast<const float*>(param.bias()->data()));
-        } else {
-            col2im_par(col_data, chout, hout, wout, _kh, _kw, param.pad_h, param.pad_w, \
-                       param.stride_h, param.stride_w, param.dilation_h, param.dilation_w, \
-                       dout_batch);
+    Col2ImShape shape = {hout, wout, _kh, _kw, param.pad_h, param.pad_w,
+                         param.stride_h, param.stride_w, param.dilation_h, param.dilation_w,
+                         hin, win};
+
+    for (int i = 0; i < num; i += _batch_block) {
+        int batch = std::min(_batch_block, num - i);
+
+        for (int b = 0; b < batch; ++b) {
+            const float* din_batch = din + (size_t)(i + b) * chin * hin * win;
+            float* col_data = workspace_ptr + (size_t)b * group * group_size_coldata;
+
+            for (int g = 0; g < param.group; ++g) {
+                const float* din_group = din_batch + g * group_size_in;
+                const float* weights_group = weights + g * group_size_weights;
+                float* coldata_group = col_data + g * group_size_coldata;
+                _gemm.dispatch(1.f, 0.f, weights_group, din_group, coldata_group);
+            }
         }
 
-        if (with_relu) {
-            fill_relu(dout_batch, chout, wout * hout,
-                      with_relu);
-        }
+        col2im_bias_relu(workspace_ptr, batch, chout, shape, bias, with_relu,
+                         dout + (size_t)i * chout * hout * wout);
     }
 
     return SaberSuccess;
@@ -47,6 +47,8 @@ private:
     int _m;
     int _n;
     int _k;
+    ///< images per col2im pass, the workspace holds their column buffers
+    int _batch_block{1};
     Tensor<X86> workspace_tensor;
     Gemm<X86, VENDER_IMPL, OpDataType> _gemm;
 };
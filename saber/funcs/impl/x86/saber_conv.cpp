@@ -89,10 +89,18 @@ SaberStatus SaberConv2D<X86, AK_FLOAT>::init(const std::vector<Tensor<X86> *>& i
     bool is_strict_c8_out = is_c8_out && (ic % 8 == 0 && oc % 8 == 0);
 
     bool is_winorgrad = (kh == 3 && kw == 3) && (stride_h == 1 && stride_w == 1) && (dilation_h == 1
-                        && dilation_w == 1) && group == 1;
+                        && dilation_w == 1) && group == 1
+                        && (!param.activation_param.has_active || param.activation_param.active == Active_relu);
+    auto is_winograd_layout = [](LayoutType layout) {
+        return layout == Layout_NCHW || layout == Layout_NCHW_C8R || layout == Layout_NCHW_C16R;
+    };
+    // the jit convs below pick their isa at runtime, winograd only has the one it is built for
+    bool has_jit_conv = (use_avx512 && (is_strict_c16 || is_first_c16)) || (use_avx2 && pad_w <= 3);
 #ifndef USE_SGX
-    if (is_winorgrad && (oc >= 16 && ic >= 16 && ih >= 12 && iw >= 12)
-            && (((input_layout == Layout_NCHW) && (out_layout == Layout_NCHW)))) {
+    if (is_winorgrad && winograd_simd_enabled() && (oc >= 16 && ic >= 16 && ih >= 8 && iw >= 8)
+            && is_winograd_layout(input_layout) && is_winograd_layout(out_layout)
+            && (!has_jit_conv || winograd_beats_direct(ic, oc, outputs[0]->height(),
+                    outputs[0]->width()))) {
         this->impl = new SaberConvWinograd<AK_FLOAT>;
     } else
 #endif
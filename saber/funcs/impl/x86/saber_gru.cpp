@@ -152,7 +152,17 @@ batch_s_aligned(const std::vector<OpTensor*>& inputs,
     OpDataType* out = ( OpDataType*)outputs[0]->mutable_data();
     bool is_reverse = param.is_reverse;
 
-    if (inputs.size() > 1) {
+    if (param.state_hidden != nullptr) {
+        // streaming: every sequence goes on from the hidden its previous chunk left
+        CHECK_GE(param.state_hidden->valid_size(), batch_size * _hidden_size)
+                << "state_hidden needs one row per sequence";
+        // not _aligned_init_hidden, it stays the zeros of the stateless calls
+        utils::try_expand_tensor(_init_hidden, batch_size * _aligned_hidden_size);
+        aligned_utils.aligned_last_dim((const OpDataType*)param.state_hidden->data(),
+                                       (OpDataType*)_init_hidden.mutable_data(),
+                                       batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+        h_init = (const OpDataType*)_init_hidden.data();
+    } else if (inputs.size() > 1) {
         h_init = (const OpDataType*)inputs[1]->data();
         utils::try_expand_tensor(_aligned_init_hidden,batch_size * _aligned_hidden_size);
         aligned_utils.aligned_last_dim(h_init, (OpDataType*)_aligned_init_hidden.mutable_data(),
@@ -293,6 +303,11 @@ batch_s_aligned(const std::vector<OpTensor*>& inputs,
                                          _aligned_hidden_size);
     }
 
+    if (param.state_hidden != nullptr) {
+        transe_util.seq_last_hidden((const OpDataType*)out,
+                                    (OpDataType*)param.state_hidden->mutable_data(), offset_vec, _hidden_size);
+    }
+
     return SaberSuccess;
 };
 
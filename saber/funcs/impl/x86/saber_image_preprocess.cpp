@@ -0,0 +1,210 @@
+#include "saber/funcs/impl/x86/saber_image_preprocess.h"
+#include <algorithm>
+
+namespace anakin {
+namespace saber {
+
+namespace {
+
+/// the two source taps of one output coordinate and their weights
+struct Tap {
+    int i0;
+    int i1;
+    float w0;
+    float w1;
+};
+
+/// same source coordinates as the SaberResize kernels of each resize type
+std::vector<Tap> resize_taps(ResizeType type, int in, int out) {
+    std::vector<Tap> taps(out);
+    float align_scale = out > 1 ? (float)(in - 1) / (out - 1) : 0.f;
+    float scale = (float)in / out;
+
+    for (int i = 0; i < out; i++) {
+        Tap& tap = taps[i];
+        float f = 0.f;
+
+        switch (type) {
+        case NEAREST_ALIGN:
+            tap.i0 = std::min(static_cast<int>(align_scale * i + 0.5f), in - 1);
+            tap.i1 = tap.i0;
+            tap.w0 = 1.f;
+            tap.w1 = 0.f;
+            continue;
+
+        case RESIZE_CUSTOM:
+            // the tap past the border reads as 0
+            f = i * scale;
+            tap.i0 = std::min(static_cast<int>(f), in - 1);
+            f -= tap.i0;
+            tap.i1 = std::min(tap.i0 + 1, in - 1);
+            tap.w0 = 1.f - f;
+            tap.w1 = tap.i0 + 1 < in ? f : 0.f;
+            continue;
+
+        case BILINEAR_ALIGN:
+            f = i * align_scale;
+            break;
+
+        default:
+            f = std::max(scale * (i + 0.5f) - 0.5f, 0.f);
+            break;
+        }
+
+        tap.i0 = std::min(static_cast<int>(f), in - 1);
+        tap.i1 = tap.i0 < in - 1 ? tap.i0 + 1 : tap.i0;
+        f -= tap.i0;
+        tap.w0 = 1.f - f;
+        tap.w1 = f;
+    }
+
+    return taps;
+}
+
+/// one source row resized along x into channels planes of out_w floats
+void resize_row(const unsigned char* row, int src_channels, const int* perm, int channels,
+                const std::vector<Tap>& taps, float* planes) {
+    const int out_w = taps.size();
+
+    for (int x = 0; x < out_w; x++) {
+        const Tap& tap = taps[x];
+        const unsigned char* p0 = row + tap.i0 * src_channels;
+        const unsigned char* p1 = row + tap.i1 * src_channels;
+
+        for (int c = 0; c < channels; c++) {
+            planes[c * out_w + x] = p0[perm[c]] * tap.w0 + p1[perm[c]] * tap.w1;
+        }
+    }
+}
+
+} // namespace
+
+SaberStatus image_preprocess(const ImagePreprocessParam& param, const unsigned char* src,
+                             int num, int height, int width, int row_stride, Tensor<X86>& dst) {
+    if (param.src_channels != 1 && param.src_channels != 3 && param.src_channels != 4) {
+        LOG(ERROR) << "image preprocess only supports 1, 3 or 4 channels images, not "
+                   << param.src_channels;
+        return SaberInvalidValue;
+    }
+
+    const int channels = param.src_channels == 4 ? 3 : param.src_channels;
+
+    if ((!param.mean.empty() && param.mean.size() != channels)
+            || (!param.std.empty() && param.std.size() != channels)) {
+        LOG(ERROR) << "image preprocess needs one mean and one std per channel";
+        return SaberInvalidValue;
+    }
+
+    if (row_stride <= 0) {
+        row_stride = width * param.src_channels;
+    }
+
+    const int out_h = param.out_height > 0 ? param.out_height : dst.height();
+    const int out_w = param.out_width > 0 ? param.out_width : dst.width();
+
+    if (out_h <= 0 || out_w <= 0) {
+        LOG(ERROR) << "image preprocess doesn't know the output size of the image";
+        return SaberInvalidValue;
+    }
+
+    const LayoutType layout = dst.get_layout();
+    const int blocks = (channels + 7) / 8;
+
+    switch (layout) {
+    case Layout_NCHW:
+        dst.reshape(Shape({num, channels, out_h, out_w}, Layout_NCHW));
+        break;
+
+    case Layout_NHWC:
+        dst.reshape(Shape({num, out_h, out_w, channels}, Layout_NHWC));
+        break;
+
+    case Layout_NCHW_C8R:
+        dst.reshape(Shape({num, channels, out_h, out_w}, Layout_NCHW_C8R));
+        break;
+
+    default:
+        LOG(ERROR) << "image preprocess doesn't support layout " << layout;
+        return SaberUnImplError;
+    }
+
+    int perm[3];
+    float mul[3];
+    float add[3];
+
+    for (int c = 0; c < channels; c++) {
+        perm[c] = (param.swap_rb && channels == 3) ? 2 - c : c;
+        float inv_std = param.std.empty() ? 1.f : 1.f / param.std[c];
+        mul[c] = inv_std;
+        add[c] = param.mean.empty() ? 0.f : -param.mean[c] * inv_std;
+    }
+
+    const std::vector<Tap> xs = resize_taps(param.resize_type, width, out_w);
+    const std::vector<Tap> ys = resize_taps(param.resize_type, height, out_h);
+    const int src_channels = param.src_channels;
+    float* out = static_cast<float*>(dst.mutable_data());
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int n = 0; n < num; n++) {
+        for (int y = 0; y < out_h; y++) {
+            static thread_local std::vector<float> rows;
+            rows.resize(3 * channels * out_w);
+            float* row0 = rows.data();
+            float* row1 = row0 + channels * out_w;
+            float* line = row1 + channels * out_w;
+            const Tap& ty = ys[y];
+            const unsigned char* image = src + (size_t)n * height * row_stride;
+            resize_row(image + (size_t)ty.i0 * row_stride, src_channels, perm, channels, xs, row0);
+
+            if (ty.w1 != 0.f) {
+                resize_row(image + (size_t)ty.i1 * row_stride, src_channels, perm, channels, xs, row1);
+            } else {
+                row1 = row0;
+            }
+
+            for (int c = 0; c < channels; c++) {
+                const float a = ty.w0 * mul[c];
+                const float b = ty.w1 * mul[c];
+                const float bias = add[c];
+                const float* r0 = row0 + c * out_w;
+                const float* r1 = row1 + c * out_w;
+                // planar output is written in place, the others go through line
+                float* d = layout == Layout_NCHW ? out + (((size_t)n * channels + c) * out_h + y) * out_w
+                                                 : line;
+                #pragma omp simd
+                for (int x = 0; x < out_w; x++) {
+                    d[x] = r0[x] * a + r1[x] * b + bias;
+                }
+
+                if (layout == Layout_NHWC) {
+                    float* o = out + ((size_t)n * out_h + y) * out_w * channels + c;
+
+                    for (int x = 0; x < out_w; x++) {
+                        o[x * channels] = line[x];
+                    }
+                } else if (layout == Layout_NCHW_C8R) {
+                    float* o = out + (((size_t)n * blocks + c / 8) * out_h + y) * out_w * 8 + c % 8;
+
+                    for (int x = 0; x < out_w; x++) {
+                        o[x * 8] = line[x];
+                    }
+                }
+            }
+
+            if (layout == Layout_NCHW_C8R) {
+                for (int c = channels; c < blocks * 8; c++) {
+                    float* o = out + (((size_t)n * blocks + c / 8) * out_h + y) * out_w * 8 + c % 8;
+
+                    for (int x = 0; x < out_w; x++) {
+                        o[x * 8] = 0.f;
+                    }
+                }
+            }
+        }
+    }
+
+    return SaberSuccess;
+}
+
+}
+}
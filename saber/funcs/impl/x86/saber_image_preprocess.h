@@ -0,0 +1,68 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_IMAGE_PREPROCESS_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_IMAGE_PREPROCESS_H
+
+#include "saber/core/tensor.h"
+#include <vector>
+
+namespace anakin {
+namespace saber {
+
+/**
+ * \brief how an interleaved uint8 image (HWC, BGR/RGB/gray, optional 4th channel)
+ * becomes a float input tensor.
+ */
+struct ImagePreprocessParam {
+    ImagePreprocessParam() = default;
+    ImagePreprocessParam(int src_channels_in, bool swap_rb_in,
+                         std::vector<float> mean_in, std::vector<float> std_in,
+                         ResizeType resize_type_in = BILINEAR_NO_ALIGN)
+        : src_channels(src_channels_in)
+        , swap_rb(swap_rb_in)
+        , mean(mean_in)
+        , std(std_in)
+        , resize_type(resize_type_in) {}
+
+    ///< channels of one source pixel: 1, 3 or 4 (the 4th one is dropped)
+    int src_channels{3};
+    ///< exchange channel 0 and 2, BGR <-> RGB
+    bool swap_rb{false};
+    ///< per output channel, out = (pixel - mean) / std, empty means 0 and 1
+    std::vector<float> mean;
+    std::vector<float> std;
+    ///< sampling of the resize, same coordinates as SaberResize
+    ResizeType resize_type{BILINEAR_NO_ALIGN};
+    ///< output size, <= 0 keeps the height / width dst already has
+    int out_height{-1};
+    int out_width{-1};
+};
+
+/**
+ * \brief resize, channel swap, normalization and layout change of num uint8 HWC images
+ * (height x width, row_stride bytes between rows, images back to back) into dst, in one pass.
+ *
+ * dst is reshaped to num x C x out_h x out_w in its own layout, Layout_NCHW, Layout_NHWC or
+ * Layout_NCHW_C8R (padding channels are zeroed). Rows of the output are spread over the
+ * omp threads, each one interpolates its two source rows once for all channels.
+ */
+SaberStatus image_preprocess(const ImagePreprocessParam& param, const unsigned char* src,
+                             int num, int height, int width, int row_stride, Tensor<X86>& dst);
+
+}
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+#include "saber/funcs/impl/x86/kernel/jit_generator.h"
+#include "utils/logger/logger.h"
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace anakin {
+
+namespace saber {
+
+static const X86IsaKernels* select_x86_isa_kernels() {
+    const X86IsaKernels* table = nullptr;
+
+    if (jit::mayiuse(jit::avx512_core_vnni)) {
+        table = x86_isa_kernels_avx512_vnni();
+    }
+
+    if (table == nullptr && jit::mayiuse(jit::avx512_core)) {
+        table = x86_isa_kernels_avx512();
+    }
+
+    if (table == nullptr && jit::mayiuse(jit::avx2)) {
+        table = x86_isa_kernels_avx2();
+    }
+
+    if (table == nullptr && jit::mayiuse(jit::sse42)) {
+        table = x86_isa_kernels_sse42();
+    }
+
+    if (table == nullptr) {
+        table = x86_isa_kernels_generic();
+    }
+
+    return table;
+}
+
+const X86IsaKernels& x86_isa_kernels() {
+    static const X86IsaKernels* table = select_x86_isa_kernels();
+    return *table;
+}
+
+void x86_isa_dispatch_init() {
+    LOG(INFO) << "x86 vector kernels use isa: " << x86_isa_kernels().isa_name;
+}
+
+static std::mutex& isa_record_mutex() {
+    static std::mutex mut;
+    return mut;
+}
+
+static std::map<std::string, std::string>& isa_record_map() {
+    static std::map<std::string, std::string> records;
+    return records;
+}
+
+void x86_isa_record(const std::string& op_type) {
+    std::lock_guard<std::mutex> lock(isa_record_mutex());
+    isa_record_map()[op_type] = x86_isa_kernels().isa_name;
+}
+
+std::string x86_isa_report() {
+    std::lock_guard<std::mutex> lock(isa_record_mutex());
+    std::ostringstream os;
+
+    for (auto& it : isa_record_map()) {
+        os << it.first << ": " << it.second << "\n";
+    }
+
+    return os.str();
+}
+
+} // namespace saber
+
+} // namespace anakin
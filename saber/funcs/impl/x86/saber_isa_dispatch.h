@@ -0,0 +1,115 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ANAKIN_SABER_FUNCS_IMPL_X86_SABER_ISA_DISPATCH_H
+#define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_ISA_DISPATCH_H
+
+#include <string>
+
+namespace anakin {
+
+namespace saber {
+
+/**
+ * \brief table of fp32 vector kernels, one table is compiled per cpu isa
+ * (saber_isa_kernels_<isa>.cpp, each with its own -m flags) and the best one
+ * supported by the running cpu is picked in Env<X86>::env_init.
+ * Only these kernels and the jit ones follow the running cpu, code guarded by
+ * __AVX2__ / __AVX512F__ elsewhere is fixed by the build flags, see BUILD_X86_ISA_DISPATCH.
+ * Still chosen at build time, so a portable build runs their sse or scalar path:
+ *   - Lstm, Lstmp, Gru and AttensionLstm (SABER_X86_TYPE, weights padded to its width)
+ *   - the mkl packed vender Lstm / Gru kernels and saber_avx2_funcs / saber_avx*_math.h
+ *   - intrinsic_gemm, intrinsic_packed_fc and the winograd engine
+ *   - Prelu of Activation, Scale, CosSim, CrfDecoding, the sequence concat / pool
+ *     kernels and the normal_activation helpers
+ */
+/// inner columns of one softmax_cols call at most, two cache lines
+const int kIsaSoftmaxCols = 32;
+/// rows of one small_gemm register block
+const int kIsaGemmRows = 4;
+
+/**
+ * operands of small_gemm, C = alpha * op(A) * op(B) + beta * C.
+ * op(A) is read in place, element (i, p) at a[i * a_rs + p * a_ks].
+ * op(B) is packed, row p at pb + p * pb_ld, zero padded to whole vectors of vec_width.
+ */
+struct IsaGemmOperands {
+    const float* a;
+    int a_rs;
+    int a_ks;
+    const float* pb;
+    int pb_ld;
+    float* c;
+    int ldc;
+    int k;
+    float alpha;
+    float beta;
+};
+
+struct X86IsaKernels {
+    const char* isa_name;
+    /// floats per vector register, 1 for the scalar table
+    int vec_width;
+    /// out[i] = max(in[i], 0)
+    void (*vector_relu)(const float* in, int len, float* out);
+    /// out[i] = 1 / (1 + exp(-in[i]))
+    void (*vector_sigmoid)(const float* in, int len, float* out);
+    /// out[i] = in[i] / (1 + |in[i]|)
+    void (*vector_soft_sign)(const float* in, int len, float* out);
+    /// out[i] = in_0[i] + in_1[i]
+    void (*vector_sum)(const float* in_0, const float* in_1, int len, float* out);
+    /// out[i] = in_0[i] - in_1[i]
+    void (*vector_sub)(const float* in_0, const float* in_1, int len, float* out);
+    /// out[i] = in_0[i] * in_1[i]
+    void (*vector_mul)(const float* in_0, const float* in_1, int len, float* out);
+    /// softmax (log softmax if log_out) of scale * in + mask over a contiguous row of n,
+    /// mask is nullptr or n values
+    void (*softmax_row)(const float* in, const float* mask, int n, float scale, bool log_out,
+                        float* out);
+    /// the same over axis_size rows stride floats apart, for cols <= kIsaSoftmaxCols adjacent
+    /// columns. mask rows are mask_axis_stride apart and hold the cols columns (mask_cols)
+    /// or one value broadcast over them
+    void (*softmax_cols)(const float* in, const float* mask, int mask_axis_stride, bool mask_cols,
+                         int axis_size, int stride, int cols, float scale, bool log_out,
+                         float* out);
+    /// rows [row_begin, row_end) of the n columns of C, register blocked, beta == 0 doesn't
+    /// read C
+    void (*small_gemm)(const IsaGemmOperands& op, int n, int row_begin, int row_end);
+};
+
+/// per isa tables, nullptr when the compiler could not build that isa
+const X86IsaKernels* x86_isa_kernels_generic();
+const X86IsaKernels* x86_isa_kernels_sse42();
+const X86IsaKernels* x86_isa_kernels_avx2();
+const X86IsaKernels* x86_isa_kernels_avx512();
+const X86IsaKernels* x86_isa_kernels_avx512_vnni();
+
+/// the table selected for this cpu
+const X86IsaKernels& x86_isa_kernels();
+
+/// select the table and log the choice, called by Env<X86>::env_init
+void x86_isa_dispatch_init();
+
+/// remember that op_type runs on the selected table
+void x86_isa_record(const std::string& op_type);
+
+/// "op_type: isa" lines for every recorded op
+std::string x86_isa_report();
+
+} // namespace saber
+
+} // namespace anakin
+
+#endif // ANAKIN_SABER_FUNCS_IMPL_X86_SABER_ISA_DISPATCH_H
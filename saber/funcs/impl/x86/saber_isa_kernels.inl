@@ -0,0 +1,416 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+/**
+ * Kernel bodies shared by every saber_isa_kernels_<isa>.cpp. The including
+ * file defines ANAKIN_ISA_NAME and, if the compiler flags of that file
+ * provide the isa, ANAKIN_ISA_ENABLED. The kernels are written once with the
+ * intrinsics of saber_isa_vec.inl, which picks the vector width of the isa of
+ * the translation unit.
+ *
+ * Everything here has internal linkage on purpose: an inline function
+ * shared with other translation units could be folded by the linker into
+ * the copy built with a wider isa and crash on older cpus. For the same
+ * reason no saber header with inline vector code is included here.
+ */
+
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+
+#define ANAKIN_ISA_CAT_(a, b) a##b
+#define ANAKIN_ISA_CAT(a, b) ANAKIN_ISA_CAT_(a, b)
+#define ANAKIN_ISA_STR_(a) #a
+#define ANAKIN_ISA_STR(a) ANAKIN_ISA_STR_(a)
+
+namespace anakin {
+
+namespace saber {
+
+#ifdef ANAKIN_ISA_ENABLED
+
+namespace {
+
+#include "saber/funcs/impl/x86/saber_isa_vec.inl"
+
+struct ReluOp {
+    template <typename V>
+    static typename V::type apply(typename V::type x) {
+        return V::max(x, V::zero());
+    }
+};
+
+struct SigmoidOp {
+    template <typename V>
+    static typename V::type apply(typename V::type x) {
+        typename V::type one = V::set1(1.f);
+        return V::div(one, V::add(one, V::exp(V::sub(V::zero(), x))));
+    }
+};
+
+struct SoftSignOp {
+    template <typename V>
+    static typename V::type apply(typename V::type x) {
+        return V::div(x, V::add(V::set1(1.f), V::abs(x)));
+    }
+};
+
+struct SumOp {
+    template <typename V>
+    static typename V::type apply(typename V::type a, typename V::type b) {
+        return V::add(a, b);
+    }
+};
+
+struct SubOp {
+    template <typename V>
+    static typename V::type apply(typename V::type a, typename V::type b) {
+        return V::sub(a, b);
+    }
+};
+
+struct MulOp {
+    template <typename V>
+    static typename V::type apply(typename V::type a, typename V::type b) {
+        return V::mul(a, b);
+    }
+};
+
+/// out[i] = Op(in[i]), whole vectors split over the threads, the tail is scalar
+template <typename Op>
+void isa_unary(const float* in, int len, float* out) {
+    typedef IsaVec V;
+    const int round = len / V::width * V::width;
+#pragma omp parallel for schedule(static)
+
+    for (int i = 0; i < round; i += V::width) {
+        V::store(out + i, Op::template apply<V>(V::load(in + i)));
+    }
+
+    for (int i = round; i < len; i++) {
+        out[i] = Op::template apply<ScalarVec>(in[i]);
+    }
+}
+
+/// out[i] = Op(in_0[i], in_1[i])
+template <typename Op>
+void isa_binary(const float* in_0, const float* in_1, int len, float* out) {
+    typedef IsaVec V;
+    const int round = len / V::width * V::width;
+#pragma omp parallel for schedule(static)
+
+    for (int i = 0; i < round; i += V::width) {
+        V::store(out + i, Op::template apply<V>(V::load(in_0 + i), V::load(in_1 + i)));
+    }
+
+    for (int i = round; i < len; i++) {
+        out[i] = Op::template apply<ScalarVec>(in_0[i], in_1[i]);
+    }
+}
+
+template <typename V>
+inline typename V::type logit(const float* in, const float* mask, typename V::type scale) {
+    typename V::type x = V::mul(V::load(in), scale);
+    return mask == nullptr ? x : V::add(x, V::load(mask));
+}
+
+/**
+ * pass 1 finds the max, pass 2 stores exp(l - max) (or l - max for log) and sums the exps,
+ * pass 3 normalizes.
+ */
+void isa_softmax_row(const float* in, const float* mask, int n, float scale, bool log_out,
+                     float* out) {
+    typedef IsaVec V;
+    typedef ScalarVec S;
+    const int round = n / V::width * V::width;
+    V::type vscale = V::set1(scale);
+    V::type vmax = V::set1(-FLT_MAX);
+
+    for (int i = 0; i < round; i += V::width) {
+        vmax = V::max(vmax, logit<V>(in + i, mask ? mask + i : nullptr, vscale));
+    }
+
+    float max = V::reduce_max(vmax);
+
+    for (int i = round; i < n; i++) {
+        max = S::max(max, logit<S>(in + i, mask ? mask + i : nullptr, scale));
+    }
+
+    V::type vmax_all = V::set1(max);
+    V::type vsum = V::zero();
+
+    for (int i = 0; i < round; i += V::width) {
+        V::type t = V::sub(logit<V>(in + i, mask ? mask + i : nullptr, vscale), vmax_all);
+        V::type e = V::exp(t);
+        vsum = V::add(vsum, e);
+        V::store(out + i, log_out ? t : e);
+    }
+
+    float sum = V::reduce_add(vsum);
+
+    for (int i = round; i < n; i++) {
+        float t = logit<S>(in + i, mask ? mask + i : nullptr, scale) - max;
+        float e = expf(t);
+        sum += e;
+        out[i] = log_out ? t : e;
+    }
+
+    if (log_out) {
+        float log_sum = logf(sum);
+        V::type vlog = V::set1(log_sum);
+
+        for (int i = 0; i < round; i += V::width) {
+            V::store(out + i, V::sub(V::load(out + i), vlog));
+        }
+
+        for (int i = round; i < n; i++) {
+            out[i] -= log_sum;
+        }
+    } else {
+        V::type vinv = V::set1(1.f / sum);
+
+        for (int i = 0; i < round; i += V::width) {
+            V::store(out + i, V::mul(V::load(out + i), vinv));
+        }
+
+        for (int i = round; i < n; i++) {
+            out[i] /= sum;
+        }
+    }
+}
+
+/// softmax over the axis of B * V::width adjacent columns, kept in registers between passes
+template <typename V, int B>
+void softmax_col_vecs(const float* in, const float* mask, int mask_axis_stride, bool mask_cols,
+                      int axis_size, int stride, float scale, bool log_out, float* out) {
+    typename V::type vscale = V::set1(scale);
+    typename V::type vmax[B];
+    typename V::type vsum[B];
+
+    for (int b = 0; b < B; b++) {
+        vmax[b] = V::set1(-FLT_MAX);
+        vsum[b] = V::zero();
+    }
+
+    for (int a = 0; a < axis_size; a++) {
+        const float* row = in + a * stride;
+        const float* mrow = mask ? mask + a * mask_axis_stride : nullptr;
+
+        for (int b = 0; b < B; b++) {
+            typename V::type x = V::mul(V::load(row + b * V::width), vscale);
+
+            if (mrow) {
+                x = V::add(x, mask_cols ? V::load(mrow + b * V::width) : V::set1(*mrow));
+            }
+
+            vmax[b] = V::max(vmax[b], x);
+        }
+    }
+
+    for (int a = 0; a < axis_size; a++) {
+        const float* row = in + a * stride;
+        const float* mrow = mask ? mask + a * mask_axis_stride : nullptr;
+        float* dst = out + a * stride;
+
+        for (int b = 0; b < B; b++) {
+            typename V::type x = V::mul(V::load(row + b * V::width), vscale);
+
+            if (mrow) {
+                x = V::add(x, mask_cols ? V::load(mrow + b * V::width) : V::set1(*mrow));
+            }
+
+            typename V::type t = V::sub(x, vmax[b]);
+            typename V::type e = V::exp(t);
+            vsum[b] = V::add(vsum[b], e);
+            V::store(dst + b * V::width, log_out ? t : e);
+        }
+    }
+
+    // log(sum) or 1 / sum per column
+    typename V::type vnorm[B];
+
+    for (int b = 0; b < B; b++) {
+        float sums[V::width];
+        V::store(sums, vsum[b]);
+
+        for (int k = 0; k < V::width; k++) {
+            sums[k] = log_out ? logf(sums[k]) : 1.f / sums[k];
+        }
+
+        vnorm[b] = V::load(sums);
+    }
+
+    for (int a = 0; a < axis_size; a++) {
+        float* dst = out + a * stride;
+
+        for (int b = 0; b < B; b++) {
+            typename V::type y = V::load(dst + b * V::width);
+            V::store(dst + b * V::width, log_out ? V::sub(y, vnorm[b]) : V::mul(y, vnorm[b]));
+        }
+    }
+}
+
+void isa_softmax_cols(const float* in, const float* mask, int mask_axis_stride, bool mask_cols,
+                      int axis_size, int stride, int cols, float scale, bool log_out, float* out) {
+    typedef IsaVec V;
+
+    if (cols == kIsaSoftmaxCols) {
+        softmax_col_vecs<V, kIsaSoftmaxCols / V::width>(in, mask, mask_axis_stride, mask_cols,
+                axis_size, stride, scale, log_out, out);
+        return;
+    }
+
+    int c = 0;
+
+    for (; c + V::width <= cols; c += V::width) {
+        softmax_col_vecs<V, 1>(in + c, mask && mask_cols ? mask + c : mask, mask_axis_stride,
+                               mask_cols, axis_size, stride, scale, log_out, out + c);
+    }
+
+    for (; c < cols; c++) {
+        softmax_col_vecs<ScalarVec, 1>(in + c, mask && mask_cols ? mask + c : mask,
+                                       mask_axis_stride, mask_cols, axis_size, stride, scale,
+                                       log_out, out + c);
+    }
+}
+
+/// vectors of columns of one small_gemm register block
+const int kGemmVecs = 2;
+
+/**
+ * C block of Rows x cols at (i, j), cols <= Vecs * width. the accumulators stay in
+ * registers for the whole k loop.
+ */
+template <int Rows, int Vecs>
+void gemm_block(const IsaGemmOperands& op, int i, int j, int cols) {
+    typedef IsaVec V;
+    V::type acc[Rows][Vecs];
+
+    for (int r = 0; r < Rows; r++) {
+        for (int v = 0; v < Vecs; v++) {
+            acc[r][v] = V::zero();
+        }
+    }
+
+    const float* a = op.a + i * op.a_rs;
+    const float* pb = op.pb + j;
+
+    for (int p = 0; p < op.k; p++) {
+        V::type b[Vecs];
+
+        for (int v = 0; v < Vecs; v++) {
+            b[v] = V::load(pb + p * op.pb_ld + v * V::width);
+        }
+
+        for (int r = 0; r < Rows; r++) {
+            V::type av = V::set1(a[r * op.a_rs + p * op.a_ks]);
+
+            for (int v = 0; v < Vecs; v++) {
+                acc[r][v] = V::fmadd(av, b[v], acc[r][v]);
+            }
+        }
+    }
+
+    V::type alpha = V::set1(op.alpha);
+    float* c = op.c + i * op.ldc + j;
+
+    if (cols == Vecs * V::width) {
+        V::type beta = V::set1(op.beta);
+
+        for (int r = 0; r < Rows; r++) {
+            for (int v = 0; v < Vecs; v++) {
+                float* dst = c + r * op.ldc + v * V::width;
+                V::type res = V::mul(acc[r][v], alpha);
+
+                if (op.beta != 0.f) {
+                    res = V::fmadd(beta, V::load(dst), res);
+                }
+
+                V::store(dst, res);
+            }
+        }
+    } else {
+        // column tail, through a buffer so the stores stay inside C
+        float tmp[Vecs * V::width];
+
+        for (int r = 0; r < Rows; r++) {
+            float* dst = c + r * op.ldc;
+
+            for (int v = 0; v < Vecs; v++) {
+                V::store(tmp + v * V::width, V::mul(acc[r][v], alpha));
+            }
+
+            for (int x = 0; x < cols; x++) {
+                dst[x] = op.beta != 0.f ? tmp[x] + op.beta * dst[x] : tmp[x];
+            }
+        }
+    }
+}
+
+typedef void (*GemmBlock)(const IsaGemmOperands&, int, int, int);
+
+const GemmBlock kGemmBlocks[kIsaGemmRows][kGemmVecs] = {
+    {gemm_block<1, 1>, gemm_block<1, 2>},
+    {gemm_block<2, 1>, gemm_block<2, 2>},
+    {gemm_block<3, 1>, gemm_block<3, 2>},
+    {gemm_block<4, 1>, gemm_block<4, 2>},
+};
+
+void isa_small_gemm(const IsaGemmOperands& op, int n, int row_begin, int row_end) {
+    const int block_cols = kGemmVecs * IsaVec::width;
+
+    for (int i = row_begin; i < row_end; i += kIsaGemmRows) {
+        int rows = row_end - i < kIsaGemmRows ? row_end - i : kIsaGemmRows;
+
+        for (int j = 0; j < n; j += block_cols) {
+            int cols = n - j < block_cols ? n - j : block_cols;
+            int vecs = (cols + IsaVec::width - 1) / IsaVec::width;
+            kGemmBlocks[rows - 1][vecs - 1](op, i, j, cols);
+        }
+    }
+}
+
+const X86IsaKernels isa_kernels = {
+    ANAKIN_ISA_STR(ANAKIN_ISA_NAME),
+    IsaVec::width,
+    isa_unary<ReluOp>,
+    isa_unary<SigmoidOp>,
+    isa_unary<SoftSignOp>,
+    isa_binary<SumOp>,
+    isa_binary<SubOp>,
+    isa_binary<MulOp>,
+    isa_softmax_row,
+    isa_softmax_cols,
+    isa_small_gemm,
+};
+
+} // namespace
+
+const X86IsaKernels* ANAKIN_ISA_CAT(x86_isa_kernels_, ANAKIN_ISA_NAME)() {
+    return &isa_kernels;
+}
+
+#else
+
+const X86IsaKernels* ANAKIN_ISA_CAT(x86_isa_kernels_, ANAKIN_ISA_NAME)() {
+    return nullptr;
+}
+
+#endif // ANAKIN_ISA_ENABLED
+
+} // namespace saber
+
+} // namespace anakin
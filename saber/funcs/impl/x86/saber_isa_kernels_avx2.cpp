@@ -0,0 +1,6 @@
+// compiled with the avx2 flags set in saber/CMakeLists.txt
+#define ANAKIN_ISA_NAME avx2
+#if defined(__AVX2__) && defined(__FMA__)
+#define ANAKIN_ISA_ENABLED
+#endif
+#include "saber/funcs/impl/x86/saber_isa_kernels.inl"
@@ -0,0 +1,6 @@
+// compiled with the avx512 flags set in saber/CMakeLists.txt
+#define ANAKIN_ISA_NAME avx512
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
+#define ANAKIN_ISA_ENABLED
+#endif
+#include "saber/funcs/impl/x86/saber_isa_kernels.inl"
@@ -0,0 +1,7 @@
+// compiled with the avx512_vnni flags set in saber/CMakeLists.txt
+#define ANAKIN_ISA_NAME avx512_vnni
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__AVX512DQ__) \
+    && defined(__AVX512VNNI__)
+#define ANAKIN_ISA_ENABLED
+#endif
+#include "saber/funcs/impl/x86/saber_isa_kernels.inl"
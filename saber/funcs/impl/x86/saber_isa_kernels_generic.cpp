@@ -0,0 +1,4 @@
+// baseline table, built with the global flags only
+#define ANAKIN_ISA_NAME generic
+#define ANAKIN_ISA_ENABLED
+#include "saber/funcs/impl/x86/saber_isa_kernels.inl"
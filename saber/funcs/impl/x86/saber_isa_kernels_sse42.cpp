@@ -0,0 +1,6 @@
+// compiled with the sse42 flags set in saber/CMakeLists.txt
+#define ANAKIN_ISA_NAME sse42
+#if defined(__SSE4_2__)
+#define ANAKIN_ISA_ENABLED
+#endif
+#include "saber/funcs/impl/x86/saber_isa_kernels.inl"
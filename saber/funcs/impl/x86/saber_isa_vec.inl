@@ -0,0 +1,196 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+/**
+ * Vector ops of the kernels in saber_isa_kernels.inl. IsaVec is the widest vector of
+ * the isa the including translation unit is built for, ScalarVec handles the tails.
+ * Included inside an anonymous namespace, so nothing here is shared between isas.
+ */
+
+struct ScalarVec {
+    typedef float type;
+    static const int width = 1;
+    static type load(const float* p) { return *p; }
+    static void store(float* p, type v) { *p = v; }
+    static type set1(float v) { return v; }
+    static type zero() { return 0.f; }
+    static type max(type a, type b) { return a > b ? a : b; }
+    static type add(type a, type b) { return a + b; }
+    static type sub(type a, type b) { return a - b; }
+    static type mul(type a, type b) { return a * b; }
+    static type div(type a, type b) { return a / b; }
+    static type fmadd(type a, type b, type c) { return a * b + c; }
+    static type abs(type a) { return a > 0.f ? a : -a; }
+    static type exp(type a) { return expf(a); }
+    static float reduce_max(type a) { return a; }
+    static float reduce_add(type a) { return a; }
+};
+
+// cephes expf: exp(x) = 2^n * exp(r), n = floor(x * log2(e) + 0.5), polynomial of r
+#define ISA_EXP_HI 88.3762626647949f
+#define ISA_EXP_LO -88.3762626647949f
+#define ISA_EXP_LOG2EF 1.44269504088896341f
+#define ISA_EXP_C1 0.693359375f
+#define ISA_EXP_C2 -2.12194440e-4f
+#define ISA_EXP_P0 1.9875691500E-4f
+#define ISA_EXP_P1 1.3981999507E-3f
+#define ISA_EXP_P2 8.3334519073E-3f
+#define ISA_EXP_P3 4.1665795894E-2f
+#define ISA_EXP_P4 1.6666665459E-1f
+#define ISA_EXP_P5 5.0000001201E-1f
+
+#if defined(__AVX512F__)
+
+inline __m512 isa_exp(__m512 x) {
+    x = _mm512_min_ps(x, _mm512_set1_ps(ISA_EXP_HI));
+    x = _mm512_max_ps(x, _mm512_set1_ps(ISA_EXP_LO));
+    __m512 fx = _mm512_floor_ps(_mm512_fmadd_ps(x, _mm512_set1_ps(ISA_EXP_LOG2EF),
+                                                _mm512_set1_ps(0.5f)));
+    x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(ISA_EXP_C1), x);
+    x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(ISA_EXP_C2), x);
+    __m512 y = _mm512_set1_ps(ISA_EXP_P0);
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(ISA_EXP_P1));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(ISA_EXP_P2));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(ISA_EXP_P3));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(ISA_EXP_P4));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(ISA_EXP_P5));
+    y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), x);
+    y = _mm512_add_ps(y, _mm512_set1_ps(1.f));
+    __m512i n = _mm512_add_epi32(_mm512_cvttps_epi32(fx), _mm512_set1_epi32(0x7f));
+    return _mm512_mul_ps(y, _mm512_castsi512_ps(_mm512_slli_epi32(n, 23)));
+}
+
+struct IsaVec {
+    typedef __m512 type;
+    static const int width = 16;
+    static type load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+    static type set1(float v) { return _mm512_set1_ps(v); }
+    static type zero() { return _mm512_setzero_ps(); }
+    static type max(type a, type b) { return _mm512_max_ps(a, b); }
+    static type add(type a, type b) { return _mm512_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+    static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+    static type div(type a, type b) { return _mm512_div_ps(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+    static type abs(type a) { return _mm512_abs_ps(a); }
+    static type exp(type a) { return isa_exp(a); }
+    static float reduce_max(type a) { return _mm512_reduce_max_ps(a); }
+    static float reduce_add(type a) { return _mm512_reduce_add_ps(a); }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+inline __m256 isa_exp(__m256 x) {
+    x = _mm256_min_ps(x, _mm256_set1_ps(ISA_EXP_HI));
+    x = _mm256_max_ps(x, _mm256_set1_ps(ISA_EXP_LO));
+    __m256 fx = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(ISA_EXP_LOG2EF),
+                                                _mm256_set1_ps(0.5f)));
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(ISA_EXP_C1), x);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(ISA_EXP_C2), x);
+    __m256 y = _mm256_set1_ps(ISA_EXP_P0);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(ISA_EXP_P1));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(ISA_EXP_P2));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(ISA_EXP_P3));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(ISA_EXP_P4));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(ISA_EXP_P5));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), x);
+    y = _mm256_add_ps(y, _mm256_set1_ps(1.f));
+    __m256i n = _mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(0x7f));
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(n, 23)));
+}
+
+struct IsaVec {
+    typedef __m256 type;
+    static const int width = 8;
+    static type load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    static type set1(float v) { return _mm256_set1_ps(v); }
+    static type zero() { return _mm256_setzero_ps(); }
+    static type max(type a, type b) { return _mm256_max_ps(a, b); }
+    static type add(type a, type b) { return _mm256_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+    static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+    static type div(type a, type b) { return _mm256_div_ps(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+    static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static type exp(type a) { return isa_exp(a); }
+    static float reduce_max(type a) {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_movehdup_ps(m));
+        return _mm_cvtss_f32(m);
+    }
+    static float reduce_add(type a) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_movehdup_ps(s));
+        return _mm_cvtss_f32(s);
+    }
+};
+
+#elif defined(__SSE4_2__)
+
+inline __m128 isa_exp(__m128 x) {
+    x = _mm_min_ps(x, _mm_set1_ps(ISA_EXP_HI));
+    x = _mm_max_ps(x, _mm_set1_ps(ISA_EXP_LO));
+    __m128 fx = _mm_floor_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(ISA_EXP_LOG2EF)),
+                                        _mm_set1_ps(0.5f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(ISA_EXP_C1)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(ISA_EXP_C2)));
+    __m128 y = _mm_set1_ps(ISA_EXP_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(ISA_EXP_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(ISA_EXP_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(ISA_EXP_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(ISA_EXP_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(ISA_EXP_P5));
+    y = _mm_add_ps(_mm_mul_ps(y, _mm_mul_ps(x, x)), x);
+    y = _mm_add_ps(y, _mm_set1_ps(1.f));
+    __m128i n = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f));
+    return _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(n, 23)));
+}
+
+struct IsaVec {
+    typedef __m128 type;
+    static const int width = 4;
+    static type load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, type v) { _mm_storeu_ps(p, v); }
+    static type set1(float v) { return _mm_set1_ps(v); }
+    static type zero() { return _mm_setzero_ps(); }
+    static type max(type a, type b) { return _mm_max_ps(a, b); }
+    static type add(type a, type b) { return _mm_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+    static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+    static type div(type a, type b) { return _mm_div_ps(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static type exp(type a) { return isa_exp(a); }
+    static float reduce_max(type a) {
+        __m128 m = _mm_max_ps(a, _mm_movehl_ps(a, a));
+        m = _mm_max_ss(m, _mm_movehdup_ps(m));
+        return _mm_cvtss_f32(m);
+    }
+    static float reduce_add(type a) {
+        __m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        s = _mm_add_ss(s, _mm_movehdup_ps(s));
+        return _mm_cvtss_f32(s);
+    }
+};
+
+#else
+
+typedef ScalarVec IsaVec;
+
+#endif
@@ -133,7 +133,7 @@ avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
     BIT(*cell_act)(const BIT) = Activate_inner<BIT>(param.cell_activity);
     BIT(*candi_act)(const BIT) = Activate_inner<BIT>(param.candidate_activity);
 
-    std::vector<int> offset_vec = inputs[0]->get_seq_offset()[inputs[0]->get_seq_offset().size() - 1];
+    const std::vector<int>& offset_vec = inputs[0]->get_seq_offset().back();
     //    std::vector<int> length_vec(offset_vec.size() - 1);
     int batch_size = offset_vec.size() - 1;
     int seqsum = inputs[0]->num();
@@ -154,9 +154,32 @@ avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
 
     const OpDataType* x = (const OpDataType*)inputs[0]->data();
     OpDataType* out = (OpDataType*)outputs[0]->mutable_data();
-    bool is_reverse = param.is_reverse;
 
-    if (inputs.size() > 1) {
+    if (param.state_hidden != nullptr) {
+        // streaming: every sequence goes on from the state its previous chunk left
+        if (param.skip_num > 1) {
+            LOG(ERROR) << "streaming state doesn't support skip mode";
+            return SaberInvalidValue;
+        }
+
+        CHECK_GE(param.state_hidden->valid_size(), batch_size * _hidden_size)
+                << "state_hidden needs one row per sequence";
+        utils::try_expand_tensor(_aligned_init_hidden, batch_size * _aligned_hidden_size);
+        aligned_utils.aligned_last_dim((const OpDataType*)param.state_hidden->data(),
+                                       (OpDataType*)_aligned_init_hidden.mutable_data(),
+                                       batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+        h_init = (const OpDataType*)_aligned_init_hidden.data();
+
+        if (param.state_cell != nullptr) {
+            CHECK_GE(param.state_cell->valid_size(), batch_size * _hidden_size)
+                    << "state_cell needs one row per sequence";
+            utils::try_expand_tensor(_aligned_init_cell, batch_size * _aligned_hidden_size);
+            aligned_utils.aligned_last_dim((const OpDataType*)param.state_cell->data(),
+                                           (OpDataType*)_aligned_init_cell.mutable_data(),
+                                           batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+            cell_init = (const OpDataType*)_aligned_init_cell.data();
+        }
+    } else if (inputs.size() > 1) {
         h_init = (const OpDataType*)inputs[1]->data();
         utils::try_expand_tensor(_aligned_init_hidden, batch_size * _aligned_hidden_size);
         aligned_utils.aligned_last_dim(h_init, (OpDataType*)_aligned_init_hidden.mutable_data(),
@@ -172,9 +195,9 @@ avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
         //        cell_init=_aligned_init_celll.data();
     }
 
-    std::vector<int> emit_offset_vec;
+    std::vector<int>& emit_offset_vec = _emit_offset_vec;
     int emit_length = 0;
-    utils::SeqSortedseqTranseUtil transe_util(is_reverse);
+    utils::SeqSortedseqTranseUtil& transe_util = _seq_util;
     bool transform = transe_util.get_sorted_map(offset_vec, emit_offset_vec, emit_length,
                      param.skip_num);
 
@@ -217,6 +240,12 @@ avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
     inner_cell = (OpDataType*)_temp_cell.mutable_data();
     memset(inner_cell, 0, _temp_cell.valid_size()* sizeof(OpDataType));
 
+    if (cell_init != nullptr && transform) {
+        transe_util.hidden_2_sorted_hidden(cell_init, inner_cell, _aligned_hidden_size);
+    } else if (cell_init != nullptr) {
+        memcpy(inner_cell, cell_init, batch_size * _aligned_hidden_size * sizeof(OpDataType));
+    }
+
     OpDataType* temp_wh = (OpDataType*)_temp_wh.mutable_data();
     OpDataType* temp_wx = (OpDataType*)_temp_wx.mutable_data();
 
@@ -292,6 +321,25 @@ avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
                                          _aligned_hidden_size);
     }
 
+    if (param.state_hidden != nullptr) {
+        transe_util.seq_last_hidden((const OpDataType*)out,
+                                    (OpDataType*)param.state_hidden->mutable_data(), offset_vec, _hidden_size);
+    }
+
+    if (cell_init != nullptr) {
+        // the cells of the batch stay in emit order, the rows of ended sequences are final
+        const OpDataType* final_cell = inner_cell;
+
+        if (transform) {
+            transe_util.sorted_hidden_2_hidden(inner_cell, (OpDataType*)_aligned_init_cell.mutable_data(),
+                                               _aligned_hidden_size);
+            final_cell = (const OpDataType*)_aligned_init_cell.data();
+        }
+
+        aligned_utils.unaligned_last_dim(final_cell, (OpDataType*)param.state_cell->mutable_data(),
+                                         batch_size * _hidden_size, _hidden_size, _aligned_hidden_size);
+    }
+
     return SaberSuccess;
 }
 
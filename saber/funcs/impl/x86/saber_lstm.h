@@ -86,6 +86,7 @@ public:
         const float* weight_w = (const float*)_aligned_weights_i2h.data();
         _wx_gemm_fp32.init(false, false,seqsum, 4 * _aligned_hidden_size, _word_size,ctx,weight_w,PACKED_MKLGEMM);
         _wh_gemm_fp32.init(false, false,seqsum, 4 * _aligned_hidden_size, _aligned_hidden_size,ctx,weight_h,PACKED_MKLGEMM);
+        _seq_util = utils::SeqSortedseqTranseUtil(param.is_reverse);
 
         return create(inputs,outputs,param,ctx);
     } ;
@@ -121,6 +122,7 @@ private:
     Tensor<X86> _aligned_weights_peephole;
 
     Tensor<X86> _aligned_init_hidden;
+    Tensor<X86> _aligned_init_cell;
 
     Tensor<X86> _temp_wx;
     Tensor<X86> _temp_wh;
@@ -133,6 +135,10 @@ private:
     MklDnnGemm<float, float, float> _wx_gemm_fp32;
     MklDnnGemm<float, float, float> _wh_gemm_fp32;
 
+    ///< batch sorting of dispatch, kept so its buffers are reused
+    utils::SeqSortedseqTranseUtil _seq_util;
+    std::vector<int> _emit_offset_vec;
+
     template <typename BIT,bool with_peephole >
     SaberStatus avx_dispatch(const std::vector<Tensor<X86>*>& inputs,
                                               std::vector<Tensor<X86>*>& outputs,
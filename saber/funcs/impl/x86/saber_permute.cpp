@@ -65,12 +65,13 @@ SaberStatus SaberPermute<X86, AK_FLOAT>::\
         }
         const float* src_ptr = static_cast<const float*>(inputs[0] -> data());
         float* dst_ptr = static_cast<float*>(outputs[0] -> mutable_data());
-        std::vector<int> orders = param.order;
+        // order, strides and output shape are kept by init/create, no vector is built per call
+        const int* orders = static_cast<const int*>(_permute_order.data());
         int out_size = outputs[0] -> valid_size();
         int num_axes = inputs[0] -> valid_shape().size();
-        std::vector<int> new_steps = outputs[0] -> get_stride();
-        std::vector<int> old_steps = inputs[0] -> get_stride();
-        std::vector<int> new_valid_shape = outputs[0] -> valid_shape();
+        const int* new_steps = static_cast<const int*>(_out_steps.data());
+        const int* old_steps = static_cast<const int*>(_in_steps.data());
+        const int* new_valid_shape = static_cast<const int*>(_out_valid_shape.data());
         if (inputs[0]->is_continue_mem() && outputs[0]->is_continue_mem()){
             for (int j=0; j<out_size; ++j){
                 int in_idx = 0;
@@ -1,48 +1,81 @@
 #include "saber/funcs/impl/x86/saber_sequence_conv.h"
 #include "saber/saber_funcs_param.h"
 #include "saber/core/tensor_op.h"
-#include "mkl_cblas.h"
-#ifdef USE_SGX
-extern "C" void mkl_free_buffers();
-#endif
+#include "saber/funcs/saber_util.h"
+#include "saber/funcs/impl/x86/saber_normal_activation.h"
+#include <algorithm>
+#include <cstring>
 
 namespace anakin {
 namespace saber {
 
-static void gemm(const bool TransA, const bool TransB, int m, int n, int k, const float alpha,
-                 const float* a, const float* b, const float beta, float* c) {
-
-    int lda = (!TransA) ? k : m;
-    int ldb = (!TransB) ? n : k;
-    CBLAS_TRANSPOSE cuTransA =
-        (!TransA) ? CblasNoTrans : CblasTrans;
-    CBLAS_TRANSPOSE cuTransB =
-        (!TransB) ? CblasNoTrans : CblasTrans;
-    cblas_sgemm(CblasRowMajor, cuTransA, cuTransB, m, n, k, alpha, a, k, b, n, beta, c, n);
-#ifdef USE_SGX
-    mkl_free_buffers();
-#endif
-};
-
+/**
+ * \brief context window im2col, one row per word, rows of a word are
+ * [zero head | words inside its sequence | zero tail], the middle part is
+ * contiguous in the input so every row is a memset + memcpy + memset
+ */
 template <typename Dtype>
-static void im2col_2d_ocf(const Dtype* in, int stride, int pad_up, int pad_down, int kernel_size,
-                          Dtype* out, int seq_length, int hidden_size) {
-    for (int out_row = 0; out_row < seq_length; ++out_row) {
-        for (int col = 0; col < kernel_size; ++col) {
-            int index = out_row + col - pad_up;
-            int out_index = (out_row * kernel_size + col) * hidden_size;
-
-            for (int hidden_index = 0; hidden_index < hidden_size; ++hidden_index) {
-                if (index < 0 || index >= seq_length) {
-                    out[out_index + hidden_index] = 0;
-                } else {
-                    out[out_index + hidden_index] = in[index * hidden_size + hidden_index];
-                }
+static void im2col_context(const Dtype* in, const std::vector<int>& offset, int context_start,
+                           int context_length, int hidden_size, Dtype* out) {
+    const int word_num = offset[offset.size() - 1];
+    const int kernel_size = context_length * hidden_size;
+#pragma omp parallel for schedule(static)
+
+    for (int word_id = 0; word_id < word_num; ++word_id) {
+        // the sequence this word belongs to, the window never crosses it
+        int seq_id = std::upper_bound(offset.begin(), offset.end(), word_id) - offset.begin() - 1;
+        int seq_start = offset[seq_id];
+        int seq_end = offset[seq_id + 1];
+        int first = word_id + context_start;
+        int valid_start = std::max(first, seq_start);
+        int valid_end = std::min(first + context_length, seq_end);
+        valid_end = std::max(valid_end, valid_start);
+        int head = (valid_start - first) * hidden_size;
+        int body = (valid_end - valid_start) * hidden_size;
+        Dtype* out_row = out + word_id * kernel_size;
+        memset(out_row, 0, sizeof(Dtype) * head);
+        memcpy(out_row + head, in + valid_start * hidden_size, sizeof(Dtype) * body);
+        memset(out_row + head + body, 0, sizeof(Dtype) * (kernel_size - head - body));
+    }
+}
+
+template <typename Dtype, Dtype (*Act)(const Dtype)>
+static void bias_act(Dtype* out, const Dtype* bias, int word_num, int feature_size) {
+#pragma omp parallel for schedule(static)
+
+    for (int word_id = 0; word_id < word_num; ++word_id) {
+        Dtype* out_row = out + word_id * feature_size;
+
+        if (bias != nullptr) {
+            for (int i = 0; i < feature_size; ++i) {
+                out_row[i] = Act(out_row[i] + bias[i]);
+            }
+        } else {
+            for (int i = 0; i < feature_size; ++i) {
+                out_row[i] = Act(out_row[i]);
             }
         }
     }
 }
 
+template <DataType OpDtype>
+SaberStatus SaberSequenceConv<X86, OpDtype>::create(
+    const std::vector<DataTensor_in*>& inputs,
+    std::vector<DataTensor_out*>& outputs,
+    SequenceConvParam<X86>& param,
+    Context<X86>& ctx) {
+    const float* filter = static_cast<const float*>(param.filter_tensor->data());
+
+    if (filter != _packed_filter) {
+        int word_num = std::max(1, inputs[0]->num());
+        _gemm.init(false, false, word_num, _feature_size, _hidden_kernel_size, ctx, filter,
+                   PACKED_MKLGEMM);
+        _packed_filter = filter;
+    }
+
+    return SaberSuccess;
+}
+
 template <DataType OpDtype>
 SaberStatus SaberSequenceConv<X86, OpDtype>::dispatch(
     const std::vector<DataTensor_in*>& inputs,
@@ -50,35 +83,47 @@ SaberStatus SaberSequenceConv<X86, OpDtype>::dispatch(
     SequenceConvParam<X86>& param) {
     DataTensor_in* in_data = inputs[0];
     DataTensor_out* out_data = outputs[0];
-    bool bias_term = param.bias_term;
-    std::vector<int> offset = in_data->get_seq_offset()[0];
-    
+    const std::vector<int>& offset = in_data->get_seq_offset()[0];
+
     int word_num = offset[offset.size() - 1];
     Shape sh_im({1, 1, word_num, param.filter_tensor->height()});
-    _temp_im2col_tensor.re_alloc(sh_im, AK_FLOAT);
-
-    for (int i = 0; i < offset.size() - 1; ++i) {
-        int start = offset[i];
-        int seq_length = offset[i + 1] - offset[i];
-        im2col_2d_ocf<float>((const float *)in_data->data() + _hidden_size * start, param.context_stride, _up_pad, _down_pad,
-                      param.context_length, (float*)_temp_im2col_tensor.mutable_data() + _hidden_kernel_size * start, seq_length,
-                      _hidden_size);
-    }
+    utils::try_expand_tensor(_temp_im2col_tensor, sh_im);
+
+    float* im2col = static_cast<float*>(_temp_im2col_tensor.mutable_data());
+    im2col_context(static_cast<const float*>(in_data->data()), offset, param.context_start,
+                   param.context_length, _hidden_size, im2col);
+
+    auto output_ptr = static_cast<float*>(out_data->mutable_data());
+    _gemm.dispatch(1.f, 0.f, word_num, im2col, static_cast<const float*>(param.filter_tensor->data()),
+                   output_ptr);
 
-    gemm(false, false, word_num, _feature_size, _hidden_kernel_size, 1.f, static_cast<const float*>(_temp_im2col_tensor.data()),
-         static_cast<const float*>(param.filter_tensor->data()), 0.f, static_cast<float*>(out_data->mutable_data()));
-    auto output_ptr=static_cast<float*>(out_data->mutable_data());
-    if (bias_term) {
-        auto bias_ptr= static_cast<float*>(param.bias_tensor->mutable_data());
-        for (int out_id=0; out_id<word_num; out_id++) {
-            for (int inner_id=0; inner_id<_feature_size; inner_id++) {
-                output_ptr[out_id*_feature_size+inner_id] += bias_ptr[inner_id];
-            } 
+    const float* bias_ptr = param.bias_term ? static_cast<const float*>(param.bias_tensor->data()) :
+                            nullptr;
+
+    switch (param.active_type) {
+    case Active_relu:
+        bias_act<float, Relu<float>>(output_ptr, bias_ptr, word_num, _feature_size);
+        break;
+
+    case Active_sigmoid:
+        bias_act<float, Sigmoid<float>>(output_ptr, bias_ptr, word_num, _feature_size);
+        break;
+
+    case Active_tanh:
+        bias_act<float, Tanh<float>>(output_ptr, bias_ptr, word_num, _feature_size);
+        break;
+
+    default:
+        if (bias_ptr != nullptr) {
+            bias_act<float, Identity<float>>(output_ptr, bias_ptr, word_num, _feature_size);
         }
+
+        break;
     }
-    std::vector<std::vector<int>> voffset;
-    voffset.push_back(offset);
-    out_data->set_seq_offset(voffset);
+
+    _out_offset.resize(1);
+    _out_offset[0] = offset;
+    out_data->set_seq_offset(_out_offset);
     return SaberSuccess;
 }
 DEFINE_OP_TEMPLATE(SaberSequenceConv, SequenceConvParam, X86, AK_HALF);
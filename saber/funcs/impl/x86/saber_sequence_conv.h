@@ -16,6 +16,7 @@
 #define ANAKIN_SABER_FUNCS_IMPL_X86_SABER_SEQUENCE_CONV_H
 
 #include "saber/funcs/impl/impl_sequence_conv.h"
+#include "saber/funcs/impl/x86/mkl_gemm.h"
 #include "saber/saber_funcs_param.h"
 
 
@@ -44,28 +45,35 @@ public:
         this->_ctx = &ctx;
         CHECK_EQ(param.padding_trainable, false) << "not support padding_trainable==true";
         CHECK_EQ(param.context_stride, 1) << "not support context_stride!=1";
-	CHECK_EQ(param.padding_tensor == nullptr, true) << "not support padding_tensor";
+        CHECK_EQ(param.padding_tensor == nullptr, true) << "not support padding_tensor";
+        CHECK(param.active_type == Active_unknow || param.active_type == Active_identity
+              || param.active_type == Active_relu || param.active_type == Active_sigmoid
+              || param.active_type == Active_tanh) << "not support fused active " << param.active_type;
         CHECK_NOTNULL(param.filter_tensor);
         _hidden_size = param.filter_tensor->height() / param.context_length;
         _feature_size = param.filter_tensor->width();
         _up_pad = std::max(0, -param.context_start);
         _down_pad = std::max(0, param.context_start + param.context_length - 1);
         _hidden_kernel_size = _hidden_size * param.context_length;
+        // weights are packed once here, create only repacks if they move
+        _packed_filter = nullptr;
         return create(inputs, outputs, param, ctx);
     };
 
     virtual SaberStatus create(const std::vector<DataTensor_in*>& inputs,
                                std::vector<DataTensor_out*>& outputs,
                                SequenceConvParam<X86>& param,
-                               Context<X86>& ctx) {
-        return SaberSuccess;
-    };
+                               Context<X86>& ctx);
 
     virtual SaberStatus dispatch(const std::vector<DataTensor_in*>& inputs,
                                  std::vector<DataTensor_out*>& outputs,
                                  SequenceConvParam<X86>& param);
 private:
     OpTensor _temp_im2col_tensor;
+    MklDnnGemm<float, float, float> _gemm;
+    const float* _packed_filter{nullptr};
+    ///< seq offset of the output, kept so dispatch doesn't allocate
+    std::vector<std::vector<int>> _out_offset;
     int _hidden_size;
     int _feature_size;
     int _hidden_kernel_size;
@@ -1,8 +1,6 @@
 #include "saber/funcs/impl/x86/saber_soft_sign.h"
 #include "mkl.h"
-#if defined(__AVX2__) and defined(__FMA__)
-#include "saber/funcs/impl/x86/saber_avx2_funcs.h"
-#endif
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
 #include <cmath>
 
 namespace anakin{
@@ -15,6 +13,7 @@ SaberStatus SaberSoftSign<X86, OpDtype>::init(
         SoftSignParam<X86> &param,
         Context<X86> &ctx) {
     this->_ctx = &ctx;
+    x86_isa_record("SoftSign");
     return create(inputs, outputs, param, ctx);
 }
 
@@ -38,15 +37,7 @@ SaberStatus SaberSoftSign<X86, OpDtype>::dispatch(
         size_t len = inputs[vc]->valid_size();
         OpDataType *input_data = (OpDataType*)inputs[vc]->mutable_data();
         OpDataType *output_data = (OpDataType*)outputs[vc]->mutable_data();
-//#if defined(__AVX2__) and defined(__FMA__)
-//        avx2_vector_soft_sign(input_data, len, output_data);
-//#else
-#pragma omp parallel for schedule(static)
-        for (size_t i = 0; i < len; i++) {
-            OpDataType tmp = input_data[i] > 0 ? input_data[i] : -input_data[i];
-            output_data[i] = input_data[i] / (1 + tmp);
-        }
-//#endif
+        x86_isa_kernels().vector_soft_sign(input_data, len, output_data);
     }
 
     return SaberSuccess;
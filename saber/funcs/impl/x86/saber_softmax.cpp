@@ -1,9 +1,7 @@
 #include "saber/funcs/impl/x86/saber_softmax.h"
-#include <cmath>
-#include "saber/funcs/impl/x86/saber_avx2_funcs.h"
-#include "mkl_cblas.h"
-#include "mkl_vml_functions.h"
-#include "saber/funcs/impl/x86/kernel/jit_generator.h"
+#include <algorithm>
+#include "saber/funcs/impl/x86/saber_isa_dispatch.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
 namespace anakin {
 namespace saber {
 
@@ -13,6 +11,7 @@ SaberStatus SaberSoftmax<X86, OpDtype>::init(
     std::vector<DataTensor_out*>& outputs,
     SoftmaxParam<X86>& param, Context<X86>& ctx) {
     this->_ctx = &ctx;
+    x86_isa_record("Softmax");
     if (inputs[0]->get_dtype() != AK_FLOAT) {
         _input_scale.re_alloc(inputs[0]->valid_shape(), AK_FLOAT);
     }
@@ -30,93 +29,66 @@ SaberStatus SaberSoftmax<X86, OpDtype>::create(
     _outer_num = inputs[0]->count_valid(0, param.axis);
     _inner_num = inputs[0]->count_valid(param.axis + 1, inputs[0]->dims());
     _axis_size = shape_in[param.axis];
-    _max_data.reshape(Shape({1, 1, 1, _axis_size}));
     _dims = shape_in.size();
-    Shape sh({1, 1, 1, _dims});
-    _input_stride.reshape(sh);
-    _output_stride.reshape(sh);
-    memcpy(_input_stride.mutable_data(), (inputs[0]->get_stride()).data(), sizeof(int) * _dims);
-    memcpy(_output_stride.mutable_data(), (outputs[0]->get_stride()).data(), sizeof(int) * _dims);
+    _mask_stride.clear();
+    _mask_cols = false;
 
-    if (inputs[0]->get_dtype() != AK_FLOAT) {
-        utils::try_expand_tensor(_input_scale, inputs[0]->valid_shape());
-    }
-    return SaberSuccess;
-}
+    if (inputs.size() > 1) {
+        // additive mask, numpy style broadcast: every dim equal to the input's or 1
+        Shape shape_mask = inputs[1]->valid_shape();
 
-template <typename dtype>
-void _max(int n, const dtype* x, dtype* output_max_data) {
-//    print_vec(x,n,"max");
-    dtype max_data = x[0];
-    for (int c = 1; c < n; ++c) {
-        max_data = max_data > x[c] ? max_data : x[c];
-    }
+        if (inputs[1]->get_dtype() != AK_FLOAT || shape_mask.size() != _dims) {
+            LOG(ERROR) << "softmax mask must be fp32 with the dims of the input";
+            return SaberInvalidValue;
+        }
 
-    output_max_data[0] = max_data;
-}
-template <typename dtype>
-void _sub(int n, dtype alpha, const dtype* x, dtype* y) {
-    for (int c = 0; c < n; ++c) {
-        y[c] = x[c] - alpha;
-    }
-}
+        _mask_stride.resize(_dims, 0);
+        int stride = 1;
 
-template <typename dtype>
-void _exp(int n, const dtype* a, dtype* r) {
-#if 1
-    vsExp(n, a, r);
-#else
-    #pragma omp parallel for
+        for (int i = _dims - 1; i >= 0; --i) {
+            if (shape_mask[i] != 1 && shape_mask[i] != shape_in[i]) {
+                LOG(ERROR) << "softmax mask dim " << i << " is " << shape_mask[i]
+                           << ", expect 1 or " << shape_in[i];
+                return SaberInvalidValue;
+            }
 
-    for (int c = 0; c < n; ++c) {
-        r[c] = expf(a[c]);
-    }
+            _mask_stride[i] = shape_mask[i] == 1 ? 0 : stride;
+            stride *= shape_mask[i];
+        }
 
-#endif
-}
+        int mask_inner = inputs[1]->count_valid(param.axis + 1, _dims);
 
-template <typename dtype>
-void _sum(int n, const dtype* x, dtype* sum_data) {
-    dtype sum = 0;
-    for (int c = 0; c < n; ++c) {
-        sum += x[c];
-    }
+        // the kernels read a mask row either whole or as one broadcast value
+        if (mask_inner != 1 && mask_inner != _inner_num) {
+            LOG(ERROR) << "softmax mask must broadcast all or none of the dims after the axis";
+            return SaberUnImplError;
+        }
 
-    sum_data[0] = sum;
-}
-template <typename dtype>
-void _scal(int n, dtype alpha, dtype* x) {
-#if 0
-    cblas_sscal(n, alpha, x, 1);
-#else
-    for (int c = 0; c < n; ++c) {
-        x[c] *= alpha;
+        _mask_cols = _inner_num > 1 && mask_inner == _inner_num;
     }
 
-#endif
+    if (inputs[0]->get_dtype() != AK_FLOAT) {
+        utils::try_expand_tensor(_input_scale, inputs[0]->valid_shape());
+    }
+    return SaberSuccess;
 }
 
-
-
 template <DataType OpDtype>
 SaberStatus SaberSoftmax<X86, OpDtype>::dispatch(
     const std::vector<DataTensor_in*>& inputs,
     std::vector<DataTensor_out*>& outputs,
     SoftmaxParam<X86>& param) {
 
-    typedef typename DataTrait<X86, OpDtype>::Dtype OpDataType;
     int axis = param.axis;
     Shape sh_in = inputs[0]->valid_shape();
-    Shape sh_out = outputs[0]->valid_shape();
 
     if (sh_in.get_layout() == Layout_NHWC) {
         sh_in = Shape({sh_in.num(), sh_in.channel(), sh_in.height(), sh_in.width()});
     }
 
-    int axis_size = sh_in[axis];
-    int outer_dim = sh_in.count(0, param.axis);
-    int inner_dim = sh_in.count(param.axis + 1, inputs[0]->dims());
-    int batch_size = outer_dim * inner_dim;
+    const int axis_size = sh_in[axis];
+    const int outer_dim = sh_in.count(0, param.axis);
+    const int inner_dim = sh_in.count(param.axis + 1, inputs[0]->dims());
     const float* src_ptr = nullptr;
     float* dst_ptr = (float*) outputs[0]->mutable_data();
     outputs[0]->set_seq_offset(inputs[0]->get_seq_offset());
@@ -124,71 +96,76 @@ SaberStatus SaberSoftmax<X86, OpDtype>::dispatch(
     if (inputs[0]->get_dtype() == AK_FLOAT) {
         src_ptr = static_cast<const float*>(inputs[0]->data());
     } else if (inputs[0]->get_dtype() == AK_UINT8) {
-                DLOG(INFO) << "dispatch convert uint8 fp32";
+        DLOG(INFO) << "dispatch convert uint8 fp32";
         utils::ScaleUtils::scale_uint8_fp32(_input_scale, *inputs[0]);
         src_ptr = static_cast<const float*>(_input_scale.data());
-    }else{
-        LOG(INFO)<<"not support input "<<inputs[0]->get_dtype();
+    } else {
+        LOG(ERROR) << "not support input " << inputs[0]->get_dtype();
+        return SaberUnImplError;
     }
-    if (avx2_can_used()){
-#if defined(__AVX2__) and defined(__FMA__)
-#pragma omp parallel for schedule(static) if(outer_dim>1)
-        for(int outer_id=0; outer_id<outer_dim; outer_id++){
-            const float* src_data_outer = src_ptr + outer_id * axis_size*inner_dim;
-            float* dst_data_outer = dst_ptr + outer_id * axis_size*inner_dim;
-            if (inner_dim == 1){
-                avx2_vector_softmax(src_data_outer, axis_size, dst_data_outer);
-            }else{
-                avx2_vector_softmax_stride(src_data_outer, inner_dim, axis_size, dst_data_outer);
-            }
+
+    const float* mask_ptr = nullptr;
+    int mask_axis_stride = 0;
+    bool mask_cols = false;
+
+    if (!_mask_stride.empty()) {
+        mask_ptr = static_cast<const float*>(inputs[1]->data());
+        mask_axis_stride = _mask_stride[axis];
+        mask_cols = _mask_cols;
+
+        // a mask constant along the axis shifts every logit of a row equally, softmax ignores it
+        if (mask_axis_stride == 0) {
+            mask_ptr = nullptr;
         }
-#endif
-    } else {
-        const OpDataType *data_in = (const OpDataType *) inputs[0]->data();
-        OpDataType *data_out = (OpDataType *) outputs[0]->mutable_data();
-        OpDataType *max_data = (OpDataType *) this->_max_data.mutable_data();
-        const int *input_stride = (const int *) _input_stride.data();
-        const int *output_stride = (const int *) _output_stride.data();
-        int total_num = _inner_num * _outer_num;
-
-        for (int num = 0; num < total_num; ++num) {
-            int num_tmp = num;
-            int in_index = 0, out_index = 0;
-
-            for (int i = _dims - 1; i >= 0; --i) {
-                if (i == axis) {
-                    continue;
-                }
+    }
 
-                int pos = num_tmp % sh_in[i];
-                in_index += pos * input_stride[i];
-                out_index += pos * output_stride[i];
-                num_tmp /= sh_in[i];
-            }
+    const float scale = param.scale;
+    const bool log_out = param.log_softmax;
+    const int* mask_stride = _mask_stride.data();
+    const int* dims = &sh_in[0];
+    const X86IsaKernels& kernels = x86_isa_kernels();
 
-            OpDataType max = std::numeric_limits<OpDataType>::lowest();
+    // offset of the mask rows of outer index o
+    auto mask_outer = [=](int o) {
+        int offset = 0;
 
-            for (int i = 0; i < _axis_size; ++i) {
-                max = data_in[in_index] > max ? data_in[in_index] : max;
-                in_index += input_stride[axis];
-            }
+        for (int i = axis - 1; i >= 0; --i) {
+            offset += (o % dims[i]) * mask_stride[i];
+            o /= dims[i];
+        }
 
-            OpDataType sum = (OpDataType) 0;
+        return offset;
+    };
 
-            for (int i = 0; i < _axis_size; ++i) {
-                in_index -= input_stride[axis];
-                max_data[_axis_size - i - 1] = expf(data_in[in_index] - max);
-                sum += max_data[_axis_size - i - 1];
-            }
+    if (inner_dim == 1) {
+        #pragma omp parallel for schedule(static) if(outer_dim > 1)
+        for (int o = 0; o < outer_dim; o++) {
+            kernels.softmax_row(src_ptr + (size_t)o * axis_size,
+                                mask_ptr ? mask_ptr + mask_outer(o) : nullptr,
+                                axis_size, scale, log_out, dst_ptr + (size_t)o * axis_size);
+        }
+    } else {
+        // blocks of adjacent inner columns, parallel over outer x blocks
+        const int blocks = (inner_dim + kIsaSoftmaxCols - 1) / kIsaSoftmaxCols;
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int o = 0; o < outer_dim; o++) {
+            for (int b = 0; b < blocks; b++) {
+                const int col = b * kIsaSoftmaxCols;
+                const int cols = std::min(kIsaSoftmaxCols, inner_dim - col);
+                const size_t offset = (size_t)o * axis_size * inner_dim + col;
+                const float* mask = nullptr;
+
+                if (mask_ptr) {
+                    mask = mask_ptr + mask_outer(o) + (mask_cols ? col : 0);
+                }
 
-            for (int i = 0; i < _axis_size; ++i) {
-                data_out[out_index] = max_data[i] / sum;
-                out_index += output_stride[axis];
+                kernels.softmax_cols(src_ptr + offset, mask, mask_axis_stride, mask_cols,
+                                     axis_size, inner_dim, cols, scale, log_out, dst_ptr + offset);
             }
         }
     }
 
-
     return SaberSuccess;
 }
 template class SaberSoftmax<X86, AK_FLOAT>;
@@ -196,4 +173,3 @@ DEFINE_OP_TEMPLATE(SaberSoftmax, SoftmaxParam, X86, AK_HALF);
 DEFINE_OP_TEMPLATE(SaberSoftmax, SoftmaxParam, X86, AK_INT8);
 }
 } // namespace anakin
-
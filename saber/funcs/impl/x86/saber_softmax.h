@@ -20,6 +20,13 @@
 namespace anakin{
 namespace saber {
 
+/**
+ * \brief softmax or log softmax over param.axis of scale * input + mask.
+ *  the mask is an optional second fp32 input, broadcast numpy style to the input, except that
+ *  the dims after the axis are broadcast all or none. rows along a contiguous axis are one
+ *  vector pass each, strided axes are reduced over blocks of adjacent inner columns; both are
+ *  parallel over the rows / outer x column blocks.
+ */
 template <DataType OpDtype>
 class SaberSoftmax<X86, OpDtype> : 
     public ImplBase<X86, OpDtype, SoftmaxParam<X86>> 
@@ -54,9 +61,10 @@ private:
     int _outer_num;
     int _axis_size;
     int _dims;
-    Tensor<X86> _input_stride;
-    Tensor<X86> _output_stride;
-    Tensor<X86> _max_data;
+    ///< element strides of the mask in the input's index space, 0 on broadcast dims
+    std::vector<int> _mask_stride;
+    ///< mask rows span the inner dims instead of one broadcast value
+    bool _mask_cols{false};
     Tensor<X86> _input_scale;
 };
 
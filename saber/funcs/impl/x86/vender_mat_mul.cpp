@@ -1,4 +1,5 @@
 #include "saber/funcs/impl/x86/vender_mat_mul.h"
+#include "saber/funcs/impl/x86/saber_batch_gemm.h"
 
 
 namespace anakin{
@@ -16,6 +17,12 @@ SaberStatus SaberMatMul<X86, OpDtype>::dispatch(
     const OpDataType* src1 = (OpDataType*)inputs[1]->data();
     OpDataType* dst = (OpDataType*)outputs[0]->mutable_data();
  
+    if (use_batch_small_gemm(M, N, K)) {
+        batch_small_gemm_strided(transa == CblasTrans, transb == CblasTrans, M, N, K, alpha,
+                                 src0, lda, M * K, src1, ldb, K * N, beta, dst, ldc, M * N, batch);
+        return SaberSuccess;
+    }
+
     for (int i = 0; i < batch; i++) {
         
         cblas_sgemm(layout, transa, transb, M, N, K, alpha, src0 + i * M * K, lda, src1 + i * K * N, ldb, beta, dst + i * M * N, ldc);
@@ -1,50 +1,688 @@
 #include "saber/funcs/impl/x86/winograd.h"
-#include "saber/funcs/impl/x86/winograd_float.h"
-#include "saber/funcs/impl/x86/winograd_avx2.h"
-//#include "saber/funcs/impl/x86/winograd_avx.h"
-//#include "saber/funcs/impl/x86/winograd_avx2_nchwc8.h"
+#include "saber/funcs/impl/x86/anakin_thread.h"
+#include "saber/funcs/impl/x86/kernel/jit_generator.h"
+#include <algorithm>
+#include <cstring>
+#include <immintrin.h>
+
 namespace anakin {
 namespace saber {
 
+namespace {
+
+/// transform matrices of one variant, alpha = m + 2 rows and columns per tile
+struct WinogradMatrices {
+    int m;
+    int alpha;
+    const float* bt;    ///< alpha x alpha, V = BT * d * B
+    const float* g;     ///< alpha x 3, U = G * g * GT
+    const float* at;    ///< m x alpha, Y = AT * M * A
+};
+
+const float kBtF2[4 * 4] = {
+    1,  0, -1,  0,
+    0,  1,  1,  0,
+    0, -1,  1,  0,
+    0,  1,  0, -1
+};
+const float kGF2[4 * 3] = {
+    1,     0,    0,
+    0.5f,  0.5f, 0.5f,
+    0.5f, -0.5f, 0.5f,
+    0,     0,    1
+};
+const float kAtF2[2 * 4] = {
+    1, 1,  1,  0,
+    0, 1, -1, -1
+};
+
+const float kBtF4[6 * 6] = {
+    4,  0, -5,  0, 1, 0,
+    0, -4, -4,  1, 1, 0,
+    0,  4, -4, -1, 1, 0,
+    0, -2, -1,  2, 1, 0,
+    0,  2, -1, -2, 1, 0,
+    0,  4,  0, -5, 0, 1
+};
+const float kGF4[6 * 3] = {
+    1.f / 4,         0,        0,
+    -1.f / 6, -1.f / 6, -1.f / 6,
+    -1.f / 6,  1.f / 6, -1.f / 6,
+    1.f / 24, 1.f / 12,  1.f / 6,
+    1.f / 24, -1.f / 12, 1.f / 6,
+    0,               0,        1
+};
+const float kAtF4[4 * 6] = {
+    1, 1,  1, 1,  1, 0,
+    0, 1, -1, 2, -2, 0,
+    0, 1,  1, 4,  4, 0,
+    0, 1, -1, 8, -8, 1
+};
+
+const float kBtF6[8 * 8] = {
+    1,     0, -5.25f,     0,  5.25f,     0, -1, 0,
+    0,     1,      1, -4.25f, -4.25f,    1,  1, 0,
+    0,    -1,      1,  4.25f, -4.25f,   -1,  1, 0,
+    0,  0.5f,  0.25f,  -2.5f, -1.25f,    2,  1, 0,
+    0, -0.5f,  0.25f,   2.5f, -1.25f,   -2,  1, 0,
+    0,     2,      4,  -2.5f,     -5, 0.5f,  1, 0,
+    0,    -2,      4,   2.5f,     -5, -0.5f, 1, 0,
+    0,    -1,      0,  5.25f,      0, -5.25f, 0, 1
+};
+const float kGF6[8 * 3] = {
+    1.0f,              0,         0,
+    -2.0f / 9,  -2.0f / 9, -2.0f / 9,
+    -2.0f / 9,   2.0f / 9, -2.0f / 9,
+    1.0f / 90,  1.0f / 45, 2.0f / 45,
+    1.0f / 90, -1.0f / 45, 2.0f / 45,
+    32.0f / 45, 16.0f / 45, 8.0f / 45,
+    32.0f / 45, -16.0f / 45, 8.0f / 45,
+    0,                 0,      1.0f
+};
+const float kAtF6[6 * 8] = {
+    1, 1,  1,  1,   1,        1,         1, 0,
+    0, 1, -1,  2,  -2,     0.5f,     -0.5f, 0,
+    0, 1,  1,  4,   4,    0.25f,     0.25f, 0,
+    0, 1, -1,  8,  -8,   0.125f,   -0.125f, 0,
+    0, 1,  1, 16,  16,  0.0625f,   0.0625f, 0,
+    0, 1, -1, 32, -32, 0.03125f, -0.03125f, 1
+};
+
+const WinogradMatrices& winograd_matrices(WinogradTile tile) {
+    static const WinogradMatrices f2 = {2, 4, kBtF2, kGF2, kAtF2};
+    static const WinogradMatrices f4 = {4, 6, kBtF4, kGF4, kAtF4};
+    static const WinogradMatrices f6 = {6, 8, kBtF6, kGF6, kAtF6};
+    return tile == WINOGRAD_F2 ? f2 : (tile == WINOGRAD_F4 ? f4 : f6);
+}
+
+const int kMaxAlpha = 8;
+
+/// channels carried by one vector in the input and output transforms
+const int kLane = 8;
+
+#if defined(__AVX2__) and defined(__FMA__)
+typedef __m256 lane8;
+
+inline lane8 lane_zero() {
+    return _mm256_setzero_ps();
+}
+inline lane8 lane_load(const float* ptr) {
+    return _mm256_loadu_ps(ptr);
+}
+inline void lane_store(float* ptr, lane8 v) {
+    _mm256_storeu_ps(ptr, v);
+}
+/// acc + a * s
+inline lane8 lane_fmadd(lane8 acc, lane8 a, float s) {
+    return _mm256_fmadd_ps(a, _mm256_set1_ps(s), acc);
+}
+inline lane8 lane_add(lane8 a, lane8 b) {
+    return _mm256_add_ps(a, b);
+}
+inline lane8 lane_relu(lane8 a) {
+    return _mm256_max_ps(a, _mm256_setzero_ps());
+}
+#else
+struct lane8 {
+    float v[kLane];
+};
+
+inline lane8 lane_zero() {
+    lane8 r;
+    memset(r.v, 0, sizeof(r.v));
+    return r;
+}
+inline lane8 lane_load(const float* ptr) {
+    lane8 r;
+    memcpy(r.v, ptr, sizeof(r.v));
+    return r;
+}
+inline void lane_store(float* ptr, lane8 v) {
+    memcpy(ptr, v.v, sizeof(v.v));
+}
+inline lane8 lane_fmadd(lane8 acc, lane8 a, float s) {
+    for (int i = 0; i < kLane; ++i) {
+        acc.v[i] += a.v[i] * s;
+    }
+
+    return acc;
+}
+inline lane8 lane_add(lane8 a, lane8 b) {
+    for (int i = 0; i < kLane; ++i) {
+        a.v[i] += b.v[i];
+    }
+
+    return a;
+}
+inline lane8 lane_relu(lane8 a) {
+    for (int i = 0; i < kLane; ++i) {
+        a.v[i] = a.v[i] > 0.f ? a.v[i] : 0.f;
+    }
+
+    return a;
+}
+#endif
+
+/**
+ * gemm register block: kTileRows tiles x kOcBlock output channels, two vectors per row.
+ * avx512 has 32 registers, room for 24 accumulators.
+ */
+#if defined(__AVX512F__)
+typedef __m512 gemm_vec;
+const int kGemmVec = 16;
+const int kTileRows = 12;
+
+inline gemm_vec gemm_zero() {
+    return _mm512_setzero_ps();
+}
+inline gemm_vec gemm_load(const float* ptr) {
+    return _mm512_loadu_ps(ptr);
+}
+inline void gemm_store(float* ptr, gemm_vec v) {
+    _mm512_storeu_ps(ptr, v);
+}
+inline gemm_vec gemm_fmadd(float a, gemm_vec b, gemm_vec acc) {
+    return _mm512_fmadd_ps(_mm512_set1_ps(a), b, acc);
+}
+#else
+typedef lane8 gemm_vec;
+const int kGemmVec = kLane;
+const int kTileRows = 6;
+
+inline gemm_vec gemm_zero() {
+    return lane_zero();
+}
+inline gemm_vec gemm_load(const float* ptr) {
+    return lane_load(ptr);
+}
+inline void gemm_store(float* ptr, gemm_vec v) {
+    lane_store(ptr, v);
+}
+inline gemm_vec gemm_fmadd(float a, gemm_vec b, gemm_vec acc) {
+    return lane_fmadd(acc, b, a);
+}
+#endif
+
+const int kOcBlock = 2 * kGemmVec;
+/// tiles per block, a block of transformed input is shared by all output channel blocks
+const int kTileBlock = 4 * kTileRows;
+
+inline int round_up(int n, int align) {
+    return (n + align - 1) / align * align;
+}
+
+/// addressing of NCHW (block 1), NCHW_C8R (block 8) and NCHW_C16R (block 16) tensors
+struct PlaneLayout {
+    int block;
+    int channel;
+    int height;
+    int width;
+
+    size_t offset(int n, int c, int h, int w) const {
+        int blocks = (channel + block - 1) / block;
+        return ((((size_t)n * blocks + c / block) * height + h) * width + w) * block + c % block;
+    }
+};
+
+bool plane_layout(Tensor<X86>* tensor, PlaneLayout& layout) {
+    switch (tensor->get_layout()) {
+    case Layout_NCHW:
+        layout.block = 1;
+        break;
+
+    case Layout_NCHW_C8R:
+        layout.block = 8;
+        break;
+
+    case Layout_NCHW_C16R:
+        layout.block = 16;
+        break;
+
+    default:
+        return false;
+    }
+
+    layout.channel = tensor->channel();
+    layout.height = tensor->height();
+    layout.width = tensor->width();
+    return true;
+}
+
+/// 8 channels from c0 of pixel (h, w), zero outside the plane and past the last channel
+inline lane8 load_channels(const float* src, const PlaneLayout& layout, int n, int c0,
+                           int h, int w) {
+    if (h < 0 || h >= layout.height || w < 0 || w >= layout.width) {
+        return lane_zero();
+    }
+
+    const float* ptr = src + layout.offset(n, c0, h, w);
+
+    if (layout.block >= kLane && c0 + kLane <= layout.channel) {
+        return lane_load(ptr);
+    }
+
+    float buf[kLane] = {0.f};
+    int valid = std::min(kLane, layout.channel - c0);
+    size_t stride = layout.block >= kLane ? 1 : (size_t)layout.height * layout.width;
+
+    for (int i = 0; i < valid; ++i) {
+        buf[i] = ptr[i * stride];
+    }
+
+    return lane_load(buf);
+}
+
+inline void store_channels(float* dst, const PlaneLayout& layout, int n, int c0, int h, int w,
+                           lane8 value) {
+    float* ptr = dst + layout.offset(n, c0, h, w);
+
+    if (layout.block >= kLane && c0 + kLane <= layout.channel) {
+        lane_store(ptr, value);
+        return;
+    }
+
+    float buf[kLane];
+    lane_store(buf, value);
+    int valid = std::min(kLane, layout.channel - c0);
+    size_t stride = layout.block >= kLane ? 1 : (size_t)layout.height * layout.width;
+
+    for (int i = 0; i < valid; ++i) {
+        ptr[i * stride] = buf[i];
+    }
+}
+
+/// v = BT * d * B, both alpha x alpha
+inline void transform_input(const WinogradMatrices& mat, const lane8* d, lane8* v) {
+    const int alpha = mat.alpha;
+    lane8 tmp[kMaxAlpha * kMaxAlpha];
+
+    for (int i = 0; i < alpha; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+            lane8 acc = lane_zero();
+
+            for (int k = 0; k < alpha; ++k) {
+                float coeff = mat.bt[i * alpha + k];
+
+                if (coeff != 0.f) {
+                    acc = lane_fmadd(acc, d[k * alpha + j], coeff);
+                }
+            }
+
+            tmp[i * alpha + j] = acc;
+        }
+    }
+
+    for (int i = 0; i < alpha; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+            lane8 acc = lane_zero();
+
+            for (int k = 0; k < alpha; ++k) {
+                float coeff = mat.bt[j * alpha + k];
+
+                if (coeff != 0.f) {
+                    acc = lane_fmadd(acc, tmp[i * alpha + k], coeff);
+                }
+            }
+
+            v[i * alpha + j] = acc;
+        }
+    }
+}
+
+/// y = AT * s * A, s is alpha x alpha, y is m x m
+inline void transform_output(const WinogradMatrices& mat, const lane8* s, lane8* y) {
+    const int alpha = mat.alpha;
+    const int m = mat.m;
+    lane8 tmp[kMaxAlpha * kMaxAlpha];
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+            lane8 acc = lane_zero();
+
+            for (int k = 0; k < alpha; ++k) {
+                float coeff = mat.at[i * alpha + k];
+
+                if (coeff != 0.f) {
+                    acc = lane_fmadd(acc, s[k * alpha + j], coeff);
+                }
+            }
+
+            tmp[i * alpha + j] = acc;
+        }
+    }
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < m; ++j) {
+            lane8 acc = lane_zero();
+
+            for (int k = 0; k < alpha; ++k) {
+                float coeff = mat.at[j * alpha + k];
+
+                if (coeff != 0.f) {
+                    acc = lane_fmadd(acc, tmp[i * alpha + k], coeff);
+                }
+            }
+
+            y[i * m + j] = acc;
+        }
+    }
+}
+
+/**
+ * u[point][ic_pad][oc_pad] = G * g * GT of every (oc, ic) 3x3 kernel, zero in the padding.
+ * done once per tile variant.
+ */
+void transform_weights(const WinogradMatrices& mat, const float* weights, int oc, int ic,
+                       int ic_pad, int oc_pad, float* u) {
+    const int alpha = mat.alpha;
+    memset(u, 0, sizeof(float) * alpha * alpha * ic_pad * oc_pad);
+    #pragma omp parallel for collapse(2) schedule(static)
+
+    for (int o = 0; o < oc; ++o) {
+        for (int i = 0; i < ic; ++i) {
+            const float* g = weights + ((size_t)o * ic + i) * 9;
+            float tmp[kMaxAlpha][3];
+
+            for (int a = 0; a < alpha; ++a) {
+                for (int k = 0; k < 3; ++k) {
+                    tmp[a][k] = mat.g[a * 3] * g[k] + mat.g[a * 3 + 1] * g[3 + k]
+                                + mat.g[a * 3 + 2] * g[6 + k];
+                }
+            }
+
+            for (int a = 0; a < alpha; ++a) {
+                for (int b = 0; b < alpha; ++b) {
+                    float value = tmp[a][0] * mat.g[b * 3] + tmp[a][1] * mat.g[b * 3 + 1]
+                                  + tmp[a][2] * mat.g[b * 3 + 2];
+                    u[((size_t)(a * alpha + b) * ic_pad + i) * oc_pad + o] = value;
+                }
+            }
+        }
+    }
+}
+
+/// c[kTileRows][kOcBlock] = a[kTileRows][k] * b[k][kOcBlock], rows of a and b are lda and ldb apart
+inline void gemm_kernel(const float* a, int lda, const float* b, int ldb, int k, float* c) {
+    gemm_vec acc0[kTileRows];
+    gemm_vec acc1[kTileRows];
+
+    for (int r = 0; r < kTileRows; ++r) {
+        acc0[r] = gemm_zero();
+        acc1[r] = gemm_zero();
+    }
+
+    for (int i = 0; i < k; ++i) {
+        gemm_vec b0 = gemm_load(b + (size_t)i * ldb);
+        gemm_vec b1 = gemm_load(b + (size_t)i * ldb + kGemmVec);
+
+        for (int r = 0; r < kTileRows; ++r) {
+            float a_value = a[(size_t)r * lda + i];
+            acc0[r] = gemm_fmadd(a_value, b0, acc0[r]);
+            acc1[r] = gemm_fmadd(a_value, b1, acc1[r]);
+        }
+    }
+
+    for (int r = 0; r < kTileRows; ++r) {
+        gemm_store(c + r * kOcBlock, acc0[r]);
+        gemm_store(c + r * kOcBlock + kGemmVec, acc1[r]);
+    }
+}
+
+void winograd_conv3x3(const WinogradMatrices& mat, const float* src, const PlaneLayout& in_layout,
+                      float* dst, const PlaneLayout& out_layout, int num,
+                      const float* trans_weights, int ic_pad, int oc_pad,
+                      const float* bias, bool with_relu, int pad_h, int pad_w,
+                      float* trans_input, float* gemm_out) {
+    const int m = mat.m;
+    const int alpha = mat.alpha;
+    const int points = alpha * alpha;
+    const int tiles_h = (out_layout.height + m - 1) / m;
+    const int tiles_w = (out_layout.width + m - 1) / m;
+    const int tiles_per_image = tiles_h * tiles_w;
+    const int tiles = num * tiles_per_image;
+    const int tile_blocks = (tiles + kTileBlock - 1) / kTileBlock;
+    const int ic_blocks = ic_pad / kLane;
+    const int oc_blocks = oc_pad / kOcBlock;
+    const size_t block_stride = (size_t)points * kTileBlock * ic_pad;
+
+    //! transform input: trans_input[tile block][point][tile][ic]
+    #pragma omp parallel for collapse(2) schedule(static)
+
+    for (int tb = 0; tb < tile_blocks; ++tb) {
+        for (int cb = 0; cb < ic_blocks; ++cb) {
+            float* v_block = trans_input + tb * block_stride + cb * kLane;
+            lane8 d[kMaxAlpha * kMaxAlpha];
+            lane8 v[kMaxAlpha * kMaxAlpha];
+
+            for (int j = 0; j < kTileBlock; ++j) {
+                int tile = tb * kTileBlock + j;
+
+                if (tile < tiles) {
+                    int n = tile / tiles_per_image;
+                    int ty = (tile % tiles_per_image) / tiles_w;
+                    int tx = tile % tiles_w;
+
+                    for (int y = 0; y < alpha; ++y) {
+                        for (int x = 0; x < alpha; ++x) {
+                            d[y * alpha + x] = load_channels(src, in_layout, n, cb * kLane,
+                                                             ty * m + y - pad_h, tx * m + x - pad_w);
+                        }
+                    }
+
+                    transform_input(mat, d, v);
+                } else {
+                    for (int p = 0; p < points; ++p) {
+                        v[p] = lane_zero();
+                    }
+                }
+
+                for (int p = 0; p < points; ++p) {
+                    lane_store(v_block + ((size_t)p * kTileBlock + j) * ic_pad, v[p]);
+                }
+            }
+        }
+    }
+
+    //! one gemm per point, then transform output with bias and relu
+    #pragma omp parallel for collapse(2) schedule(static)
+
+    for (int tb = 0; tb < tile_blocks; ++tb) {
+        for (int ob = 0; ob < oc_blocks; ++ob) {
+            float* s_block = gemm_out + (size_t)anakin_get_thread_num() * points * kTileBlock * kOcBlock;
+            const float* v_block = trans_input + tb * block_stride;
+
+            for (int p = 0; p < points; ++p) {
+                const float* u = trans_weights + (size_t)p * ic_pad * oc_pad + ob * kOcBlock;
+                const float* v = v_block + (size_t)p * kTileBlock * ic_pad;
+                float* s = s_block + (size_t)p * kTileBlock * kOcBlock;
+
+                for (int j = 0; j < kTileBlock; j += kTileRows) {
+                    gemm_kernel(v + (size_t)j * ic_pad, ic_pad, u, oc_pad, ic_pad, s + j * kOcBlock);
+                }
+            }
+
+            for (int j = 0; j < kTileBlock; ++j) {
+                int tile = tb * kTileBlock + j;
+
+                if (tile >= tiles) {
+                    break;
+                }
+
+                int n = tile / tiles_per_image;
+                int ty = (tile % tiles_per_image) / tiles_w;
+                int tx = tile % tiles_w;
+
+                for (int lane = 0; lane < kOcBlock; lane += kLane) {
+                    int oc0 = ob * kOcBlock + lane;
+
+                    if (oc0 >= out_layout.channel) {
+                        break;
+                    }
+
+                    lane8 s[kMaxAlpha * kMaxAlpha];
+                    lane8 y[kMaxAlpha * kMaxAlpha];
+
+                    for (int p = 0; p < points; ++p) {
+                        s[p] = lane_load(s_block + ((size_t)p * kTileBlock + j) * kOcBlock + lane);
+                    }
+
+                    transform_output(mat, s, y);
+                    lane8 bias_value = lane_zero();
+
+                    if (bias != nullptr) {
+                        float buf[kLane] = {0.f};
+
+                        for (int i = 0; i < kLane && oc0 + i < out_layout.channel; ++i) {
+                            buf[i] = bias[oc0 + i];
+                        }
+
+                        bias_value = lane_load(buf);
+                    }
+
+                    for (int yy = 0; yy < m; ++yy) {
+                        int oh = ty * m + yy;
+
+                        if (oh >= out_layout.height) {
+                            break;
+                        }
+
+                        for (int xx = 0; xx < m; ++xx) {
+                            int ow = tx * m + xx;
+
+                            if (ow >= out_layout.width) {
+                                break;
+                            }
+
+                            lane8 out = lane_add(y[yy * m + xx], bias_value);
+
+                            if (with_relu) {
+                                out = lane_relu(out);
+                            }
+
+                            store_channels(dst, out_layout, n, oc0, oh, ow, out);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool winograd_simd_enabled() {
+#if defined(__AVX512F__)
+    return jit::mayiuse(jit::avx512_common);
+#elif defined(__AVX2__) and defined(__FMA__)
+    return jit::mayiuse(jit::avx2);
+#else
+    return false;
+#endif
+}
+
+bool winograd_beats_direct(int in_c, int out_c, int out_h, int out_w) {
+    return in_c >= 64 && out_c >= 64 && out_h >= 8 && out_w >= 8;
+}
+
+WinogradTile winograd_choose_tile(int out_h, int out_w) {
+    WinogradTile best = WINOGRAD_F2;
+    long best_cost = -1;
+
+    for (WinogradTile tile : {WINOGRAD_F2, WINOGRAD_F4, WINOGRAD_F6}) {
+        int m = tile;
+        long cost = (long)((out_h + m - 1) / m) * ((out_w + m - 1) / m) * (m + 2) * (m + 2);
+
+        if (best_cost < 0 || cost < best_cost) {
+            best = tile;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
 template <>
 SaberStatus SaberConvWinograd<AK_FLOAT>::create(const std::vector<Tensor<X86> *>& inputs,
         std::vector<Tensor<X86> *>& outputs,
         ConvEltwiseParam<X86>& param, Context<X86>& ctx) {
+    this->_ctx = &ctx;
+    ConvParam<X86>* conv_param = &param.conv_param;
+    int num = inputs[0]->num();
+    int in_c = inputs[0]->channel();
+    int out_c = outputs[0]->channel();
+    int out_h = outputs[0]->height();
+    int out_w = outputs[0]->width();
+
+    _tile = _forced_tile != WINOGRAD_AUTO ? _forced_tile : winograd_choose_tile(out_h, out_w);
+    const WinogradMatrices& mat = winograd_matrices(_tile);
+    int points = mat.alpha * mat.alpha;
+    _ic_pad = round_up(in_c, kLane);
+    _oc_pad = round_up(out_c, kOcBlock);
+
+    Tensor<X86>& weights = _winor_weights[_tile / 2 - 1];
 
-    return _impl->create(inputs, outputs, param, ctx);
+    if (weights.valid_size() != points * _ic_pad * _oc_pad) {
+        weights.re_alloc(Shape({1, points, _ic_pad, _oc_pad}), AK_FLOAT);
+        transform_weights(mat, static_cast<const float*>(conv_param->weight()->data()), out_c, in_c,
+                          _ic_pad, _oc_pad, static_cast<float*>(weights.mutable_data()));
+    }
+
+    int tiles = num * ((out_h + mat.m - 1) / mat.m) * ((out_w + mat.m - 1) / mat.m);
+    int tile_blocks = (tiles + kTileBlock - 1) / kTileBlock;
+    _winor_input.re_alloc(Shape({tile_blocks, points, kTileBlock, _ic_pad}), AK_FLOAT);
+    _winor_temp.re_alloc(Shape({anakin_get_max_threads(), points, kTileBlock, kOcBlock}), AK_FLOAT);
+    return SaberSuccess;
 }
 
 template <>
 SaberStatus SaberConvWinograd<AK_FLOAT>::init(const std::vector<Tensor<X86> *>& inputs,
         std::vector<Tensor<X86> *>& outputs,
         ConvEltwiseParam<X86>& param, Context<X86>& ctx) {
-    LayoutType input_layout = inputs[0]->get_layout();
-    LayoutType out_layout = outputs[0]->get_layout();
+    this->_ctx = &ctx;
+    ConvParam<X86>* conv_param = &param.conv_param;
+    PlaneLayout in_layout;
+    PlaneLayout out_layout;
 
-    //    if(input_layout==Layout_NCHW_C8R&&out_layout==Layout_NCHW_C8R){
-    //        this->_impl = new SaberConvWinogradAvx2Nchwc8<AK_FLOAT>;
-    //    }else
-    if (input_layout == Layout_NCHW && out_layout == Layout_NCHW) {
-#if defined(__AVX2__) and defined(__FMA__)
-        this->_impl = new SaberConvWinogradAvx2<AK_FLOAT>;
-#else
-        this->_impl = new SaberConvWinogradFloat<AK_FLOAT>;
-#endif
-    } else {
-        LOG(FATAL) << "winograd conv not support this layout";
+    if (conv_param->weight()->height() != 3 || conv_param->weight()->width() != 3
+            || conv_param->stride_h != 1 || conv_param->stride_w != 1
+            || conv_param->dilation_h != 1 || conv_param->dilation_w != 1
+            || conv_param->group != 1) {
+        return SaberUnImplError;
     }
 
-    return _impl->init(inputs, outputs, param, ctx);
+    if (!plane_layout(inputs[0], in_layout) || !plane_layout(outputs[0], out_layout)) {
+        LOG(ERROR) << "winograd conv not support this layout";
+        return SaberUnImplError;
+    }
 
+    return create(inputs, outputs, param, ctx);
 }
 
 template <>
 SaberStatus SaberConvWinograd<AK_FLOAT>::dispatch(const std::vector<Tensor<X86> *>& inputs,
         std::vector<Tensor<X86> *>& outputs,
         ConvEltwiseParam<X86>& param) {
-    return _impl->dispatch(inputs, outputs, param);
+    ConvParam<X86>* conv_param = &param.conv_param;
+    PlaneLayout in_layout;
+    PlaneLayout out_layout;
+    plane_layout(inputs[0], in_layout);
+    plane_layout(outputs[0], out_layout);
+    const float* bias_ptr = nullptr;
+
+    if (conv_param->bias() != nullptr && conv_param->bias()->valid_size() > 0) {
+        bias_ptr = static_cast<const float*>(conv_param->bias()->data());
+    }
 
+    bool with_relu = conv_param->activation_param.active == Active_relu;
+
+    winograd_conv3x3(winograd_matrices(_tile), static_cast<const float*>(inputs[0]->data()),
+                     in_layout, static_cast<float*>(outputs[0]->mutable_data()), out_layout,
+                     inputs[0]->num(), static_cast<const float*>(_winor_weights[_tile / 2 - 1].data()),
+                     _ic_pad, _oc_pad, bias_ptr, with_relu, conv_param->pad_h, conv_param->pad_w,
+                     static_cast<float*>(_winor_input.mutable_data()),
+                     static_cast<float*>(_winor_temp.mutable_data()));
+    return SaberSuccess;
 }
 
 }
-}
\ No newline at end of file
+}
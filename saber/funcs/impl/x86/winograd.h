@@ -6,6 +6,42 @@
 
 namespace anakin {
 namespace saber {
+
+/**
+ * \brief output tile of a winograd variant, F(m x m, 3 x 3) reads (m + 2) x (m + 2) input tiles.
+ *  larger tiles need fewer multiplies per output but waste more on the border of small planes
+ *  and lose precision, F(6, 3) is about 1e-3 off a direct conv.
+ */
+enum WinogradTile {
+    WINOGRAD_AUTO = 0,
+    WINOGRAD_F2 = 2,
+    WINOGRAD_F4 = 4,
+    WINOGRAD_F6 = 6
+};
+
+/// tile with the least transformed work for an out_h x out_w plane, ties go to the smaller tile.
+WinogradTile winograd_choose_tile(int out_h, int out_w);
+
+/**
+ * \brief whether the vector code winograd.cpp is compiled for runs on this cpu. false when it
+ *  is built for scalar code only, as under BUILD_X86_ISA_DISPATCH.
+ */
+bool winograd_simd_enabled();
+
+/**
+ * \brief whether winograd beats the direct jit convs for this shape. the transforms cost
+ *  O(ic + oc) per tile against O(ic * oc) for the gemm, so below 64 channels they eat most of
+ *  the saved multiplies, and small planes waste the border tiles.
+ */
+bool winograd_beats_direct(int in_c, int out_c, int out_h, int out_w);
+
+/**
+ * \brief 3x3 stride 1 conv by winograd, input and output in NCHW, NCHW_C8R or NCHW_C16R.
+ *  weights are transformed once per tile variant and kept, a reshape only resizes the
+ *  workspace. each run transforms the input tiles, multiplies them by the weights with one
+ *  small gemm per point of the transformed tile, and transforms back with bias and relu fused.
+ *  both stages are parallel over tile blocks x channel blocks.
+ */
 template<DataType OpDtype>
 class SaberConvWinograd : public ImplBase <
     X86, OpDtype, ConvEltwiseParam<X86> > {
@@ -15,10 +51,15 @@ public:
 
     SaberConvWinograd() {}
 
-    ~SaberConvWinograd() {
-        if (_impl!= nullptr){
-            delete _impl;
-        }
+    ~SaberConvWinograd() {}
+
+    /// fix the tile instead of choosing it from the output plane, call before init.
+    void set_tile(WinogradTile tile) {
+        _forced_tile = tile;
+    }
+
+    WinogradTile tile() const {
+        return _tile;
     }
 
     virtual SaberStatus init(const std::vector<Tensor<X86> *>& inputs,
@@ -34,9 +75,18 @@ public:
                                  ConvEltwiseParam<X86>& param);
 
 private:
-    Impl_t *_impl;
-
+    WinogradTile _forced_tile{WINOGRAD_AUTO};
+    WinogradTile _tile{WINOGRAD_F6};
+    int _ic_pad{0};
+    int _oc_pad{0};
+    ///< transformed weights, indexed by tile / 2 - 1, filled on first use of the tile
+    Tensor<X86> _winor_weights[3];
+    ///< transformed input of all tiles
+    Tensor<X86> _winor_input;
+    ///< per thread gemm output of one tile block
+    Tensor<X86> _winor_temp;
 };
+
 }
 }
 #endif //ANAKIN_WINOGRAD_H
@@ -151,6 +151,35 @@ public:
             }
         }
     }
+    /// hidden of the last step of each sequence (its first word when reversed) into one row
+    /// per sequence, the rows of empty sequences are kept
+    template <typename Dtype>
+    void seq_last_hidden(const Dtype* input, Dtype* output, const std::vector<int>& offset_vec,
+                         int hidden_size) {
+        for (int seq_id = 0; seq_id < offset_vec.size() - 1; ++seq_id) {
+            if (offset_vec[seq_id + 1] == offset_vec[seq_id]) {
+                continue;
+            }
+
+            int word_id = _is_reverse ? offset_vec[seq_id] : offset_vec[seq_id + 1] - 1;
+            memcpy(output + seq_id * hidden_size, input + word_id * hidden_size,
+                   hidden_size * sizeof(Dtype));
+        }
+    }
+    /// inverse of hidden_2_sorted_hidden
+    template <typename Dtype>
+    void sorted_hidden_2_hidden(const Dtype*  input, Dtype* output, int hidden_size) {
+        int batch_size = _length_index.size();
+
+        for (int sorted_id = 0; sorted_id < batch_size; ++sorted_id) {
+            int maped_start = _length_index[sorted_id] * hidden_size;
+            int sorted_start = sorted_id * hidden_size;
+
+            for (int word_vec_offset = 0; word_vec_offset < hidden_size; ++word_vec_offset) {
+                output[maped_start + word_vec_offset] = input[sorted_start + word_vec_offset];
+            }
+        }
+    }
     template <typename Dtype>
     void sorted_seq_2_seq(const Dtype* input, Dtype* output, int hidden_size) {
         int word_sum = _map_vec.size();
@@ -191,11 +220,13 @@ public:
      * @param emit_length
      * @return
      */
-    bool get_sorted_map(std::vector<int>& offset_vec,
+    bool get_sorted_map(const std::vector<int>& offset_vec,
                         std::vector<int>& emit_offset_vec, int& emit_length, int skip_num = 0) {
         int batch_size = offset_vec.size() - 1;
         int word_sum = offset_vec[offset_vec.size() - 1];
-        std::vector<int>length_vec(batch_size);
+        // members, so a util kept by an op reuses them across calls
+        std::vector<int>& length_vec = _length_vec;
+        length_vec.resize(batch_size);
         _length_index.resize(batch_size);
 
         if (skip_num > 1) {
@@ -236,8 +267,9 @@ public:
         emit_length = max_len;
 
         if (max_len == 1) {
-            emit_offset_vec.push_back(0);
-            emit_offset_vec.push_back(emit_length * batch_size);
+            emit_offset_vec.resize(2);
+            emit_offset_vec[0] = 0;
+            emit_offset_vec[1] = emit_length * batch_size;
             return false;
         }
 
@@ -249,7 +281,8 @@ public:
         _map_vec.resize(word_sum);
 
         int target_word_id = 0;
-        std::vector<int> length_vec_cnt = length_vec;
+        std::vector<int>& length_vec_cnt = _length_cnt;
+        length_vec_cnt = length_vec;
         int last_batch_size = batch_size;
 
         for (int word_id_in_seq = 0; word_id_in_seq < max_len; word_id_in_seq++) {
@@ -284,7 +317,8 @@ public:
 
 
 private:
-    //    std::vector<int> _length_vec;
+    std::vector<int> _length_vec;
+    std::vector<int> _length_cnt;
     std::vector<int> _length_index;
     std::vector<int> _map_vec;
     bool _is_reverse;
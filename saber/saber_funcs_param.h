@@ -1416,6 +1416,7 @@ struct GruParam {
         is_reverse = right.is_reverse;
         formula = right.formula;
         init_hidden_tensor = right.init_hidden_tensor;
+        state_hidden = right.state_hidden;
         return *this;
     }
 
@@ -1453,6 +1454,10 @@ struct GruParam {
     ActiveType h_activity;
     GruFormula formula;
     bool is_reverse;
+    ///< streaming state, one row of hidden_size per sequence of the batch: each sequence
+    ///< starts from its row instead of zeros, which gets its final hidden after dispatch.
+    ///< it is data, not configuration, operator== ignores it
+    opTensor* state_hidden{nullptr};
 private:
     opTensor* weight_tensor;
     opTensor* bias_tensor;
@@ -1701,6 +1706,8 @@ struct LstmParam {
         skip_num = right.skip_num;
         project_dim=right.project_dim;
         cell_dim=right.cell_dim;
+        state_hidden = right.state_hidden;
+        state_cell = right.state_cell;
         return *this;
     }
 
@@ -1759,6 +1766,12 @@ struct LstmParam {
     int skip_num;
     int project_dim;
     int cell_dim;
+    ///< streaming state, one row of hidden_size per sequence of the batch: each sequence
+    ///< starts from its rows instead of zeros, which get its final hidden and cell after
+    ///< dispatch. state_cell may be null when only the hidden is carried.
+    ///< it is data, not configuration, operator== ignores it
+    opTensor* state_hidden{nullptr};
+    opTensor* state_cell{nullptr};
 private:
     opTensor* weight_tensor;
     opTensor* bias_tensor;
@@ -2652,11 +2665,13 @@ struct SequenceConvParam {
           context_length(1),
           context_start(0),
           context_stride(1),
-          padding_trainable(false)
+          padding_trainable(false),
+          active_type(Active_unknow)
     {}
     SequenceConvParam(opTensor* filter_tensor_in, int context_length_in,
                       int context_start_in = 0, int context_stride_in = 1, bool padding_trainable_in = false, 
-                      opTensor* padding_tensor_in = nullptr, bool bias_term_in = false, opTensor* bias_tensor_in = nullptr)
+                      opTensor* padding_tensor_in = nullptr, bool bias_term_in = false, opTensor* bias_tensor_in = nullptr,
+                      ActiveType active_type_in = Active_unknow)
         : filter_tensor(filter_tensor_in),
           bias_tensor(bias_tensor_in),
           bias_term(bias_term_in),
@@ -2664,7 +2679,8 @@ struct SequenceConvParam {
           context_length(context_length_in),
           context_start(context_start_in),
           context_stride(context_stride_in),
-          padding_trainable(padding_trainable_in)
+          padding_trainable(padding_trainable_in),
+          active_type(active_type_in)
     {}
     SequenceConvParam(const SequenceConvParam& right)
         : filter_tensor(right.filter_tensor),
@@ -2674,7 +2690,8 @@ struct SequenceConvParam {
           context_length(right.context_length),
           context_start(right.context_start),
           context_stride(right.context_stride),
-          padding_trainable(right.padding_trainable)
+          padding_trainable(right.padding_trainable),
+          active_type(right.active_type)
     {}
     SequenceConvParam& operator=(const SequenceConvParam& right) {
         filter_tensor = right.filter_tensor;
@@ -2685,6 +2702,7 @@ struct SequenceConvParam {
         context_start = right.context_start;
         context_stride = right.context_stride;
         padding_trainable = right.padding_trainable;
+        active_type = right.active_type;
         return *this;
     }
     bool operator==(const SequenceConvParam& right) {
@@ -2697,6 +2715,7 @@ struct SequenceConvParam {
         comp_eq = comp_eq && (context_start = right.context_start);
         comp_eq = comp_eq && (context_stride = right.context_stride);
         comp_eq = comp_eq && (padding_trainable = right.padding_trainable);
+        comp_eq = comp_eq && (active_type == right.active_type);
         return comp_eq;
     }
 
@@ -2708,6 +2727,7 @@ struct SequenceConvParam {
     int context_stride;
     bool padding_trainable;
     bool bias_term;
+    ActiveType active_type; ///< activation fused after bias, Active_unknow means none
 };
 
 template <typename TargetType>
@@ -2858,21 +2878,31 @@ struct SliceV2Param {
 template <typename TargetType>
 struct SoftmaxParam {
     SoftmaxParam() = default;
-    explicit SoftmaxParam(int axis_in) {
+    explicit SoftmaxParam(int axis_in, float scale_in = 1.f, bool log_in = false)
+        : axis(axis_in)
+        , scale(scale_in)
+        , log_softmax(log_in) {
         CHECK_GE(axis_in, 0) << "input axis index should >= 0, current is " << axis_in;
-        axis = axis_in;
     }
     SoftmaxParam(const SoftmaxParam<TargetType>& right) {
         axis = right.axis;
+        scale = right.scale;
+        log_softmax = right.log_softmax;
     }
     SoftmaxParam<TargetType>& operator=(const SoftmaxParam<TargetType>& right) {
         this->axis = right.axis;
+        this->scale = right.scale;
+        this->log_softmax = right.log_softmax;
         return *this;
     }
     bool operator==(const SoftmaxParam<TargetType>& right) {
-        return axis == right.axis;
+        return axis == right.axis && scale == right.scale && log_softmax == right.log_softmax;
     }
     int axis;
+    ///< logits are scale * input (+ mask, when a second input is given) before the softmax
+    float scale{1.f};
+    ///< output log(softmax) instead of softmax
+    bool log_softmax{false};
 };
 
 template <typename TargetType>
@@ -0,0 +1,137 @@
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "core_test.h"
+
+using logger::core::Message;
+using logger::core::async::Ring;
+
+/// lines of the async tests seen by the callback, as (thread, sequence) pairs
+std::mutex g_lines_mut;
+std::vector<std::pair<int, int> > g_lines;
+
+void collect_line(void* user_data, const Message& message) {
+    const char* tag = static_cast<const char*>(user_data);
+    std::istringstream line(message.message);
+    std::string word;
+    int thread_id = 0;
+    int seq = 0;
+    if (line >> word && word == tag && line >> thread_id >> seq) {
+        std::lock_guard<std::mutex> guard(g_lines_mut);
+        g_lines.emplace_back(thread_id, seq);
+    }
+}
+
+/// every thread's lines arrive once each and in the order it logged them
+void check_lines(int thread_num, int line_num) {
+    std::lock_guard<std::mutex> guard(g_lines_mut);
+    CHECK_EQ(g_lines.size(), thread_num * line_num);
+    std::vector<int> next(thread_num, 0);
+    for (auto& item : g_lines) {
+        CHECK_EQ(item.second, next[item.first]) << "line of thread " << item.first << " out of order";
+        next[item.first]++;
+    }
+    g_lines.clear();
+}
+
+TEST(CoreComponentsTest, core_async_logger_order_test) {
+    LOG(INFO) << "test the line order of concurrent producers through the async logger.";
+    static char tag[] = "order";
+    logger::core::funcRegister::add_callback(tag, collect_line, tag, logger::core::Verbose_INFO, nullptr, nullptr);
+    const int thread_num = 4;
+    // more than a ring holds, the producers outrun the flusher now and then
+    const int line_num = 3 * Ring::kCapacity;
+    logger::set_async(true, 1);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < thread_num; t++) {
+        producers.emplace_back([t, line_num]() {
+            for (int i = 0; i < line_num; i++) {
+                LOG(INFO) << "order " << t << " " << i;
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    logger::set_async(false);
+    logger::core::funcRegister::remove_callback(tag);
+    check_lines(thread_num, line_num);
+}
+
+TEST(CoreComponentsTest, core_async_logger_full_ring_test) {
+    LOG(INFO) << "test that a producer with a full ring waits for the writes and keeps its order.";
+    static char tag[] = "full";
+    logger::core::funcRegister::add_callback(tag, collect_line, tag, logger::core::Verbose_INFO, nullptr, nullptr);
+    const int capacity = Ring::kCapacity;
+    const int line_num = 2 * capacity + 10;
+    std::atomic<int> logged{0};
+    logger::set_async(true, 100000);
+    std::thread producer;
+    {
+        // nothing is written while the writers' lock is held, the ring fills up
+        std::lock_guard<std::recursive_mutex> write_guard(logger::core::LoggerConfig::rsMutex);
+        producer = std::thread([&]() {
+            for (int i = 0; i < line_num; i++) {
+                LOG(INFO) << "full 0 " << i;
+                logged++;
+            }
+        });
+        while (logged.load() < capacity) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK_EQ(logged.load(), capacity) << "a producer with a full ring didn't wait";
+    }
+    producer.join();
+    logger::set_async(false);
+    logger::core::funcRegister::remove_callback(tag);
+    check_lines(1, line_num);
+}
+
+TEST(CoreComponentsTest, core_async_logger_fatal_test) {
+    LOG(INFO) << "test that a fatal line writes the queued lines out before the abort.";
+    int fds[2];
+    CHECK_EQ(pipe(fds), 0);
+    pid_t pid = fork();
+    CHECK_GE(pid, 0);
+    if (pid == 0) {
+        close(fds[0]);
+        dup2(fds[1], STDERR_FILENO);
+        logger::set_async(true, 100000);
+        for (int i = 0; i < 10; i++) {
+            LOG(INFO) << "queued line " << i;
+        }
+        LOG(FATAL) << "fatal line";
+        _exit(0);
+    }
+    close(fds[1]);
+    std::string output;
+    char buff[4096];
+    ssize_t size = 0;
+    while ((size = read(fds[0], buff, sizeof(buff))) > 0) {
+        output.append(buff, size);
+    }
+    close(fds[0]);
+    int status = 0;
+    CHECK_EQ(waitpid(pid, &status, 0), pid);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT) << "the fatal line didn't abort";
+
+    size_t pos = 0;
+    for (int i = 0; i < 10; i++) {
+        pos = output.find("queued line " + std::to_string(i), pos);
+        CHECK_NE(pos, std::string::npos) << "queued line " << i << " lost or out of order";
+    }
+    CHECK_NE(output.find("fatal line", pos), std::string::npos) << "queued lines after the fatal one";
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -4,6 +4,10 @@
 #include "tls.h"
 #include "parameter.h"
 #include "thread_pool.h"
+#include "numa.h"
+#include "metrics.h"
+#include "cpu_scheduler.h"
+#include "alloc_audit.h"
 
 #ifdef USE_CUDA
 #include "cuda_funcs.h"
@@ -133,6 +137,230 @@ TEST(CoreComponentsTest, core_base_types_thread_pool_test) {
     }
 }
 
+TEST(CoreComponentsTest, core_base_types_grouped_thread_pool_test) {
+    LOG(INFO) << " Create thread pool with 8 threads in 2 groups ";
+    ThreadPool thread_pool_test(8, 2);
+    thread_pool_test.launch();
+    std::function<int(int)> test = thread_pool_func;
+    std::vector<std::future<int>> rets;
+
+    for (int i = 0; i < 64; i++) {
+        rets.push_back(thread_pool_test.RunAsync(test, i));
+    }
+
+    for (int i = 0; i < 64; i++) {
+        CHECK_EQ(rets[i].get(), i);
+    }
+}
+
+TEST(CoreComponentsTest, core_base_types_thread_pool_priority_test) {
+    LOG(INFO) << " Create thread pool with 1 thread, check priority, deadline and shedding ";
+    ThreadPool thread_pool_test(1);
+    thread_pool_test.launch();
+    // hold the only thread until all the tasks are queued
+    std::promise<void> gate;
+    std::shared_future<void> gate_open = gate.get_future().share();
+    std::promise<void> started;
+    std::function<void()> block = [gate_open, &started]() {
+        started.set_value();
+        gate_open.wait();
+    };
+    auto blocked = thread_pool_test.RunAsync(block);
+    // block is off the queue, the tasks below are all ordered by the queue
+    started.get_future().wait();
+
+    std::mutex mut;
+    std::vector<int> order;
+    std::vector<int> shed;
+    std::function<int(int)> record = [&](int id) {
+        std::lock_guard<std::mutex> guard(mut);
+        (ThreadPool::shedding() ? shed : order).push_back(id);
+        return id;
+    };
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::future<int> > rets;
+    rets.push_back(thread_pool_test.RunAsync(record, 0));
+    rets.push_back(thread_pool_test.RunAsyncScheduled(TaskOptions(0, now + std::chrono::hours(2)), record, 1));
+    rets.push_back(thread_pool_test.RunAsyncScheduled(TaskOptions(1), record, 2));
+    rets.push_back(thread_pool_test.RunAsyncScheduled(TaskOptions(0, now + std::chrono::hours(1)), record, 3));
+    // already past its deadline
+    rets.push_back(thread_pool_test.RunAsyncScheduled(TaskOptions(0, now - std::chrono::seconds(1)), record, 4));
+    rets.push_back(thread_pool_test.RunAsyncScheduled(TaskOptions(-1), record, 5));
+    rets.push_back(thread_pool_test.RunAsync(record, 6));
+    gate.set_value();
+    blocked.get();
+
+    for (int i = 0; i < rets.size(); i++) {
+        CHECK_EQ(rets[i].get(), i);
+    }
+
+    // class first, then earliest deadline, then submission order
+    std::vector<int> expect = {2, 3, 1, 0, 6, 5};
+    CHECK(order == expect);
+    CHECK_EQ(shed.size(), 1);
+    CHECK_EQ(shed[0], 4);
+}
+
+TEST(CoreComponentsTest, core_base_types_numa_test) {
+    std::vector<int> cpus = parse_cpu_list("0-3,8,10-11\n");
+    std::vector<int> expect = {0, 1, 2, 3, 8, 10, 11};
+    CHECK(cpus == expect);
+
+    auto& topo = GlobalNumaTopology::Global();
+    CHECK_GE(topo.node_num(), 1);
+
+    for (int i = 0; i < topo.node_num(); i++) {
+        LOG(INFO) << " numa node " << topo.node(i).id << " cpus: " << topo.node(i).cpus.size();
+        CHECK(!topo.node(i).cpus.empty());
+    }
+}
+
+TEST(CoreComponentsTest, core_base_types_metrics_test) {
+    LatencyHistogram hist;
+    for (int i = 1; i <= 10000; i++) {
+        hist.record(i);
+    }
+    auto snap = hist.snapshot();
+    CHECK_EQ(snap.count, 10000);
+    CHECK_EQ(snap.max, 10000);
+    // log-linear buckets: at most 1/16 off
+    CHECK_LE(std::abs((double)snap.percentile(0.5) - 5000), 5000 / 16.0);
+    CHECK_LE(std::abs((double)snap.percentile(0.99) - 9900), 9900 / 16.0);
+
+    auto& metrics = GlobalMetrics::Global();
+    Counter& counter = metrics.counter(metric_name("test_requests", "model", "m"));
+    ThreadPool pool(4);
+    pool.launch();
+    std::function<int(int)> add = [&](int n) {
+        for (int i = 0; i < n; i++) {
+            counter.add();
+        }
+        return n;
+    };
+    std::vector<std::future<int>> rets;
+    for (int i = 0; i < 16; i++) {
+        rets.push_back(pool.RunAsync(add, 1000));
+    }
+    for (auto& ret : rets) {
+        ret.get();
+    }
+    CHECK_EQ(counter.value(), 16000);
+
+    std::string text = metrics.dump_text();
+    LOG(INFO) << text;
+    CHECK(text.find("test_requests{model=\"m\"} 16000") != std::string::npos);
+}
+
+TEST(CoreComponentsTest, core_base_types_cpu_scheduler_test) {
+    CpuScheduler scheduler({8});
+    int heavy = scheduler.model_id("heavy");
+    int light = scheduler.model_id("light");
+    CHECK_EQ(scheduler.model_id("heavy"), heavy);
+    scheduler.configure(heavy, 3.f);
+
+    // alone a model may take the whole node, up to the cap of the caller
+    {
+        CpuLease lease = scheduler.acquire(heavy, 0, 6);
+        CHECK_EQ(lease.threads(), 6);
+        CHECK_EQ(scheduler.free_threads(0), 2);
+    }
+    CHECK_EQ(scheduler.free_threads(0), 8);
+
+    // active models split the node by weight, 3:1
+    {
+        CpuLease lease_light = scheduler.acquire(light, 0, 2);
+        CHECK_EQ(lease_light.threads(), 2);
+        CpuLease lease_heavy = scheduler.acquire(heavy);
+        CHECK_EQ(lease_heavy.threads(), 6);
+        lease_light.release();
+        lease_light = scheduler.acquire(light);
+        CHECK_EQ(lease_light.threads(), 2);
+    }
+    CHECK_EQ(scheduler.free_threads(0), 8);
+
+    // requests wait for free cores, the higher priority goes first
+    int urgent = scheduler.model_id("urgent");
+    scheduler.configure(urgent, 1.f, 1, 2);
+    // the node is taken, the 2 cores of hold_small only fit one of the waiters
+    CpuLease hold = scheduler.acquire(light, 0, 6);
+    CHECK_EQ(hold.threads(), 6);
+    CpuLease hold_small = scheduler.acquire(heavy, 0, 2);
+    CHECK_EQ(hold_small.threads(), 2);
+    CHECK_EQ(scheduler.free_threads(0), 0);
+    ThreadPool pool(2);
+    pool.launch();
+    std::mutex order_mut;
+    std::vector<int> order;
+    std::function<int(int)> run = [&](int model) {
+        CpuLease lease = scheduler.acquire(model);
+        std::lock_guard<std::mutex> guard(order_mut);
+        order.push_back(model);
+        return lease.threads();
+    };
+    auto wait_for_waiters = [&](int num) {
+        while (scheduler.waiting(0) < num) {
+            std::this_thread::yield();
+        }
+    };
+    // light queues first, then urgent
+    auto ret_light = pool.RunAsync(run, light);
+    wait_for_waiters(1);
+    auto ret_urgent = pool.RunAsync(run, urgent);
+    wait_for_waiters(2);
+    {
+        std::lock_guard<std::mutex> guard(order_mut);
+        CHECK(order.empty());
+    }
+    hold_small.release();
+    CHECK_EQ(ret_urgent.get(), 2);
+    {
+        std::lock_guard<std::mutex> guard(order_mut);
+        CHECK_EQ(order.size(), 1);
+        CHECK_EQ(order[0], urgent);
+    }
+    CHECK_EQ(scheduler.waiting(0), 1);
+    hold.release();
+    CHECK_GE(ret_light.get(), 1);
+    {
+        std::lock_guard<std::mutex> guard(order_mut);
+        CHECK_EQ(order.size(), 2);
+    }
+    CHECK_EQ(scheduler.free_threads(0), 8);
+
+    CpuScheduler disabled(std::vector<int>{});
+    CHECK(!disabled.enabled());
+    CHECK_EQ(disabled.acquire(disabled.model_id("m")).threads(), 0);
+}
+
+#ifdef USE_X86_PLACE
+TEST(CoreComponentsTest, core_base_types_alloc_audit_test) {
+    saber::Tensor<saber::X86> tensor(saber::Shape({2, 3, 8, 8}));
+    saber::Shape shape({4, 3, 2, 2});
+    std::vector<std::vector<int> > offset = {{0, 1, 2}};
+    // buffer allocations are exact, ENABLE_ALLOC_AUDIT builds also count the Shape temporaries
+    size_t start = saber::thread_buffer_allocs();
+    // reshapes within the capacity and shape or offset copies reuse memory
+    tensor.reshape(saber::Shape({1, 3, 8, 8}));
+    tensor.reshape(saber::Shape({2, 3, 8, 8}));
+    shape = tensor.valid_shape();
+    tensor.set_seq_offset(offset);
+    CHECK_EQ(saber::thread_buffer_allocs(), start);
+    CHECK(shape == tensor.valid_shape());
+    CHECK(tensor.get_seq_offset() == offset);
+    tensor.reshape(saber::Shape({4, 3, 8, 8}));
+    CHECK_EQ(saber::thread_buffer_allocs(), start + 1);
+    CHECK_GE(thread_alloc_count(), saber::thread_buffer_allocs());
+
+    // shapes share their layout object, copies and moves keep it
+    saber::Shape moved(std::move(shape));
+    CHECK_EQ(moved.get_layout(), saber::Layout_NCHW);
+    shape = moved;
+
+    saber::Shape& alias = shape;
+    shape = alias;
+    CHECK_EQ(shape.count(), 2 * 3 * 8 * 8);
+}
+#endif
 
 int main(int argc, const char** argv) {
     // initial logger
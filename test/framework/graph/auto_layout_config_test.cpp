@@ -0,0 +1,83 @@
+#include <string>
+#include "graph_test.h"
+#include "framework/core/net/auto_layout_config.h"
+
+using namespace anakin;
+using namespace anakin::graph;
+
+#ifdef USE_X86_PLACE
+
+typedef Graph<X86, Precision::FP32> TestGraph;
+
+void add_op(TestGraph& graph, std::string name, std::string type,
+            std::string input, std::string output) {
+    graph.AddOp(name, type, {input}, {output});
+}
+
+TEST(GraphTest, auto_layout_cost_model_test) {
+    LOG(INFO) << "test for the min cut layout assignment .";
+    // x -> conv_0 -> conv_1 -> pool -> dense -> y
+    TestGraph graph;
+    add_op(graph, "conv_0", "Convolution", "x", "conv_0_out");
+    add_op(graph, "conv_1", "Convolution", "conv_0_out", "conv_1_out");
+    add_op(graph, "pool", "Pooling", "conv_1_out", "pool_out");
+    add_op(graph, "dense", "Dense", "pool_out", "y");
+    CHECK(graph.Freeze());
+
+    AutoLayoutConfigHelper<X86, Precision::FP32> helper;
+    CHECK(helper.cost_model_layout(graph));
+    auto layouts = helper.get_config_layout();
+    // the input is nchw and conv_0 reorders once (0.6 + 0.3 < 1), the pooling stays
+    // blocked and Dense reorders its input (0.8 + 1.3 < 1.3 + 1)
+    std::unordered_map<std::string, std::string> expect;
+    expect["x->conv_0"] = "nchw";
+    expect["conv_0->conv_1"] = "nchw_c8r";
+    expect["conv_1->pool"] = "nchw_c8r";
+    expect["pool->dense"] = "nchw_c8r";
+    expect["dense->y"] = "nchw";
+    int checked = 0;
+    auto check_edge = [&](Edge<X86>& edge) {
+        std::string key = edge.bottom() + "->" + edge.top();
+        CHECK(expect.count(key) > 0) << "unexpected edge " << key;
+        CHECK_EQ(layouts[edge.name()], expect[key]) << key;
+        checked++;
+        return Status::OK();
+    };
+    graph.Scanner->BFS_Edge(check_edge);
+    CHECK_EQ(checked, expect.size());
+}
+
+TEST(GraphTest, auto_layout_node_dtype_test) {
+    LOG(INFO) << "test for the min cut int8 assignment .";
+    // x -> conv_0 -> conv_1 -> pool -> act -> dense -> y, pool and dense stay fp32
+    TestGraph graph;
+    add_op(graph, "conv_0", "Convolution", "x", "conv_0_out");
+    add_op(graph, "conv_1", "ConvRelu", "conv_0_out", "conv_1_out");
+    add_op(graph, "pool", "Pooling", "conv_1_out", "pool_out");
+    add_op(graph, "act", "Activation", "pool_out", "act_out");
+    add_op(graph, "dense", "Dense", "act_out", "y");
+    CHECK(graph.Freeze());
+
+    for (auto name : {"conv_0", "conv_1", "act"}) {
+        CHECK(graph.SetOpPrec(name, AK_INT8));
+    }
+
+    AutoLayoutConfigHelper<X86, Precision::FP32> helper;
+    auto dtypes = helper.auto_config_node_dtype(graph);
+    CHECK_EQ(dtypes.size(), 3);
+    // the convs pay two calibrations together: 0.35 * 2 + 0.25 * 2 < 2
+    CHECK_EQ(dtypes["conv_0"], "int8");
+    CHECK_EQ(dtypes["conv_1"], "uint8");
+    // an int8 Activation between fp32 ops costs more than it saves: 1 + 0.25 * 2 > 1
+    CHECK_EQ(dtypes["act"], "fp32");
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
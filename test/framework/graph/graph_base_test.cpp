@@ -1,6 +1,10 @@
 #include <string>
 #include "graph_test.h"
 #include "graph_base.h"
+#include "graph_snapshot.h"
+#include "framework/graph/graph.h"
+#include <cstdio>
+#include <fstream>
 
 using namespace anakin;
 using namespace anakin::graph;
@@ -73,6 +77,163 @@ TEST(GraphTest, graph_base_test) {
 }
 
 
+TEST(GraphTest, graph_snapshot_file_test) {
+    LOG(INFO) << "test for graph snapshot file .";
+    std::string path = "graph_snapshot_test.anakin.snapshot";
+
+    GraphSnapshotHeader header;
+    header.key = "v1-deadbeef-saber_X86-p0-avx2-input_0_1_3_224_224";
+    header.exec_order = {"input_0", "conv_0", "relu_0", "fc_0"};
+    std::string payload("proto\n\0bytes", 13);
+    CHECK(write_graph_snapshot(path, header, payload));
+
+    GraphSnapshotHeader loaded;
+    std::string loaded_payload;
+    CHECK(read_graph_snapshot(path, loaded, loaded_payload));
+    CHECK_EQ(loaded.key, header.key);
+    CHECK(loaded.exec_order == header.exec_order);
+    CHECK(loaded_payload == payload);
+
+    // a truncated snapshot is refused
+    std::ifstream full(path, std::ios::in | std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(full)), std::istreambuf_iterator<char>());
+    full.close();
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        file.write(content.data(), content.size() - 4);
+    }
+    CHECK(!read_graph_snapshot(path, loaded, loaded_payload));
+    std::remove(path.c_str());
+
+    // the key does not depend on the order the input shapes are given in
+    std::string model_path = "graph_snapshot_test.anakin.bin";
+    {
+        std::ofstream model(model_path, std::ios::out | std::ios::trunc | std::ios::binary);
+        model << "model bytes";
+    }
+    std::unordered_map<std::string, std::vector<int> > shapes_a;
+    shapes_a["a"] = {1, 3, 8, 8};
+    shapes_a["b"] = {1, 16};
+    std::unordered_map<std::string, std::vector<int> > shapes_b;
+    shapes_b["b"] = {1, 16};
+    shapes_b["a"] = {1, 3, 8, 8};
+    std::string key_a;
+    std::string key_b;
+    CHECK(graph_snapshot_key(model_path, "saber_X86", Precision::FP32, shapes_a, key_a));
+    CHECK(graph_snapshot_key(model_path, "saber_X86", Precision::FP32, shapes_b, key_b));
+    CHECK_EQ(key_a, key_b);
+    CHECK_EQ(key_a.find(kGraphSnapshotFormat), 0);
+    shapes_b["a"] = {2, 3, 8, 8};
+    CHECK(graph_snapshot_key(model_path, "saber_X86", Precision::FP32, shapes_b, key_b));
+    CHECK_NE(key_a, key_b);
+    std::remove(model_path.c_str());
+
+    // a model that can't be read has no key
+    std::string key_none;
+    CHECK(!graph_snapshot_key(model_path, "saber_X86", Precision::FP32, shapes_a, key_none));
+    CHECK(key_none.empty());
+}
+
+#ifdef USE_X86_PLACE
+TEST(GraphTest, graph_snapshot_round_trip_test) {
+    LOG(INFO) << "test for graph snapshot save and load .";
+    Graph<X86, Precision::FP32>* graph = new Graph<X86, Precision::FP32>();
+    auto add_fc_op = [&](const std::string& fc_name, const std::string& input,
+                         const std::string& output, float base) {
+        graph->AddOp(fc_name, "Dense", {input}, {output});
+        graph->AddOpAttr(fc_name, "out_dim", 5);
+        graph->AddOpAttr(fc_name, "bias_term", false);
+        graph->AddOpAttr(fc_name, "axis", 1);
+        saber::Shape shape({1, 1, 5, 5});
+        PBlock<X86> weight(shape);
+        float* data = static_cast<float*>(weight.h_tensor().mutable_data());
+        for (int i = 0; i < 5 * 5; i++) {
+            data[i] = base + i;
+        }
+        weight.d_tensor().set_shape(shape);
+        weight.d_tensor().copy_from(weight.h_tensor());
+        graph->AddOpAttr(fc_name, "weight_1", weight);
+    };
+    add_fc_op("op1", "x", "op1_out", 1.f);
+    add_fc_op("op2", "op1_out", "op2_out", -3.f);
+    CHECK(graph->Freeze());
+    PTuple<int> input_shape = {1, 5, 1, 1};
+    graph->AddOpAttr("x", "input_shape", input_shape);
+    // not optimized yet, there is nothing to snapshot
+    std::string path = "graph_snapshot_round_trip.anakin.snapshot";
+    std::string key = "graph_snapshot_round_trip_key";
+    CHECK(!graph->save_snapshot(path, key));
+    CHECK(graph->Optimize());
+    CHECK(graph->save_snapshot(path, key));
+
+    Graph<X86, Precision::FP32>* loaded = new Graph<X86, Precision::FP32>();
+    CHECK(loaded->load_snapshot(path, key));
+    auto& order = graph->get_nodes_in_order();
+    CHECK(loaded->get_nodes_in_order() == order);
+    CHECK_EQ(loaded->size(), graph->size());
+    for (auto& name : order) {
+        CHECK(loaded->has_vertex(name)) << name;
+        auto node = (*graph)[name];
+        auto loaded_node = (*loaded)[name];
+        CHECK_EQ(loaded_node->get_op_name(), node->get_op_name()) << name;
+        auto arc_names = [](Graph<X86, Precision::FP32>* g, const std::string& vertex, bool in) {
+            std::vector<std::string> names;
+            for (auto& arc_it : in ? g->get_in_arc_its(vertex) : g->get_out_arc_its(vertex)) {
+                names.push_back(arc_it->bottom() + "->" + arc_it->top());
+            }
+            return names;
+        };
+        CHECK(arc_names(loaded, name, true) == arc_names(graph, name, true)) << name;
+        CHECK(arc_names(loaded, name, false) == arc_names(graph, name, false)) << name;
+        if (node->get_op_name() != "Dense") {
+            continue;
+        }
+        CHECK_EQ(loaded_node->get_attr<int>("out_dim"), 5) << name;
+        CHECK_EQ(loaded_node->get_attr<bool>("bias_term"), false) << name;
+        CHECK_EQ(loaded_node->get_attr<int>("axis"), 1) << name;
+        auto weight = node->get_attr<PBlock<X86> >("weight_1");
+        auto loaded_weight = loaded_node->get_attr<PBlock<X86> >("weight_1");
+        CHECK(loaded_weight.h_tensor().valid_shape() == weight.h_tensor().valid_shape()) << name;
+        const float* data = static_cast<const float*>(weight.h_tensor().data());
+        const float* loaded_data = static_cast<const float*>(loaded_weight.h_tensor().data());
+        for (int i = 0; i < weight.h_tensor().valid_size(); i++) {
+            CHECK_EQ(loaded_data[i], data[i]) << name << " weight differs at " << i;
+        }
+    }
+    delete loaded;
+
+    // a snapshot of another key is stale
+    Graph<X86, Precision::FP32> stale;
+    CHECK(!stale.load_snapshot(path, key + "_other"));
+
+    GraphSnapshotHeader header;
+    std::string payload;
+    CHECK(read_graph_snapshot(path, header, payload));
+    // an exec order naming nodes the payload lacks is corrupt
+    GraphSnapshotHeader ghost = header;
+    ghost.exec_order.push_back("ghost_node");
+    CHECK(write_graph_snapshot(path, ghost, payload));
+    Graph<X86, Precision::FP32> corrupt;
+    CHECK(!corrupt.load_snapshot(path, key));
+
+    // so is a truncated one
+    CHECK(write_graph_snapshot(path, header, payload));
+    std::string content;
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        file.write(content.data(), content.size() - 8);
+    }
+    Graph<X86, Precision::FP32> truncated;
+    CHECK(!truncated.load_snapshot(path, key));
+    std::remove(path.c_str());
+    delete graph;
+}
+#endif
+
 int main(int argc, const char** argv) {
     // initial logger
     logger::init(argv[0]);
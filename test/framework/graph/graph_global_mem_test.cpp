@@ -0,0 +1,205 @@
+#include <string>
+#include "graph_test.h"
+#include "graph_global_mem.h"
+#include "framework/graph/graph.h"
+#include "framework/core/net/net.h"
+
+using namespace anakin;
+using namespace anakin::graph;
+
+#ifdef USE_X86_PLACE
+
+typedef GraphGlobalMemBase<X86> GlobalMem;
+
+PBlock<X86>* load_block(GlobalMem& mem, float base, int size) {
+    saber::Shape shape({1, 1, 1, size});
+    PBlock<X86>* block = mem.new_block<AK_FLOAT>(shape);
+    float* data = static_cast<float*>(block->h_tensor().mutable_data());
+
+    for (int i = 0; i < size; i++) {
+        data[i] = base + i;
+    }
+
+    mem.dedup_block(block);
+    return block;
+}
+
+TEST(GraphTest, graph_global_mem_dedup_test) {
+    LOG(INFO) << "test for weight dedup of graph global mem.";
+    GlobalMem mem;
+    mem.set_dedup(true);
+
+    // two "models" with an identical backbone tensor and a different head
+    PBlock<X86>* backbone_a = load_block(mem, 0.f, 1024);
+    PBlock<X86>* head_a = load_block(mem, 1.f, 16);
+    PBlock<X86>* backbone_b = load_block(mem, 0.f, 1024);
+    PBlock<X86>* head_b = load_block(mem, 2.f, 16);
+    PBlock<X86>* backbone_c = load_block(mem, 0.f, 1024);
+
+    CHECK_EQ(backbone_a->d_tensor().data(), backbone_b->d_tensor().data());
+    CHECK_EQ(backbone_a->d_tensor().data(), backbone_c->d_tensor().data());
+    CHECK_NE(head_a->d_tensor().data(), head_b->d_tensor().data());
+    DedupStats stats = mem.get_dedup_stats();
+    CHECK_EQ(stats.unique_blocks, 3);
+    CHECK_EQ(stats.shared_blocks, 2);
+    CHECK_EQ(stats.saved_bytes, 2 * 1024 * sizeof(float));
+
+    // a model changing its weights (e.g. folding a batchnorm) gets its own copy
+    auto scale = [](Tensor4d<X86>& tensor, float factor) {
+        float* data = static_cast<float*>(tensor.mutable_data());
+
+        for (int i = 0; i < tensor.valid_size(); i++) {
+            data[i] *= factor;
+        }
+    };
+    mem.apply<Level_1>(scale, backbone_b->d_tensor(), 2.f);
+    CHECK_NE(backbone_a->d_tensor().data(), backbone_b->d_tensor().data());
+    CHECK_EQ(backbone_a->d_tensor().data(), backbone_c->d_tensor().data());
+    CHECK_EQ(static_cast<const float*>(backbone_a->d_tensor().data())[3], 3.f);
+    CHECK_EQ(static_cast<const float*>(backbone_b->d_tensor().data())[3], 6.f);
+    CHECK_EQ(mem.get_dedup_stats().saved_bytes, 1024 * sizeof(float));
+
+    // a second apply on the same level is still a no-op for the copy
+    mem.apply<Level_1>(scale, backbone_b->d_tensor(), 2.f);
+    CHECK_EQ(static_cast<const float*>(backbone_b->d_tensor().data())[3], 6.f);
+
+    // the changed content isn't matched by later loads, the unchanged one is
+    PBlock<X86>* backbone_d = load_block(mem, 0.f, 1024);
+    CHECK_EQ(backbone_a->d_tensor().data(), backbone_d->d_tensor().data());
+    CHECK_EQ(mem.get_dedup_stats().saved_bytes, 2 * 1024 * sizeof(float));
+
+    mem.clean_all();
+    CHECK_EQ(mem.get_dedup_stats().shared_blocks, 0);
+}
+
+/// x -> conv_0 (the backbone, same weights in every graph) -> head -> y
+PBlock<X86>* add_backbone(Graph<X86, Precision::FP32>& graph, const std::string& head) {
+    graph.AddOp("conv_0", "Convolution", {"x"}, {"conv_0_out"});
+    graph.AddOpAttr("conv_0", "group", 1);
+    graph.AddOpAttr("conv_0", "bias_term", false);
+    graph.AddOpAttr<PTuple<int>>("conv_0", "padding", {1, 1});
+    graph.AddOpAttr<PTuple<int>>("conv_0", "strides", {1, 1});
+    graph.AddOpAttr<PTuple<int>>("conv_0", "dilation_rate", {1, 1});
+    graph.AddOpAttr("conv_0", "filter_num", 4);
+    graph.AddOpAttr<PTuple<int>>("conv_0", "kernel_size", {3, 3});
+    graph.AddOpAttr("conv_0", "axis", 1);
+
+    saber::Shape shape({4, 2, 3, 3});
+    auto& mem = GraphGlobalMem<X86>::Global();
+    PBlock<X86>* weight = mem.new_block<AK_FLOAT>(shape);
+    float* data = static_cast<float*>(weight->h_tensor().mutable_data());
+
+    for (int i = 0; i < shape.count(); i++) {
+        data[i] = 0.01f * i;
+    }
+
+    weight->d_tensor().set_shape(shape);
+    weight->d_tensor().copy_from(weight->h_tensor());
+    mem.dedup_block(weight);
+    graph.AddOpAttr("conv_0", "weight_1", *weight);
+
+    if (head == "ReLU") {
+        graph.AddOp("head", "ReLU", {"conv_0_out"}, {"y"});
+        graph.AddOpAttr("head", "alpha", 0.0f);
+    } else {
+        graph.AddOp("head", "Pooling", {"conv_0_out"}, {"y"});
+        graph.AddOpAttr("head", "method", std::string("MAX"));
+        graph.AddOpAttr<PTuple<int>>("head", "pool_size", {2, 2});
+        graph.AddOpAttr<PTuple<int>>("head", "strides", {2, 2});
+        graph.AddOpAttr<PTuple<int>>("head", "padding", {0, 0});
+        graph.AddOpAttr("head", "global_pooling", false);
+        graph.AddOpAttr("head", "cmp_out_shape_floor_as_conv", true);
+    }
+
+    CHECK(graph.Freeze());
+    CHECK(graph.Optimize());
+    graph.AddOpAttr<PTuple<int>>("x", "input_shape", {1, 2, 8, 8});
+    return weight;
+}
+
+TEST(GraphTest, graph_global_mem_dedup_net_test) {
+    LOG(INFO) << "test for weight dedup of two nets sharing a conv backbone.";
+    GraphGlobalMem<X86>::Global().set_dedup(true);
+    Graph<X86, Precision::FP32> graph_a;
+    Graph<X86, Precision::FP32> graph_b;
+    PBlock<X86>* weight_a = add_backbone(graph_a, "ReLU");
+    PBlock<X86>* weight_b = add_backbone(graph_b, "Pooling");
+    CHECK_EQ(weight_a->d_tensor().data(), weight_b->d_tensor().data());
+
+    // Net::init runs trans_weights on the conv weights through apply, the x86 conv doesn't
+    // change them so both nets must stay on the same memory
+    Net<X86, Precision::FP32> net_a(true);
+    Net<X86, Precision::FP32> net_b(true);
+    net_a.init(graph_a);
+    net_b.init(graph_b);
+    CHECK_EQ(weight_a->d_tensor().data(), weight_b->d_tensor().data());
+    CHECK_GE(GraphGlobalMem<X86>::Global().get_dedup_stats().saved_bytes,
+             weight_a->d_tensor().valid_size() * sizeof(float));
+    GraphGlobalMem<X86>::Global().set_dedup(false);
+}
+
+#endif
+
+#ifdef USE_CUDA
+
+TEST(GraphTest, graph_global_mem_dedup_host_test) {
+    LOG(INFO) << "test for weight dedup of blocks with a host tensor of their own.";
+    GraphGlobalMemBase<NV> mem;
+    mem.set_dedup(true);
+    saber::Shape shape({1, 1, 1, 1024});
+    auto load = [&]() {
+        PBlock<NV>* block = mem.new_block<AK_FLOAT>(shape);
+        float* data = static_cast<float*>(block->h_tensor().mutable_data());
+
+        for (int i = 0; i < shape.count(); i++) {
+            data[i] = i;
+        }
+
+        block->d_tensor().copy_from(block->h_tensor());
+        mem.dedup_block(block);
+        return block;
+    };
+    PBlock<NV>* block_a = load();
+    PBlock<NV>* block_b = load();
+    CHECK_EQ(block_a->h_tensor().data(), block_b->h_tensor().data());
+    CHECK_EQ(block_a->d_tensor().data(), block_b->d_tensor().data());
+
+    // like the weights fusions: change the host tensor, then copy it to the device
+    auto scale = [](PBlock<NV>& block, float factor) {
+        float* data = static_cast<float*>(block.h_tensor().mutable_data());
+
+        for (int i = 0; i < block.h_tensor().valid_size(); i++) {
+            data[i] *= factor;
+        }
+
+        block.d_tensor().copy_from(block.h_tensor());
+    };
+    mem.apply<Level_1>(scale, *block_b, 2.f);
+    CHECK_NE(block_a->h_tensor().data(), block_b->h_tensor().data());
+    CHECK_NE(block_a->d_tensor().data(), block_b->d_tensor().data());
+    CHECK_EQ(static_cast<const float*>(block_a->h_tensor().data())[3], 3.f);
+    CHECK_EQ(static_cast<const float*>(block_b->h_tensor().data())[3], 6.f);
+
+    Tensor4d<NVHX86> device_a(shape);
+    Tensor4d<NVHX86> device_b(shape);
+    device_a.copy_from(block_a->d_tensor());
+    device_b.copy_from(block_b->d_tensor());
+    CHECK_EQ(static_cast<const float*>(device_a.data())[3], 3.f);
+    CHECK_EQ(static_cast<const float*>(device_b.data())[3], 6.f);
+    CHECK_EQ(mem.get_dedup_stats().saved_bytes, 0);
+
+    mem.clean_all();
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+#ifdef USE_CUDA
+    Env<NV>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <string>
+#include "graph_test.h"
+#include "framework/graph/llvm/virtual_graph.h"
+#include "framework/graph/llvm/scheduler.h"
+#include "framework/graph/llvm/optimizer/memory_scheduler.h"
+
+using namespace anakin;
+using namespace anakin::graph;
+
+void add_node(VGraph& graph, std::string name, std::string op_name) {
+    node tmp_node;
+    tmp_node.name = name;
+    tmp_node.opName = op_name;
+    graph.add_vertex(name, tmp_node);
+}
+
+void add_arc(VGraph& graph, std::string bottom, std::string top) {
+    io new_io;
+    Arc<std::string, io> arc(bottom, top, new_io);
+    arc.weight().name = arc.name();
+    graph.add_in_arc(arc);
+    graph.add_out_arc(arc);
+}
+
+TEST(GraphTest, memory_scheduler_shape_const_test) {
+    // ssd like head: prior boxes of two feature maps, concatenated for the detection
+    VGraph graph;
+    add_node(graph, "input", "Input");
+    add_node(graph, "output", "Output");
+    add_node(graph, "detection", "DetectionOutput");
+    add_node(graph, "concat", "Concat");
+
+    for (int i = 0; i < 6; i++) {
+        add_node(graph, "conv_" + std::to_string(i), "Convolution");
+    }
+
+    for (int i = 0; i < 2; i++) {
+        add_node(graph, "prior_" + std::to_string(i), "PriorBox");
+    }
+
+    add_arc(graph, "input", "conv_0");
+
+    for (int i = 0; i < 5; i++) {
+        add_arc(graph, "conv_" + std::to_string(i), "conv_" + std::to_string(i + 1));
+    }
+
+    add_arc(graph, "conv_2", "prior_0");
+    add_arc(graph, "input", "prior_0");
+    add_arc(graph, "conv_5", "prior_1");
+    add_arc(graph, "input", "prior_1");
+    add_arc(graph, "prior_0", "concat");
+    add_arc(graph, "prior_1", "concat");
+    add_arc(graph, "conv_5", "detection");
+    add_arc(graph, "concat", "detection");
+    add_arc(graph, "detection", "output");
+
+    Scheduler scheduler;
+    scheduler.RegIOResource(&graph);
+    scheduler.Run();
+    MemoryScheduler mem_scheduler;
+    mem_scheduler.RegIOResource(&graph);
+    mem_scheduler.Run();
+
+    auto is_kept = [](const std::string& name) {
+        return name.find("prior_") == 0 || name.find("concat") == 0;
+    };
+    int shared = 0;
+    auto check_arc = [&](Arc<std::string, io>& arc) {
+        auto& arc_io = arc.weight();
+
+        if (is_kept(arc.bottom())) {
+            CHECK(!arc_io.shared) << arc_io.name << " of a shape const op reuses memory";
+        }
+
+        if (arc_io.shared) {
+            CHECK(!is_kept(arc_io.share_from)) << arc_io.name << " reuses " << arc_io.share_from;
+            shared++;
+        }
+
+        return Status::OK();
+    };
+    graph.Scanner->BFS_Edge(check_arc);
+    // the convolutions still share memory
+    CHECK_GT(shared, 0);
+
+    check_shape_const shape_const;
+    CHECK(shape_const("PriorBox", {false, false}));
+    CHECK(shape_const("Concat", {true, true}));
+    CHECK(!shape_const("Concat", {true, false}));
+    CHECK(!shape_const("Output", {true}));
+}
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include <string>
+#include <chrono>
+#include <algorithm>
 #include "graph_test.h"
 #include "graph_base.h"
 #include "framework/graph/graph.h"
@@ -281,6 +283,60 @@ TEST(GraphTest, graph_base_test) {
 
 }
 
+/// input -> conv_0 -> relu_0 -> conv_1 -> relu_1 ... , fused by the ConvRelu pattern.
+/// returns the milliseconds taken to build and fuse it.
+double fuse_conv_relu_chain(int pairs) {
+    auto start = std::chrono::steady_clock::now();
+    VGraph graph;
+    node input;
+    input.name = "input";
+    input.opName = "Input";
+    graph.add_vertex(input.name, input);
+    std::string last = input.name;
+
+    for (int i = 0; i < pairs; i++) {
+        for (auto op : {"Convolution", "ReLU"}) {
+            node tmp_node;
+            tmp_node.name = (op[0] == 'C' ? "conv_" : "relu_") + std::to_string(i);
+            tmp_node.opName = op;
+            graph.add_vertex(tmp_node.name, tmp_node);
+            io new_io;
+            edge arc(last, tmp_node.name, new_io);
+            arc.weight().name = arc.name();
+            graph.add_in_arc(arc);
+            graph.add_out_arc(arc);
+            last = tmp_node.name;
+        }
+    }
+
+    graph.Match(FusionOpRegister::Global()["ConvRelu"]);
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+
+    CHECK_EQ(graph.size(), pairs + 1);
+    CHECK_EQ(graph.nodes_of_op("ConvRelu").size(), pairs);
+    CHECK(graph.nodes_of_op("ReLU").empty());
+    CHECK(graph.has_arc("input", "conv_0"));
+    for (int i = 0; i + 1 < pairs; i++) {
+        std::string bottom = "conv_" + std::to_string(i);
+        std::string top = "conv_" + std::to_string(i + 1);
+        CHECK(graph.has_arc(bottom, top)) << " missing fused arc " << bottom << " -> " << top;
+        CHECK_EQ(graph.get_out_arc_its(bottom).size(), 1);
+        CHECK_EQ(graph.get_in_arc_its(top).size(), 1);
+        CHECK_EQ(graph[bottom].mergeNodes.size(), 1);
+    }
+    return ms;
+}
+
+TEST(GraphTest, vgraph_fusion_scaling_test) {
+    // warm up the pattern registry and the allocator
+    fuse_conv_relu_chain(100);
+    double small_ms = fuse_conv_relu_chain(500);
+    double large_ms = fuse_conv_relu_chain(5000);
+    LOG(INFO) << "fuse 1k nodes: " << small_ms << " ms, 10k nodes: " << large_ms << " ms";
+    // near linear is ~10x, the old full scans were ~100x
+    CHECK_LT(large_ms, 30 * std::max(small_ms, 1.0)) << " fusion doesn't scale linearly";
+}
 
 int main(int argc, const char** argv) {
     // initial logger
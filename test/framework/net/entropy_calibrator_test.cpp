@@ -0,0 +1,134 @@
+#include <string>
+#include "net_test.h"
+#include "framework/core/net/entropy_calibrator.h"
+#include "saber/core/tensor_op.h"
+
+#if defined(USE_X86_PLACE) && !defined(USE_SGX)
+
+/// exposes the statistics of EntropyCalibrator, no net is needed for them
+class TestCalibrator : public EntropyCalibrator<X86> {
+public:
+    TestCalibrator(BatchStream<X86>* stream, int bin_num) :
+        EntropyCalibrator<X86>(stream, 1, "calibrator_test.txt", nullptr, bin_num) {}
+
+    using EntropyCalibrator<X86>::init_statistics;
+    using EntropyCalibrator<X86>::max_data;
+    using EntropyCalibrator<X86>::histgram;
+    using EntropyCalibrator<X86>::get_kl_thresh;
+    using EntropyCalibrator<X86>::get_kl_threshes;
+    using EntropyCalibrator<X86>::next_batch_data;
+    using EntropyCalibrator<X86>::max_vec;
+    using EntropyCalibrator<X86>::hist_vecs;
+};
+
+std::vector<Tensor<X86>*> g_batches;
+int g_batch_id = 0;
+
+Tensor<X86>* produce_batch() {
+    if (g_batch_id >= g_batches.size()) {
+        return nullptr;
+    }
+    return g_batches[g_batch_id++];
+}
+
+TEST(NetTest, entropy_calibrator_statistics_test) {
+    LOG(INFO) << "test parallel histgrams and thresholds of the entropy calibrator against serial ones.";
+    const int bin_num = 2048;
+    const int tensor_num = 3;
+    BatchStream<X86> stream(produce_batch);
+    TestCalibrator calibrator(&stream, bin_num);
+    calibrator.init_statistics(tensor_num);
+
+    std::vector<Tensor<X86>*> tensors;
+    for (int i = 0; i < tensor_num; i++) {
+        // a wide main mode and a few outliers, so the thresholds differ
+        tensors.push_back(new Tensor<X86>(Shape({2, 3 + i, 37, 41})));
+        fill_tensor_rand(*tensors[i], -1.f - i, 1.f + i);
+        float* data = static_cast<float*>(tensors[i]->mutable_data());
+        data[0] = 20.f * (i + 1);
+        data[1] = -15.f * (i + 1);
+    }
+
+    for (int i = 0; i < tensor_num; i++) {
+        calibrator.max_data(tensors[i], i);
+        calibrator.histgram(tensors[i], i);
+        // twice, the histgrams add up over batches
+        calibrator.histgram(tensors[i], i);
+    }
+
+    for (int i = 0; i < tensor_num; i++) {
+        const float* data = static_cast<const float*>(tensors[i]->data());
+        float max_value = 0.f;
+        for (int k = 0; k < tensors[i]->valid_size(); k++) {
+            max_value = std::max(max_value, fabsf(data[k]));
+        }
+        CHECK_EQ(calibrator.max_vec()[i], max_value);
+
+        std::vector<int> hist(bin_num, 0);
+        float step = max_value / bin_num;
+        for (int k = 0; k < tensors[i]->valid_size(); k++) {
+            int id = fabsf(data[k]) / step;
+            hist[id < bin_num ? id : bin_num - 1] += 2;
+        }
+        CHECK(hist == calibrator.hist_vecs()[i]) << "histgram " << i << " differs from the serial one";
+    }
+
+    std::vector<int> threshes = calibrator.get_kl_threshes();
+    CHECK_EQ(threshes.size(), tensor_num);
+    for (int i = 0; i < tensor_num; i++) {
+        CHECK_EQ(threshes[i], calibrator.get_kl_thresh(calibrator.hist_vecs()[i]));
+    }
+
+    for (auto tensor : tensors) {
+        delete tensor;
+    }
+}
+
+TEST(NetTest, entropy_calibrator_streaming_test) {
+    LOG(INFO) << "test that the streaming mode of the entropy calibrator feeds the same batches.";
+    for (int i = 0; i < 5; i++) {
+        g_batches.push_back(new Tensor<X86>(Shape({1 + i % 2, 3, 8, 8})));
+        fill_tensor_const(*g_batches[i], float(i + 1));
+    }
+
+    auto run = [](bool streaming) {
+        g_batch_id = 0;
+        BatchStream<X86> stream(produce_batch);
+        TestCalibrator calibrator(&stream, 2048);
+        calibrator.set_streaming(streaming);
+        Tensor<X86> input(Shape({1, 3, 8, 8}));
+        std::vector<Tensor4dPtr<X86>> inputs = {&input};
+        std::vector<float> fed;
+
+        while (int num = calibrator.next_batch_data(inputs)) {
+            CHECK_EQ(num, input.num());
+            CHECK_EQ(input.valid_size(), num * 3 * 8 * 8);
+            const float* data = static_cast<const float*>(input.data());
+            for (int k = 0; k < input.valid_size(); k++) {
+                CHECK_EQ(data[k], data[0]);
+            }
+            fed.push_back(data[0]);
+        }
+        return fed;
+    };
+
+    std::vector<float> serial = run(false);
+    std::vector<float> streaming = run(true);
+    CHECK_EQ(serial.size(), g_batches.size());
+    CHECK(serial == streaming) << "streaming mode fed other batches";
+
+    for (auto tensor : g_batches) {
+        delete tensor;
+    }
+    g_batches.clear();
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
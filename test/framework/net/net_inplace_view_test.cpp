@@ -0,0 +1,235 @@
+#include <string>
+#include <algorithm>
+#include "net_test.h"
+#include "saber/core/tensor_op.h"
+
+#if defined(USE_X86_PLACE) && !defined(USE_CUDA)
+
+namespace anakin {
+
+namespace ops {
+
+template<typename Ttype, Precision Ptype>
+class PrefixHelper;
+
+/// test op whose output shape depends on data: the first in[0] values of its input,
+/// reshaped in the launch like DetectionOutput or GenerateProposals do
+template<typename Ttype, Precision Ptype>
+class Prefix : public Operator<Ttype, Ptype> {
+public:
+    Prefix() {}
+
+    virtual void operator() (OpContext<Ttype>& ctx,
+                             const std::vector<Tensor4dPtr<Ttype> >& ins,
+                             std::vector<Tensor4dPtr<Ttype> >& outs) {
+        const float* in = static_cast<const float*>(ins[0]->data());
+        int num = std::max(1, std::min(static_cast<int>(in[0]), ins[0]->channel()));
+        outs[0]->reshape(Shape({1, num, 1, 1}));
+        float* out = static_cast<float*>(outs[0]->mutable_data());
+        for (int i = 0; i < num; i++) {
+            out[i] = in[i];
+        }
+    }
+
+    friend class PrefixHelper<Ttype, Ptype>;
+};
+
+template<typename Ttype, Precision Ptype>
+class PrefixHelper : public OperatorHelper<Ttype, Ptype> {
+public:
+    Status InitParam() override {
+        return Status::OK();
+    }
+
+    Status Init(OpContext<Ttype>& ctx,
+                const std::vector<Tensor4dPtr<Ttype> >& ins,
+                std::vector<Tensor4dPtr<Ttype> >& outs) override {
+        return Status::OK();
+    }
+
+    //! the longest prefix, the launch knows the real one
+    Status InferShape(const std::vector<Tensor4dPtr<Ttype> >& ins,
+                      std::vector<Tensor4dPtr<Ttype> >& outs) override {
+        outs[0]->reshape(Shape({1, ins[0]->channel(), 1, 1}));
+        return Status::OK();
+    }
+};
+
+ANAKIN_REGISTER_OP_HELPER(Prefix, PrefixHelper, X86, Precision::FP32);
+
+ANAKIN_REGISTER_OP(Prefix)
+.Doc("test op with a data dependent output shape")
+.__alias__<X86, Precision::FP32>("prefix")
+.num_in(1)
+.num_out(1);
+
+} /* namespace ops */
+
+} /* namespace anakin */
+
+/// x and y through Prefix ops into a Concat, the Concat is planned in place
+Graph<X86, Precision::FP32>* prefix_concat_graph() {
+    auto* graph = new Graph<X86, Precision::FP32>();
+    graph->AddOp("px", "Prefix", {"x"}, {"px_out"});
+    graph->AddOp("py", "Prefix", {"y"}, {"py_out"});
+    graph->AddOp("cat", "Concat", {"px_out", "py_out"}, {"cat_out"});
+    graph->AddOpAttr("cat", "axis", 1);
+    auto status = graph->Freeze();
+    if (!status) {
+        LOG(FATAL) << "Freeze error";
+    }
+    graph->Optimize();
+    anakin::PTuple<int> x_shape = {1, 4, 1, 1};
+    anakin::PTuple<int> y_shape = {1, 3, 1, 1};
+    graph->AddOpAttr("x", "input_shape", x_shape);
+    graph->AddOpAttr("y", "input_shape", y_shape);
+    return graph;
+}
+
+/// predict with prefixes of x_num and y_num values, check the concatenation
+void run_prefix_concat(Net<X86, Precision::FP32>& net, int x_num, int y_num) {
+    std::vector<float> expect;
+    int base = 10;
+    for (auto item : {std::make_pair("x", x_num), std::make_pair("y", y_num)}) {
+        auto in = net.get_in(item.first);
+        float* data = static_cast<float*>(in->mutable_data());
+        data[0] = item.second;
+        expect.push_back(item.second);
+        for (int i = 1; i < in->valid_size(); i++) {
+            data[i] = base + i;
+            if (i < item.second) {
+                expect.push_back(data[i]);
+            }
+        }
+        base += 10;
+    }
+    net.prediction();
+    auto out = net.get_out("cat_out");
+    const float* data = static_cast<const float*>(out->data());
+    CHECK_EQ(out->valid_size(), expect.size()) << "prefixes " << x_num << ", " << y_num;
+    for (int i = 0; i < expect.size(); i++) {
+        CHECK_EQ(data[i], expect[i]) << "prefixes " << x_num << ", " << y_num << " differ at " << i;
+    }
+}
+
+TEST(NetTest, net_inplace_view_data_shape_test) {
+    LOG(INFO) << "test in-place Concat fed by a producer which shortens its output in the launch.";
+    auto* graph = prefix_concat_graph();
+    Net<X86, Precision::FP32> net(true);
+    net.init(*graph);
+    // the launches keep the inferred shapes: the first run is without views, the next with
+    run_prefix_concat(net, 4, 3);
+    run_prefix_concat(net, 4, 3);
+    run_prefix_concat(net, 4, 3);
+    // px shortens px_out inside its view, the Concat has to close the gap
+    run_prefix_concat(net, 2, 3);
+    // px_out has memory of its own again, growing it is fine
+    run_prefix_concat(net, 4, 3);
+    run_prefix_concat(net, 1, 2);
+}
+
+TEST(NetTest, net_inplace_view_data_shape_first_run_test) {
+    LOG(INFO) << "test in-place Concat whose producers reshape their outputs from the first run.";
+    auto* graph = prefix_concat_graph();
+    Net<X86, Precision::FP32> net(true);
+    net.init(*graph);
+    // dropped before any view is placed, or growing px_out next would overflow its view
+    run_prefix_concat(net, 2, 1);
+    run_prefix_concat(net, 4, 3);
+    run_prefix_concat(net, 3, 3);
+}
+
+/// priors of two PriorBox ops concatenated along the batch, which lets the Concat run in
+/// place if nothing keeps it from it
+Graph<X86, Precision::FP32>* prior_concat_graph() {
+    auto* graph = new Graph<X86, Precision::FP32>();
+    auto add_prior_box = [&](const std::string& name, float min_size) {
+        PTuple<float> min_sizes = {min_size};
+        PTuple<float> max_sizes = {2 * min_size};
+        PTuple<float> aspect_ratios = {2.f};
+        PTuple<float> variances = {0.1f, 0.1f, 0.2f, 0.2f};
+        PTuple<std::string> order(std::vector<std::string>({"MIN", "MAX", "COM"}));
+        graph->AddOp(name, "PriorBox", {"feat", "img"}, {name + "_out"});
+        graph->AddOpAttr(name, "min_size", min_sizes);
+        graph->AddOpAttr(name, "max_size", max_sizes);
+        graph->AddOpAttr(name, "aspect_ratio", aspect_ratios);
+        graph->AddOpAttr(name, "is_flip", true);
+        graph->AddOpAttr(name, "is_clip", false);
+        graph->AddOpAttr(name, "variance", variances);
+        graph->AddOpAttr(name, "img_h", 0);
+        graph->AddOpAttr(name, "img_w", 0);
+        graph->AddOpAttr(name, "step_h", 0.f);
+        graph->AddOpAttr(name, "step_w", 0.f);
+        graph->AddOpAttr(name, "offset", 0.5f);
+        graph->AddOpAttr(name, "order", order);
+    };
+    add_prior_box("pb1", 4.f);
+    add_prior_box("pb2", 8.f);
+    graph->AddOp("cat", "Concat", {"pb1_out", "pb2_out"}, {"cat_out"});
+    graph->AddOpAttr("cat", "axis", 0);
+    auto status = graph->Freeze();
+    if (!status) {
+        LOG(FATAL) << "Freeze error";
+    }
+    graph->Optimize();
+    anakin::PTuple<int> feat_shape = {1, 4, 3, 3};
+    anakin::PTuple<int> img_shape = {1, 3, 30, 30};
+    graph->AddOpAttr("feat", "input_shape", feat_shape);
+    graph->AddOpAttr("img", "input_shape", img_shape);
+    return graph;
+}
+
+TEST(NetTest, net_inplace_view_shape_const_test) {
+    LOG(INFO) << "test cached priors next to in-place views across input shape changes.";
+    Net<X86, Precision::FP32> net(true);
+    net.init(*prior_concat_graph());
+    // reference: every op launched at every prediction
+    Net<X86, Precision::FP32> ref(true);
+    ref.set_shape_const_cache(false);
+    ref.set_inplace_views(false);
+    ref.init(*prior_concat_graph());
+
+    std::vector<float> last;
+    auto check = [&](std::vector<int> feat_shape, std::vector<int> img_shape) {
+        for (auto* executer : {&net, &ref}) {
+            executer->get_in("feat")->reshape(Shape(feat_shape));
+            executer->get_in("img")->reshape(Shape(img_shape));
+            fill_tensor_const(*executer->get_in("feat"), 1.f);
+            fill_tensor_const(*executer->get_in("img"), 1.f);
+        }
+        // the second run takes the priors of the first from the cache
+        for (int run = 0; run < 2; run++) {
+            net.prediction();
+            ref.prediction();
+            auto out = net.get_out("cat_out");
+            auto ref_out = ref.get_out("cat_out");
+            CHECK(out->valid_shape() == ref_out->valid_shape()) << "run " << run;
+            const float* data = static_cast<const float*>(out->data());
+            const float* ref_data = static_cast<const float*>(ref_out->data());
+            for (int i = 0; i < out->valid_size(); i++) {
+                CHECK_EQ(data[i], ref_data[i]) << "run " << run << ", prior differs at " << i;
+            }
+            if (run == 0) {
+                CHECK(std::vector<float>(data, data + out->valid_size()) != last)
+                        << "priors are not recomputed for new input shapes";
+                last.assign(data, data + out->valid_size());
+            }
+        }
+    };
+    check({1, 4, 3, 3}, {1, 3, 30, 30});
+    check({1, 4, 5, 4}, {1, 3, 50, 40});
+    check({1, 4, 3, 3}, {1, 3, 60, 60});
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+#if defined(USE_X86_PLACE) && !defined(USE_CUDA)
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
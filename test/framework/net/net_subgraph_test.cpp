@@ -608,6 +608,201 @@ TEST(NetTest, net_execute_subgraph_test_share_from) {
 //    test_print(p);
 }
 
+#ifdef USE_X86_PLACE
+TEST(NetTest, net_execute_subgraph_bind_input_with_split) {
+    Graph<Target, Precision::FP32>* graph = new Graph<Target, Precision::FP32>();
+
+    auto add_fc_op = [&](const std::string& fc_name,
+                         const std::vector<std::string>& input,
+                         const std::vector<std::string>& output) {
+        graph->AddOp(fc_name, "Dense", input, output);
+        graph->AddOpAttr(fc_name, "out_dim", 5);
+        graph->AddOpAttr(fc_name, "bias_term", false);
+        graph->AddOpAttr(fc_name, "axis", 1);
+        std::vector<int> shape = {1, 1, 5, 5};
+        anakin::saber::Shape tmp_shape{shape};
+        PBlock<Target> weight1(tmp_shape);
+        float *cpu_data = static_cast<float *>(weight1.h_tensor().mutable_data());
+        for (int i = 0; i < 5*5; i++) { cpu_data[i] = i + 1; }
+
+        weight1.d_tensor().set_shape(tmp_shape);
+        weight1.d_tensor().copy_from(weight1.h_tensor());
+
+        graph->AddOpAttr(fc_name, "weight_1", weight1);
+    };
+
+    // x feeds two ops, so a Split sharing the input memory follows the input
+    add_fc_op("op1", {"x"}, {"op1_out"});
+    add_fc_op("op2", {"x"}, {"op2_out"});
+
+    auto status = graph->Freeze();
+    if (!status){
+        LOG(FATAL) << "Freeze error";
+    }
+    graph->Optimize();
+
+    anakin::PTuple<int> input_shape = {1, 5, 1, 1};
+    graph->AddOpAttr("x", "input_shape", input_shape);
+
+    std::unique_ptr<Net<Target, Precision::FP32> > net_executer_p(new Net<Target, Precision::FP32>(true));
+    net_executer_p->init(*graph);
+
+    auto d_tensor_in_p = net_executer_p->get_in("x");
+    auto fill_tensor = [](Tensor4d<Target_H>& tensor, float base) {
+        float* data = (float*)(tensor.mutable_data());
+        for (int i = 0; i < tensor.valid_size(); i++) {
+            data[i] = base + i;
+        }
+    };
+    Tensor4d<Target_H> h_tensor_in(d_tensor_in_p->valid_shape());
+    Tensor4d<Target_H> h_tensor_old(d_tensor_in_p->valid_shape());
+    fill_tensor(h_tensor_in, 1.f);
+    fill_tensor(h_tensor_old, -7.f);
+
+    // reference: the data copied into the input
+    d_tensor_in_p->copy_from(h_tensor_in);
+    net_executer_p->prediction();
+    std::vector<std::vector<float> > ref;
+    for (auto name : {"op1_out", "op2_out"}) {
+        auto out = net_executer_p->get_out(name);
+        const float* data = (const float*)out->data();
+        ref.emplace_back(data, data + out->valid_size());
+    }
+
+    // leave other data in the input buffer, then bind the same data as above, falling
+    // back to a copy like Worker::sync_prediction_bind when the binding is refused
+    d_tensor_in_p->copy_from(h_tensor_old);
+    auto bind_status = net_executer_p->bind_input("x", h_tensor_in.mutable_data(),
+                                                  h_tensor_in.valid_shape());
+    CHECK(!(bind_status == Status::OK())) << "bind_input must refuse an input shared by a Split";
+    d_tensor_in_p->copy_from(h_tensor_in);
+    net_executer_p->prediction();
+
+    int i = 0;
+    for (auto name : {"op1_out", "op2_out"}) {
+        auto out = net_executer_p->get_out(name);
+        const float* data = (const float*)out->data();
+        CHECK_EQ(out->valid_size(), ref[i].size());
+        for (int j = 0; j < out->valid_size(); j++) {
+            CHECK_EQ(data[j], ref[i][j]) << name << " differs at " << j;
+        }
+        i++;
+    }
+    net_executer_p->unbind("x");
+}
+#endif
+
+#if defined(USE_X86_PLACE) && !defined(USE_CUDA)
+// host memory is only aliased when the net runs on the host
+TEST(NetTest, net_execute_subgraph_bind_input_output) {
+    Graph<Target, Precision::FP32>* graph = new Graph<Target, Precision::FP32>();
+
+    auto add_fc_op = [&](const std::string& fc_name,
+                         const std::vector<std::string>& input,
+                         const std::vector<std::string>& output) {
+        graph->AddOp(fc_name, "Dense", input, output);
+        graph->AddOpAttr(fc_name, "out_dim", 5);
+        graph->AddOpAttr(fc_name, "bias_term", false);
+        graph->AddOpAttr(fc_name, "axis", 1);
+        std::vector<int> shape = {1, 1, 5, 5};
+        anakin::saber::Shape tmp_shape{shape};
+        PBlock<Target> weight1(tmp_shape);
+        float *cpu_data = static_cast<float *>(weight1.h_tensor().mutable_data());
+        for (int i = 0; i < 5*5; i++) { cpu_data[i] = (i % 7) - 3; }
+
+        weight1.d_tensor().set_shape(tmp_shape);
+        weight1.d_tensor().copy_from(weight1.h_tensor());
+
+        graph->AddOpAttr(fc_name, "weight_1", weight1);
+    };
+
+    // a plain chain, nothing else shares the memory of x or op2_out
+    add_fc_op("op1", {"x"}, {"op1_out"});
+    add_fc_op("op2", {"op1_out"}, {"op2_out"});
+
+    auto status = graph->Freeze();
+    if (!status){
+        LOG(FATAL) << "Freeze error";
+    }
+    graph->Optimize();
+
+    anakin::PTuple<int> input_shape = {1, 5, 1, 1};
+    graph->AddOpAttr("x", "input_shape", input_shape);
+    std::string model_path = "bind_input_output.saved";
+    status = graph->save(model_path);
+    if (!status) {
+        LOG(FATAL) << " [ERROR] " << status.info();
+    }
+
+    std::unique_ptr<Net<Target, Precision::FP32> > net_executer_p(new Net<Target, Precision::FP32>(true));
+    net_executer_p->init(*graph);
+
+    auto d_tensor_in_p = net_executer_p->get_in("x");
+    auto d_tensor_out_p = net_executer_p->get_out("op2_out");
+    auto fill_tensor = [](Tensor4d<Target_H>& tensor, float base) {
+        float* data = (float*)(tensor.mutable_data());
+        for (int i = 0; i < tensor.valid_size(); i++) {
+            data[i] = base + i;
+        }
+    };
+    Tensor4d<Target_H> h_tensor_in(d_tensor_in_p->valid_shape());
+    Tensor4d<Target_H> h_tensor_old(d_tensor_in_p->valid_shape());
+    fill_tensor(h_tensor_in, 1.f);
+    fill_tensor(h_tensor_old, -7.f);
+
+    // reference: the unbound run, data copied in and out
+    d_tensor_in_p->copy_from(h_tensor_in);
+    net_executer_p->prediction();
+    const float* out_data = (const float*)d_tensor_out_p->data();
+    std::vector<float> ref(out_data, out_data + d_tensor_out_p->valid_size());
+
+    auto check_out = [&](const Tensor4d<Target_H>& out, const char* path) {
+        const float* data = (const float*)out.data();
+        CHECK_EQ(out.valid_size(), ref.size()) << path;
+        for (int j = 0; j < out.valid_size(); j++) {
+            CHECK_EQ(data[j], ref[j]) << path << " differs from the unbound run at " << j;
+        }
+    };
+
+    // leave other data in the net buffers, the bound run must not read them
+    d_tensor_in_p->copy_from(h_tensor_old);
+    Tensor4d<Target_H> h_tensor_out(d_tensor_out_p->valid_shape());
+    fill_tensor(h_tensor_out, 0.f);
+    CHECK(net_executer_p->bind_input("x", h_tensor_in.mutable_data(),
+                                     h_tensor_in.valid_shape()) == Status::OK());
+    CHECK(net_executer_p->bind_output("op2_out", h_tensor_out.mutable_data(),
+                                      h_tensor_out.valid_size() * sizeof(float)) == Status::OK());
+    CHECK_EQ(d_tensor_in_p->data(), h_tensor_in.data());
+    CHECK_EQ(d_tensor_out_p->data(), h_tensor_out.data());
+    net_executer_p->prediction();
+    check_out(h_tensor_out, "bound net");
+
+    // a bound output must refuse a buffer too small for it
+    Tensor4d<Target_H> h_tensor_small(Shape({1, 1, 1, 1}));
+    CHECK(!(net_executer_p->bind_output("op2_out", h_tensor_small.mutable_data(),
+                                        sizeof(float)) == Status::OK()));
+    net_executer_p->unbind("x");
+    net_executer_p->unbind("op2_out");
+
+    // the same through the worker, on its own net
+    Worker<Target, Precision::FP32> workers(model_path, 1);
+    workers.register_inputs({"x"});
+    workers.register_outputs({"op2_out"});
+    workers.launch();
+    std::vector<Tensor4d<Target_H> > ins(1);
+    ins[0].re_alloc(h_tensor_in.valid_shape());
+    ins[0].copy_from(h_tensor_in);
+    std::vector<Tensor4d<Target_H> > outs(1);
+    outs[0].re_alloc(h_tensor_out.valid_shape());
+    fill_tensor(outs[0], 0.f);
+    CHECK(workers.sync_prediction_bind(ins, outs).get() == Status::OK());
+    check_out(outs[0], "sync_prediction_bind");
+    auto copied = workers.sync_prediction(ins).get();
+    CHECK_EQ(copied.size(), 1);
+    check_out(copied[0], "sync_prediction");
+}
+#endif
+
 
 int main(int argc, const char** argv){
 	Env<Target>::env_init();
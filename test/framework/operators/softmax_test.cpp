@@ -0,0 +1,89 @@
+#include <cmath>
+#include "operator_tests.h"
+#include "framework/graph/graph.h"
+#include "framework/core/net/net.h"
+#include "saber/core/tensor_op.h"
+
+#if defined(USE_X86_PLACE) && !defined(USE_CUDA)
+
+using namespace anakin::graph;
+
+/// softmax of scale * x + mask along the channels, mask is broadcast over n, h and w
+void softmax_ref(const Tensor<X86>& x, const std::vector<float>& mask,
+                 float scale, bool log_softmax, std::vector<float>& out) {
+    const float* data = static_cast<const float*>(x.data());
+    int channel = x.channel();
+    int inner = x.height() * x.width();
+    out.resize(x.valid_size());
+    for (int n = 0; n < x.num(); n++) {
+        for (int i = 0; i < inner; i++) {
+            int base = n * channel * inner + i;
+            float max_value = -1e30f;
+            for (int c = 0; c < channel; c++) {
+                max_value = std::max(max_value, scale * data[base + c * inner] + mask[c]);
+            }
+            float sum = 0.f;
+            for (int c = 0; c < channel; c++) {
+                sum += expf(scale * data[base + c * inner] + mask[c] - max_value);
+            }
+            for (int c = 0; c < channel; c++) {
+                float logit = scale * data[base + c * inner] + mask[c] - max_value;
+                out[base + c * inner] = log_softmax ? logit - logf(sum) : expf(logit) / sum;
+            }
+        }
+    }
+}
+
+TEST(OperatorsTest, SoftmaxScaleMaskTest) {
+    LOG(INFO) << "test a softmax op loaded with scale, log_softmax and a mask input.";
+    std::vector<float> mask = {0.f, -1e4f, 0.5f};
+    for (bool log_softmax : {false, true}) {
+        Graph<X86, Precision::FP32> graph;
+        graph.AddOp("sm", "Softmax", {"x", "mask"}, {"sm_out"});
+        graph.AddOpAttr("sm", "axis", 1);
+        graph.AddOpAttr("sm", "scale", 0.5f);
+        graph.AddOpAttr("sm", "log_softmax", log_softmax);
+        auto status = graph.Freeze();
+        if (!status) {
+            LOG(FATAL) << "Freeze error";
+        }
+        graph.Optimize();
+        PTuple<int> x_shape = {2, 3, 4, 5};
+        PTuple<int> mask_shape = {1, 3, 1, 1};
+        graph.AddOpAttr("x", "input_shape", x_shape);
+        graph.AddOpAttr("mask", "input_shape", mask_shape);
+
+        Net<X86, Precision::FP32> net(true);
+        net.init(graph);
+        auto x = net.get_in("x");
+        fill_tensor_rand(*x, -4.f, 4.f);
+        float* mask_data = static_cast<float*>(net.get_in("mask")->mutable_data());
+        for (int c = 0; c < mask.size(); c++) {
+            mask_data[c] = mask[c];
+        }
+        net.prediction();
+
+        std::vector<float> expect;
+        softmax_ref(*x, mask, 0.5f, log_softmax, expect);
+        auto out = net.get_out("sm_out");
+        CHECK_EQ(out->valid_size(), expect.size());
+        const float* data = static_cast<const float*>(out->data());
+        for (int i = 0; i < expect.size(); i++) {
+            CHECK_LE(fabsf(data[i] - expect[i]), 1e-4f * std::max(1.f, fabsf(expect[i])))
+                    << "log_softmax " << log_softmax << ", differs at " << i;
+        }
+    }
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+#if defined(USE_X86_PLACE) && !defined(USE_CUDA)
+    Env<X86>::env_init();
+#endif
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -17,6 +17,25 @@ using Target_H = ARM;
 
 std::string protocol = "baidu_std";
 std::string server = "0.0.0.0:8000";
+// send/receive tensors as raw bytes in the rpc attachment instead of repeated float
+bool raw_transport = false;
+
+void fill_request_raw(int id, RPCRequest& request, butil::IOBuf& attachment) {
+    request.set_model("mobilenet_v2");
+    request.set_request_id(id);
+    request.set_raw_outputs(true);
+    int batch_size = 1;
+    IO* input = request.add_inputs();
+    Data* data = input->mutable_tensor();
+    data->add_shape(batch_size);
+    data->add_shape(3);
+    data->add_shape(224);
+    data->add_shape(224);
+    std::vector<float> new_tmp_data(batch_size * 3 * 224 * 224, 1.0f);
+    data->set_dtype(DT_FLOAT32);
+    data->set_raw_bytes(new_tmp_data.size() * sizeof(float));
+    attachment.append(new_tmp_data.data(), new_tmp_data.size() * sizeof(float));
+}
 
 void fill_request(int id, RPCRequest& request) {
     request.set_model("mobilenet_v2");
@@ -70,12 +89,18 @@ TEST(ServiceTest, Service_client_base_test) {
     int log_id = 0;
     while(!brpc::IsAskedToQuit()) {
         RPCRequest request;
-        fill_request(log_id, request);
         RPCResponse response;
         brpc::Controller cntl;
+        if (raw_transport) {
+            fill_request_raw(log_id, request, cntl.request_attachment());
+        } else {
+            fill_request(log_id, request);
+        }
 
         cntl.set_log_id(log_id++);  // set by user
-        if(protocol != "http" && protocol != "h2c") {
+        if (raw_transport) {
+            // the attachment carries the input tensors
+        } else if(protocol != "http" && protocol != "h2c") {
             // Set attachment which is wired to network directly instead of
             // being serialized into protobuf messages.
             cntl.request_attachment().append("Hi, What's you name?"); // Carry this along with requests
@@ -87,7 +112,16 @@ TEST(ServiceTest, Service_client_base_test) {
         // the response comes back or error occurs(including timedout).
         stub.evaluate(&cntl, &request, &response, NULL);
         if (!cntl.Failed()) { 
-            if (cntl.response_attachment().empty()) {
+            if (raw_transport) {
+                std::vector<float> out(response.outputs(0).tensor().raw_bytes() / sizeof(float));
+                cntl.response_attachment().copy_to(out.data(), out.size() * sizeof(float));
+                LOG(INFO) << "I (" << cntl.local_side() << ") Received raw response from remote ("
+                          << cntl.remote_side() << "): " << response.info().msg()
+                          << " latency = " << cntl.latency_us() <<" us";
+                for(int j = 0; j < 10 && j < out.size(); j++) {
+                    LOG(WARNING) << "  \\__ get response data[" << j << "]: " << out[j];
+                }
+            } else if (cntl.response_attachment().empty()) {
                 LOG(INFO) << "I (" << cntl.local_side() << ") Received response from remote (" << cntl.remote_side() 
                           << "): " << response.info().msg() 
                           << " latency = " << cntl.latency_us() <<" us";
@@ -111,6 +145,9 @@ TEST(ServiceTest, Service_client_base_test) {
 int main(int argc, const char** argv){
     // initial logger
     logger::init(argv[0]);
+    if (argc > 1 && std::string(argv[1]) == "raw") {
+        raw_transport = true;
+    }
 	InitTest();
 	RUN_ALL_TESTS(argv[0]);	
 	return 0;
@@ -0,0 +1,100 @@
+#include "saber/core/context.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "test_saber_func.h"
+#include <vector>
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/batch_gemm.h"
+
+using namespace anakin::saber;
+
+void batch_gemm_basic(bool trans_a, bool trans_b, int m, int n, int k, float alpha,
+                      const float* a, const float* b, float beta, float* c, int batch) {
+    for (int i = 0; i < batch; i++) {
+        const float* pa = a + i * m * k;
+        const float* pb = b + i * k * n;
+        float* pc = c + i * m * n;
+
+        for (int row = 0; row < m; row++) {
+            for (int col = 0; col < n; col++) {
+                float sum = 0.f;
+
+                for (int p = 0; p < k; p++) {
+                    float va = trans_a ? pa[p * m + row] : pa[row * k + p];
+                    float vb = trans_b ? pb[col * k + p] : pb[p * n + col];
+                    sum += va * vb;
+                }
+
+                pc[row * n + col] = alpha * sum + beta * pc[row * n + col];
+            }
+        }
+    }
+}
+
+void test_batch_gemm(bool trans_a, bool trans_b, int m, int n, int k, float beta, int batch) {
+    Tensor<X86> a(Shape({batch, 1, m, k}));
+    Tensor<X86> b(Shape({batch, 1, k, n}));
+    Tensor<X86> c(Shape({batch, 1, m, n}));
+    Tensor<X86> check(Shape({batch, 1, m, n}));
+    fill_tensor_rand(a, -1.f, 1.f);
+    fill_tensor_rand(b, -1.f, 1.f);
+    fill_tensor_rand(c, -1.f, 1.f);
+    check.copy_from(c);
+    const float alpha = 0.5f;
+
+    float* pa = (float*)a.mutable_data();
+    float* pb = (float*)b.mutable_data();
+    float* pc = (float*)c.mutable_data();
+    // a, b and c pointers in one array, the form of the second dispatch
+    std::vector<float*> ptrs(3 * batch);
+
+    for (int i = 0; i < batch; i++) {
+        ptrs[i] = pa + i * m * k;
+        ptrs[batch + i] = pb + i * k * n;
+        ptrs[2 * batch + i] = pc + i * m * n;
+    }
+
+    BatchGemm<X86, SABER_IMPL, float> gemm;
+    SABER_CHECK(gemm.init(trans_a, trans_b, batch, Context<X86>(0, 1, 1)));
+    SABER_CHECK(gemm.dispatch(alpha, beta, ptrs.data(), m, n, k, batch));
+
+    batch_gemm_basic(trans_a, trans_b, m, n, k, alpha, pa, pb, beta,
+                     (float*)check.mutable_data(), batch);
+    double max_ratio = 0.0;
+    double max_diff = 0.0;
+    tensor_cmp_host((const float*)check.data(), (const float*)c.data(),
+                    check.valid_size(), max_ratio, max_diff);
+    CHECK_LT(max_diff, 1e-4) << "batch gemm trans_a " << trans_a << " trans_b " << trans_b
+                             << " m " << m << " n " << n << " k " << k << " beta " << beta
+                             << " batch " << batch;
+}
+
+TEST(TestSaberFunc, test_saber_batch_gemm) {
+    Env<X86>::env_init();
+
+    for (int trans = 0; trans < 4; trans++) {
+        for (int m : {1, 3, 5, 32}) {
+            for (int n : {1, 7, 17, 33, 64}) {
+                for (int k : {1, 8, 31}) {
+                    for (int batch : {1, 3, 64}) {
+                        test_batch_gemm(trans & 1, trans & 2, m, n, k, 0.f, batch);
+                        test_batch_gemm(trans & 1, trans & 2, m, n, k, 0.7f, batch);
+                    }
+                }
+            }
+        }
+    }
+
+    LOG(INFO) << "batch gemm check ok";
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
@@ -197,6 +197,39 @@ TEST(TestSaberFunc, test_buff_apis) {
     LOG(INFO) << "Buffer api: from_buffer check pass";
 }
 
+#ifdef USE_X86_PLACE
+TEST(TestSaberFunc, test_x86_mem_pool) {
+    typedef TargetWrapper<X86> API;
+    X86MemPool& pool = X86MemPool::global();
+    MemPoolStats before = pool.stats();
+
+    // alloc is 64 bytes aligned and zeroed, a released block of the same size class comes back
+    void* ptr0 = nullptr;
+    API::mem_alloc(&ptr0, 1000);
+    CHECK_EQ(reinterpret_cast<size_t>(ptr0) % 64, 0) << "pool block is not aligned";
+    memset(ptr0, 1, 1000);
+    API::mem_free(ptr0);
+    void* ptr1 = nullptr;
+    API::mem_alloc(&ptr1, 990);
+    CHECK_EQ(ptr0, ptr1) << "released block should be reused";
+
+    for (int i = 0; i < 990; ++i) {
+        CHECK_EQ(static_cast<char*>(ptr1)[i], 0) << "reused block must be zeroed";
+    }
+
+    API::mem_free(ptr1);
+
+    // re_alloc releases the old block to the pool
+    Buffer<X86> buf(4 << 20);
+    buf.re_alloc(8 << 20);
+    CHECK_EQ(reinterpret_cast<size_t>(buf.get_data()) % 64, 0);
+    MemPoolStats after = pool.stats();
+    CHECK_GE(after.pool_hits, before.pool_hits + 1);
+    CHECK_GE(after.bytes_cached, 4 << 20);
+    LOG(INFO) << "x86 mem pool: " << after.to_string();
+}
+#endif
+
 int main(int argc, const char** argv) {
     // initial logger
     logger::init(argv[0]);
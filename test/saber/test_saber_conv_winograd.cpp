@@ -0,0 +1,104 @@
+#include "saber/core/context.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "test_saber_func.h"
+#include "conv_func_helper.h"
+#include <vector>
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/winograd.h"
+#include "saber/funcs/impl/x86/x86_utils.h"
+
+using namespace anakin::saber;
+
+void test_winograd(WinogradTile tile, LayoutType in_layout, LayoutType out_layout,
+                   int num, int in_c, int out_c, int height, int width, int pad,
+                   bool bias_term, bool with_relu) {
+    int out_h = height + 2 * pad - 2;
+    int out_w = width + 2 * pad - 2;
+    Tensor<X86> input(Shape({num, in_c, height, width}, in_layout));
+    Tensor<X86> output(Shape({num, out_c, out_h, out_w}, out_layout));
+    Tensor<X86> weights(Shape({out_c, in_c, 3, 3}));
+    Tensor<X86> bias;
+    fill_tensor_rand(input, -1.f, 1.f);
+    fill_tensor_rand(weights, -1.f, 1.f);
+
+    if (bias_term) {
+        bias.re_alloc(Shape({1, out_c, 1, 1}), AK_FLOAT);
+        fill_tensor_rand(bias, -1.f, 1.f);
+    }
+
+    ConvParam<X86> conv_param(1, pad, pad, 1, 1, 1, 1, &weights, &bias);
+
+    if (with_relu) {
+        conv_param.activation_param = ActivationParam<X86>(Active_relu);
+    }
+
+    EltwiseParam<X86> elt_param(Eltwise_sum);
+    elt_param.has_eltwise = false;
+    ConvEltwiseParam<X86> param(conv_param, elt_param);
+    Context<X86> ctx(0, 1, 1);
+    std::vector<Tensor<X86>*> inputs{&input};
+    std::vector<Tensor<X86>*> outputs{&output};
+    SaberConvWinograd<AK_FLOAT> conv;
+    conv.set_tile(tile);
+    SABER_CHECK(conv.init(inputs, outputs, param, ctx));
+    SABER_CHECK(conv.dispatch(inputs, outputs, param));
+
+    Tensor<X86> nchw_input(Shape({num, in_c, height, width}));
+    Tensor<X86> nchw_output(Shape({num, out_c, out_h, out_w}));
+    Tensor<X86> check(Shape({num, out_c, out_h, out_w}));
+
+    if (in_layout == Layout_NCHW) {
+        nchw_input.copy_from(input);
+    } else {
+        reorder_nchwc_nchw(input, nchw_input);
+    }
+
+    if (out_layout == Layout_NCHW) {
+        nchw_output.copy_from(output);
+    } else {
+        reorder_nchwc_nchw(output, nchw_output);
+    }
+
+    conv_basic_check<X86>(nchw_input, check, (const float*)weights.data(),
+                          bias_term ? (const float*)bias.data() : nullptr,
+                          1, 3, 3, 1, 1, 1, 1, pad, pad, bias_term, with_relu);
+    double max_ratio = 0.0;
+    double max_diff = 0.0;
+    tensor_cmp_host((const float*)check.data(), (const float*)nchw_output.data(),
+                    check.valid_size(), max_ratio, max_diff);
+    // F(6, 3) rounds the most, the transforms scale by up to 32
+    CHECK_LT(max_diff, 1e-3) << "winograd F(" << tile << ",3) in layout " << in_layout
+                             << " out layout " << out_layout << " in_c " << in_c << " out_c " << out_c
+                             << " h " << height << " w " << width;
+}
+
+TEST(TestSaberFunc, test_saber_conv_winograd) {
+    Env<X86>::env_init();
+
+    for (auto tile : {WINOGRAD_F2, WINOGRAD_F4, WINOGRAD_F6}) {
+        for (auto in_layout : {Layout_NCHW, Layout_NCHW_C8R, Layout_NCHW_C16R}) {
+            for (auto out_layout : {Layout_NCHW, Layout_NCHW_C8R, Layout_NCHW_C16R}) {
+                for (auto pad : {0, 1}) {
+                    test_winograd(tile, in_layout, out_layout, 2, 16, 24, 13, 11, pad, true, true);
+                    test_winograd(tile, in_layout, out_layout, 1, 19, 33, 9, 17, pad, false, false);
+                }
+            }
+        }
+    }
+
+    CHECK_EQ(winograd_choose_tile(2, 2), WINOGRAD_F2);
+    CHECK_EQ(winograd_choose_tile(56, 56), WINOGRAD_F6);
+    LOG(INFO) << "winograd conv check ok";
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
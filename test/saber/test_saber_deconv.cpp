@@ -521,6 +521,57 @@ void deconv_testbase() {
                                     }
 }
 
+/// nchw deconv through the col2im engine: strides, dilations, groups and batches against
+/// the gemm + col2im reference, bias and relu fused or not
+void deconv_col2im_x86_test() {
+#ifdef USE_X86_PLACE
+    Env<X86>::env_init();
+    TestSaberBase<X86, X86, AK_FLOAT, Deconv, ConvParam> testbase;
+
+    for (int kernel : {1, 2, 3, 4})
+        for (int stride : {1, 2, 3})
+            for (int pad : {0, 1})
+                for (int dilation : {1, 2})
+                    for (int group : {1, 2})
+                        for (bool bias_term : {true, false})
+                            for (bool relu_flag : {true, false}) {
+                                if ((5 - 1) * stride + dilation * (kernel - 1) + 1 - 2 * pad <= 0) {
+                                    continue;
+                                }
+
+                                int in_channels = 6;
+                                int out_channels = 10;
+                                Shape weights_s({in_channels, out_channels / group, kernel, kernel}, Layout_NCHW);
+                                Shape bias_s({1, out_channels, 1, 1}, Layout_NCHW);
+                                Tensor<X86> weights_dev(weights_s);
+                                Tensor<X86> bias_dev;
+                                fill_tensor_rand(weights_dev, -1.f, 1.f);
+
+                                if (bias_term) {
+                                    bias_dev.re_alloc(bias_s, AK_FLOAT);
+                                    fill_tensor_rand(bias_dev, -1.f, 1.f);
+                                }
+
+                                ConvParam<X86> param(group, pad, pad, stride, stride, dilation, dilation,
+                                                     &weights_dev, &bias_dev);
+
+                                if (relu_flag) {
+                                    param.activation_param = ActivationParam<X86>(Active_relu);
+                                }
+
+                                testbase.set_param(param);
+                                testbase.set_rand_limit(-1.f, 1.f);
+                                testbase.set_input_shape(Shape({2, in_channels, 5, 7}, Layout_NCHW));
+                                testbase.run_test(gemm_transpose_conv<float, X86, X86>, 1e-3, true);
+                            }
+
+#endif
+}
+
+TEST(TestSaberFunc, test_func_deconv_col2im_x86) {
+    deconv_col2im_x86_test();
+}
+
 TEST(TestSaberFunc, test_func_self_deconv_nv) {
 #ifdef NVIDIA_GPU
     deconv_testbase<NVHX86, NV>();
@@ -428,6 +428,107 @@ void gru_ut(int word_size = 222,
 
 #ifdef USE_X86_PLACE
 
+/// streaming: every sequence split in two chunks, the second one goes on from the state_hidden
+/// the first left, must give the outputs of one run over the whole sequences
+void gru_stream_ut(int word_size, int hidden_size, std::vector<int> lens,
+                   std::vector<int> first_lens, GruFormula formula) {
+    Context<X86> ctx(0, 1, 1);
+    int batch = lens.size();
+    std::vector<int> offsets = {0};
+
+    for (int len : lens) {
+        offsets.push_back(offsets.back() + len);
+    }
+
+    Tensor<X86> weight(Shape({1, 1, 1, hidden_size * word_size * 3 + hidden_size * hidden_size * 3},
+                             Layout_NCHW));
+    Tensor<X86> bias(Shape({1, 1, 1, hidden_size * 3}, Layout_NCHW));
+    Tensor<X86> x(Shape({offsets.back(), word_size, 1, 1}, Layout_NCHW));
+    Tensor<X86> out_full;
+    fill_tensor_rand(weight, -1.f, 1.f);
+    fill_tensor_rand(bias, -1.f, 1.f);
+    fill_tensor_rand(x, -1.f, 1.f);
+    x.set_seq_offset({offsets});
+    GruParam<X86> param(&weight, &bias, formula, Active_sigmoid, Active_tanh, false, nullptr, 1.f, 1, 1);
+    Gru<X86, AK_FLOAT> gru_op;
+
+    auto run = [&](Tensor<X86>& in, Tensor<X86>& out) {
+        std::vector<Tensor<X86>*> inputs{&in};
+        std::vector<Tensor<X86>*> outputs{&out};
+        SABER_CHECK(gru_op.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx));
+        SABER_CHECK(gru_op.compute_output_shape(inputs, outputs, param));
+        outputs[0]->re_alloc(outputs[0]->valid_shape(), AK_FLOAT);
+        SABER_CHECK(gru_op(inputs, outputs, param, ctx));
+    };
+    run(x, out_full);
+
+    Tensor<X86> state_hidden(Shape({batch, hidden_size, 1, 1}, Layout_NCHW));
+    fill_tensor_const(state_hidden, 0.f);
+    param.state_hidden = &state_hidden;
+    Tensor<X86> x_chunk;
+    Tensor<X86> out_chunk;
+    const float* full = (const float*)out_full.data();
+    double max_diff = 0;
+
+    for (int chunk = 0; chunk < 2; chunk++) {
+        std::vector<int> chunk_offsets = {0};
+
+        for (int i = 0; i < batch; i++) {
+            int len = chunk == 0 ? first_lens[i] : lens[i] - first_lens[i];
+            chunk_offsets.push_back(chunk_offsets.back() + len);
+        }
+
+        x_chunk.re_alloc(Shape({chunk_offsets.back(), word_size, 1, 1}, Layout_NCHW), AK_FLOAT);
+
+        for (int i = 0; i < batch; i++) {
+            int start = offsets[i] + (chunk == 0 ? 0 : first_lens[i]);
+            memcpy((float*)x_chunk.mutable_data() + chunk_offsets[i] * word_size,
+                   (const float*)x.data() + start * word_size,
+                   (chunk_offsets[i + 1] - chunk_offsets[i]) * word_size * sizeof(float));
+        }
+
+        x_chunk.set_seq_offset({chunk_offsets});
+        run(x_chunk, out_chunk);
+        const float* part = (const float*)out_chunk.data();
+
+        for (int i = 0; i < batch; i++) {
+            int start = offsets[i] + (chunk == 0 ? 0 : first_lens[i]);
+
+            for (int w = chunk_offsets[i]; w < chunk_offsets[i + 1]; w++) {
+                for (int h = 0; h < hidden_size; h++) {
+                    float expect = full[(start + w - chunk_offsets[i]) * hidden_size + h];
+                    max_diff = std::max(max_diff, (double)fabsf(expect - part[w * hidden_size + h]));
+                }
+            }
+        }
+    }
+
+    CHECK_LT(max_diff, 1e-4) << "streaming gru differs from the whole sequences, hidden "
+                             << hidden_size << " formula " << formula;
+
+    // the state is the last output of each sequence
+    for (int i = 0; i < batch; i++) {
+        for (int h = 0; h < hidden_size; h++) {
+            CHECK_LT(fabsf(((const float*)state_hidden.data())[i * hidden_size + h]
+                           - full[(offsets[i + 1] - 1) * hidden_size + h]), 1e-4);
+        }
+    }
+}
+
+TEST(TestSaberFunc, test_func_gru_stream_x86) {
+    Env<X86>::env_init();
+    srand(12345678);
+
+    for (int hidden_size : {15, 64}) {
+        for (GruFormula formula : {GRU_ORIGIN, GRU_CUDNN}) {
+            gru_stream_ut(22, hidden_size, {9, 7, 5}, {4, 3, 2}, formula);
+            gru_stream_ut(22, hidden_size, {6}, {2}, formula);
+            gru_stream_ut(22, hidden_size, {2, 2, 2}, {1, 1, 1}, formula);
+        }
+    }
+
+    LOG(INFO) << "streaming gru check ok";
+}
 
 TEST(TestSaberFunc, test_func_gru_x86) {
     Env<X86>::env_init();
@@ -0,0 +1,138 @@
+#include "saber/core/context.h"
+#include "saber/core/tensor_op.h"
+#include "saber/saber_types.h"
+#include "test_saber_func.h"
+#include <vector>
+
+#ifdef USE_X86_PLACE
+#include "saber/funcs/impl/x86/saber_image_preprocess.h"
+#include "saber/funcs/impl/x86/saber_resize.h"
+
+using namespace anakin::saber;
+
+/// float NCHW of the element (n, c, h, w) of a tensor in NCHW, NHWC or NCHW_C8R
+float layout_at(const Tensor<X86>& tensor, int channels, int n, int c, int h, int w) {
+    const float* data = static_cast<const float*>(tensor.data());
+    int out_h = tensor.height();
+    int out_w = tensor.width();
+
+    switch (tensor.get_layout()) {
+    case Layout_NHWC:
+        return data[((n * out_h + h) * out_w + w) * channels + c];
+
+    case Layout_NCHW_C8R:
+        return data[(((n * ((channels + 7) / 8) + c / 8) * out_h + h) * out_w + w) * 8 + c % 8];
+
+    default:
+        return data[((n * channels + c) * out_h + h) * out_w + w];
+    }
+}
+
+void test_image_preprocess(ResizeType type, LayoutType layout, int src_channels, bool swap_rb,
+                           int num, int height, int width, int out_h, int out_w) {
+    const int channels = src_channels == 4 ? 3 : src_channels;
+    const int row_stride = width * src_channels + 5;
+    std::vector<unsigned char> image(num * height * row_stride);
+
+    for (auto& pixel : image) {
+        pixel = rand() % 256;
+    }
+
+    std::vector<float> mean = {103.9f, 116.7f, 123.6f};
+    std::vector<float> std = {57.3f, 57.1f, 58.4f};
+    mean.resize(channels);
+    std.resize(channels);
+    ImagePreprocessParam param(src_channels, swap_rb, mean, std, type);
+    param.out_height = out_h;
+    param.out_width = out_w;
+    Tensor<X86> output(Shape({1, 1, 1, 1}, layout));
+
+    SABER_CHECK(image_preprocess(param, image.data(), num, height, width, row_stride, output));
+
+    // reference: float NCHW image through SaberResize, then normalized
+    Tensor<X86> planar(Shape({num, channels, height, width}));
+    Tensor<X86> resized(Shape({num, channels, out_h, out_w}));
+    float* planar_data = static_cast<float*>(planar.mutable_data());
+
+    for (int n = 0; n < num; n++) {
+        for (int c = 0; c < channels; c++) {
+            int src_c = (swap_rb && channels == 3) ? 2 - c : c;
+
+            for (int h = 0; h < height; h++) {
+                for (int w = 0; w < width; w++) {
+                    planar_data[((n * channels + c) * height + h) * width + w] =
+                        image[(n * height + h) * row_stride + w * src_channels + src_c];
+                }
+            }
+        }
+    }
+
+    ResizeParam<X86> resize_param(type, 0.f, 0.f, out_w, out_h);
+    Context<X86> ctx(0, 1, 1);
+    std::vector<Tensor<X86>*> inputs{&planar};
+    std::vector<Tensor<X86>*> outputs{&resized};
+    SaberResize<X86, AK_FLOAT> resize;
+    SABER_CHECK(resize.init(inputs, outputs, resize_param, ctx));
+    SABER_CHECK(resize.dispatch(inputs, outputs, resize_param));
+    const float* resized_data = static_cast<const float*>(resized.data());
+    double max_diff = 0.0;
+
+    for (int n = 0; n < num; n++) {
+        for (int c = 0; c < channels; c++) {
+            for (int h = 0; h < out_h; h++) {
+                for (int w = 0; w < out_w; w++) {
+                    float expect = (resized_data[((n * channels + c) * out_h + h) * out_w + w] - mean[c]) / std[c];
+                    float diff = fabsf(expect - layout_at(output, channels, n, c, h, w));
+                    max_diff = std::max(max_diff, (double)diff);
+                }
+            }
+        }
+
+        if (layout == Layout_NCHW_C8R) {
+            for (int c = channels; c < 8; c++) {
+                CHECK_EQ(layout_at(output, channels, n, c, 0, 0), 0.f) << "padding channel is not zero";
+            }
+        }
+    }
+
+    CHECK_LT(max_diff, 1e-3) << "image preprocess type " << type << " layout " << layout
+                             << " channels " << src_channels << " swap " << swap_rb
+                             << " " << height << "x" << width << " -> " << out_h << "x" << out_w;
+}
+
+TEST(TestSaberFunc, test_saber_image_preprocess) {
+    Env<X86>::env_init();
+
+    for (auto type : {BILINEAR_ALIGN, BILINEAR_NO_ALIGN, RESIZE_CUSTOM, NEAREST_ALIGN}) {
+        for (auto layout : {Layout_NCHW, Layout_NHWC, Layout_NCHW_C8R}) {
+            for (int src_channels : {1, 3, 4}) {
+                for (bool swap_rb : {false, true}) {
+                    test_image_preprocess(type, layout, src_channels, swap_rb, 2, 37, 53, 24, 32);
+                    test_image_preprocess(type, layout, src_channels, swap_rb, 1, 16, 16, 40, 28);
+                    test_image_preprocess(type, layout, src_channels, swap_rb, 1, 20, 30, 20, 30);
+                }
+            }
+        }
+    }
+
+    // bad parameters fail the call instead of the process
+    std::vector<unsigned char> image(4 * 4 * 3);
+    Tensor<X86> output(Shape({1, 3, 4, 4}));
+    ImagePreprocessParam param(2, false, {}, {}, BILINEAR_NO_ALIGN);
+    CHECK_EQ(image_preprocess(param, image.data(), 1, 4, 4, 0, output), SaberInvalidValue);
+    param.src_channels = 3;
+    param.mean = {1.f, 2.f};
+    CHECK_EQ(image_preprocess(param, image.data(), 1, 4, 4, 0, output), SaberInvalidValue);
+
+    LOG(INFO) << "image preprocess check ok";
+}
+
+#endif
+
+int main(int argc, const char** argv) {
+    // initial logger
+    logger::init(argv[0]);
+    InitTest();
+    RUN_ALL_TESTS(argv[0]);
+    return 0;
+}
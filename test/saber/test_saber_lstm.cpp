@@ -691,6 +691,129 @@ void lstmp_ut(int word_size ,
 
 #ifdef USE_X86_PLACE
 
+/// copy the rows of each sequence from src (offsets src_offsets) to dst, starting at word
+/// starts[i] of the sequence and taking lens[i] words, returns the offsets of dst
+static std::vector<int> gather_seq_rows(const Tensor<X86>& src, const std::vector<int>& src_offsets,
+                                        const std::vector<int>& starts, const std::vector<int>& lens,
+                                        Tensor<X86>& dst) {
+    int width = src.valid_size() / src.num();
+    std::vector<int> offsets = {0};
+
+    for (int i = 0; i < lens.size(); i++) {
+        offsets.push_back(offsets.back() + lens[i]);
+    }
+
+    dst.re_alloc(Shape({offsets.back(), width, 1, 1}, Layout_NCHW), AK_FLOAT);
+    const float* src_data = (const float*)src.data();
+    float* dst_data = (float*)dst.mutable_data();
+
+    for (int i = 0; i < lens.size(); i++) {
+        memcpy(dst_data + offsets[i] * width, src_data + (src_offsets[i] + starts[i]) * width,
+               lens[i] * width * sizeof(float));
+    }
+
+    dst.set_seq_offset({offsets});
+    return offsets;
+}
+
+/// streaming: every sequence split in two chunks, the second one goes on from the state_hidden
+/// and state_cell the first left, must give the outputs of one run over the whole sequences
+void lstm_stream_ut(int word_size, int hidden_size, std::vector<int> lens,
+                    std::vector<int> first_lens, bool with_peephole) {
+    Context<X86> ctx(0, 1, 1);
+    int batch = lens.size();
+    std::vector<int> offsets = {0};
+
+    for (int len : lens) {
+        offsets.push_back(offsets.back() + len);
+    }
+
+    Tensor<X86> weight(Shape({1, 1, 1, hidden_size * hidden_size * 4 + hidden_size * word_size * 4},
+                             Layout_NCHW));
+    Tensor<X86> bias(Shape({1, 1, 1, hidden_size * (with_peephole ? 7 : 4)}, Layout_NCHW));
+    Tensor<X86> x(Shape({offsets.back(), word_size, 1, 1}, Layout_NCHW));
+    Tensor<X86> out_full;
+    fill_tensor_rand(weight, -1, 1);
+    fill_tensor_rand(bias, -1, 1);
+    fill_tensor_rand(x, -1, 1);
+    x.set_seq_offset({offsets});
+
+    auto run = [&](Tensor<X86>& in, Tensor<X86>& out, LstmParam<X86>& param) {
+        Lstm<X86, AK_FLOAT> lstm_op;
+        std::vector<Tensor<X86>*> inputs{&in};
+        std::vector<Tensor<X86>*> outputs{&out};
+        SABER_CHECK(lstm_op.init(inputs, outputs, param, SPECIFY, SABER_IMPL, ctx));
+        SABER_CHECK(lstm_op.compute_output_shape(inputs, outputs, param));
+        outputs[0]->re_alloc(outputs[0]->valid_shape(), AK_FLOAT);
+        SABER_CHECK(lstm_op(inputs, outputs, param, ctx));
+    };
+    LstmParam<X86> param(&weight, &bias, nullptr, Active_unknow, Active_sigmoid, Active_tanh,
+                         Active_tanh, with_peephole);
+    run(x, out_full, param);
+
+    Tensor<X86> state_hidden(Shape({batch, hidden_size, 1, 1}, Layout_NCHW));
+    Tensor<X86> state_cell(Shape({batch, hidden_size, 1, 1}, Layout_NCHW));
+    fill_tensor_const(state_hidden, 0.f);
+    fill_tensor_const(state_cell, 0.f);
+    param.state_hidden = &state_hidden;
+    param.state_cell = &state_cell;
+    std::vector<int> second_lens;
+
+    for (int i = 0; i < batch; i++) {
+        second_lens.push_back(lens[i] - first_lens[i]);
+    }
+
+    Tensor<X86> x_chunk;
+    Tensor<X86> out_chunk;
+    double max_diff = 0;
+
+    for (int chunk = 0; chunk < 2; chunk++) {
+        std::vector<int> starts = chunk == 0 ? std::vector<int>(batch, 0) : first_lens;
+        std::vector<int> chunk_lens = chunk == 0 ? first_lens : second_lens;
+        std::vector<int> chunk_offsets = gather_seq_rows(x, offsets, starts, chunk_lens, x_chunk);
+        run(x_chunk, out_chunk, param);
+        const float* full = (const float*)out_full.data();
+        const float* part = (const float*)out_chunk.data();
+
+        for (int i = 0; i < batch; i++) {
+            for (int w = 0; w < chunk_lens[i]; w++) {
+                for (int h = 0; h < hidden_size; h++) {
+                    float expect = full[(offsets[i] + starts[i] + w) * hidden_size + h];
+                    float result = part[(chunk_offsets[i] + w) * hidden_size + h];
+                    max_diff = std::max(max_diff, (double)fabsf(expect - result));
+                }
+            }
+        }
+    }
+
+    CHECK_LT(max_diff, 1e-4) << "streaming lstm differs from the whole sequences, hidden "
+                             << hidden_size << " peephole " << with_peephole;
+    // the state is the last output of each sequence
+    const float* full = (const float*)out_full.data();
+
+    for (int i = 0; i < batch; i++) {
+        for (int h = 0; h < hidden_size; h++) {
+            CHECK_LT(fabsf(((const float*)state_hidden.data())[i * hidden_size + h]
+                           - full[(offsets[i + 1] - 1) * hidden_size + h]), 1e-4);
+        }
+    }
+}
+
+TEST(TestSaberFunc, test_func_lstm_stream_x86) {
+    Env<X86>::env_init();
+    srand(12345);
+
+    for (int hidden_size : {15, 64}) {
+        for (bool with_peephole : {true, false}) {
+            lstm_stream_ut(22, hidden_size, {9, 7, 5}, {4, 3, 2}, with_peephole);
+            lstm_stream_ut(22, hidden_size, {6}, {2}, with_peephole);
+            lstm_stream_ut(22, hidden_size, {2, 2, 2}, {1, 1, 1}, with_peephole);
+        }
+    }
+
+    LOG(INFO) << "streaming lstm check ok";
+}
+
 TEST(TestSaberFunc, test_func_lstm_x86) {
     Env<X86>::env_init();
     srand(12345);
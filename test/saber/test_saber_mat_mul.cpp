@@ -103,8 +103,6 @@ template <DataType datatype, typename TargetType_D, typename TargetType_H>
 void test_model() {
     using dtype = typename DataTrait<TargetType_H, datatype>::Dtype;
 
-    bool trans_a = true;
-    bool trans_b = false;
     int input_num = 2;
     TestSaberBase<TargetType_D, TargetType_H, datatype, MatMul, MatMulParam> testbase(input_num);
 
@@ -119,26 +117,31 @@ void test_model() {
         v_num_in = {2, 4};
     }
 
-    for (int w_in : v_w_in) {
-        for (int h_in : v_h_in) {
-            for (int ch_in : v_ch_in) {
-                for (int num_in : v_num_in) {
-                    Shape shape0 = trans_a ? Shape({num_in, ch_in, w_in, h_in}) :
-                                             Shape({num_in, ch_in, h_in, w_in});
-                    Shape shape1 = trans_b ? Shape({num_in, ch_in, h_in, w_in}) :
-                                             Shape({num_in, ch_in, w_in, h_in});
-                    std::vector<Shape> shapes;
-                    shapes.push_back(shape0);
-                    shapes.push_back(shape1);
-                    MatMulParam<TargetType_D> param(trans_a, trans_b);
-                    testbase.set_param(param);
-                    testbase.set_rand_limit(1, 12);
-                    testbase.set_input_shape(shapes);
-                    if (std::is_same<TargetType_D, MLU>::value) {
-                        testbase.run_test(mat_mul_cpu_base<dtype, TargetType_D, TargetType_H>, 
-                                          0.005, true);
-                    } else {
-                        testbase.run_test(mat_mul_cpu_base<dtype, TargetType_D, TargetType_H>);
+    for (int trans = 0; trans < 4; trans++) {
+        bool trans_a = trans & 1;
+        bool trans_b = trans & 2;
+
+        for (int w_in : v_w_in) {
+            for (int h_in : v_h_in) {
+                for (int ch_in : v_ch_in) {
+                    for (int num_in : v_num_in) {
+                        Shape shape0 = trans_a ? Shape({num_in, ch_in, w_in, h_in}) :
+                                                 Shape({num_in, ch_in, h_in, w_in});
+                        Shape shape1 = trans_b ? Shape({num_in, ch_in, h_in, w_in}) :
+                                                 Shape({num_in, ch_in, w_in, h_in});
+                        std::vector<Shape> shapes;
+                        shapes.push_back(shape0);
+                        shapes.push_back(shape1);
+                        MatMulParam<TargetType_D> param(trans_a, trans_b);
+                        testbase.set_param(param);
+                        testbase.set_rand_limit(1, 12);
+                        testbase.set_input_shape(shapes);
+                        if (std::is_same<TargetType_D, MLU>::value) {
+                            testbase.run_test(mat_mul_cpu_base<dtype, TargetType_D, TargetType_H>, 
+                                              0.005, true);
+                        } else {
+                            testbase.run_test(mat_mul_cpu_base<dtype, TargetType_D, TargetType_H>);
+                        }
                     }
                 }
             }
@@ -99,6 +99,11 @@ void sequence_conv_cpu(const std::vector<Tensor<TargetType_H>*>& inputs,
         }
     }
     #endif
+    if (param.active_type == Active_relu) {
+        for (int i = 0; i < word_num * _feature_size; i++) {
+            out[i] = out[i] > 0.f ? out[i] : 0.f;
+        }
+    }
     out_data->set_seq_offset(voffset);
 }
 
@@ -172,9 +177,11 @@ TEST(TestSaberFunc, test_func_saber_sequenconv) {
     for (auto context_length : {2, 3, 7}) {
     for (auto feature_size : {4, 10, 64}) {
     for (auto pad_up : {-1, -2}) {
+    for (auto act : {Active_unknow, Active_relu}) {
+    for (auto bias_term : {false, true}) {
         LOG(INFO) << "num: " << num << ", hidden_size: " << hidden_size \
                   << ", context_length: " << context_length << ", feature_size: " << feature_size\
-                  << ", pad_up: " << pad_up;
+                  << ", pad_up: " << pad_up << ", act: " << act << ", bias_term: " << bias_term;
         TensorD filter_tensor;
         TensorD in_tensor;
         TensorD bias_tensor;
@@ -191,7 +198,10 @@ TEST(TestSaberFunc, test_func_saber_sequenconv) {
         vseq_offset.push_back(seq_offset);
         in_tensor.set_seq_offset(vseq_offset);
         input.push_back(&in_tensor);
-        SequenceConvParam<X86> param(&filter_tensor, context_length, pad_up);
+        bias_tensor.re_alloc(Shape({1, 1, 1, feature_size}), AK_FLOAT);
+        fill_tensor_rand(bias_tensor, -1.0f, 1.0f);
+        SequenceConvParam<X86> param(&filter_tensor, context_length, pad_up, 1, false,
+                                     nullptr, bias_term, bias_term ? &bias_tensor : nullptr, act);
         testbase.set_param(param);
         testbase.add_custom_input(input);
         testbase.run_test(sequence_conv_cpu<float, X86, X86>, 1e-4);
@@ -200,6 +210,8 @@ TEST(TestSaberFunc, test_func_saber_sequenconv) {
     }
     }
     }
+    }
+    }
 
     } while (0);
 
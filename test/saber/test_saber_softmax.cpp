@@ -53,23 +53,50 @@ void softmax_cpu(const std::vector<Tensor<TargetType_H>*>& input,
             num_tmp /= sh_in[i];
         }
 
+        // logits are scale * x + mask, the mask (second input) broadcasts on its dims of size 1
+        std::vector<dtype> logit(axis_size);
+
+        for (int i = 0; i < axis_size; ++i) {
+            logit[i] = param.scale * in_data[in_index + i * in_stride[axis]];
+
+            if (input.size() > 1) {
+                Shape sh_mask = input[1]->valid_shape();
+                const dtype* mask = (const dtype*)input[1]->data();
+                int mask_index = 0;
+                int mask_stride = 1;
+                int pos_tmp = num;
+
+                for (int d = dims - 1; d >= 0; --d) {
+                    int pos = i;
+
+                    if (d != axis) {
+                        pos = pos_tmp % sh_in[d];
+                        pos_tmp /= sh_in[d];
+                    }
+
+                    mask_index += (sh_mask[d] == 1 ? 0 : pos) * mask_stride;
+                    mask_stride *= sh_mask[d];
+                }
+
+                logit[i] += mask[mask_index];
+            }
+        }
+
         dtype max = std::numeric_limits<dtype>::lowest();
 
         for (int i = 0; i < axis_size; ++i) {
-            max = in_data[in_index] > max ? in_data[in_index] : max;
-            in_index += in_stride[axis];
+            max = logit[i] > max ? logit[i] : max;
         }
 
         dtype sum = (dtype)0;
 
         for (int i = 0; i < axis_size; ++i) {
-            in_index -= in_stride[axis];
-            data[axis_size - i - 1] = exp(in_data[in_index] - max);
-            sum += data[axis_size - i - 1];
+            data[i] = exp(logit[i] - max);
+            sum += data[i];
         }
 
         for (int i = 0; i < axis_size; ++i) {
-            out_data[out_index] = data[i] / sum;
+            out_data[out_index] = param.log_softmax ? logit[i] - max - log(sum) : data[i] / sum;
             out_index += out_stride[axis];
         }
     }
@@ -166,6 +193,37 @@ TEST(TestSaberFunc, test_func_softmax) {
             }
         }
     }
+    LOG(INFO) << "x86 fused scale, mask and log softmax test......";
+
+    for (auto shape : {
+                std::vector<int>({2, 3, 17, 40}), std::vector<int>({1, 4, 33, 9})
+            }) {
+        for (auto axis : {
+                    1, 2, 3
+                }) {
+            for (bool log_softmax : {
+                        false, true
+                    }) {
+                SoftmaxParam<X86> param(axis, 0.125f, log_softmax);
+                Shape sh(shape);
+                // attention style [n, 1, 1, w] mask (the whole shape when it would split the inner dims)
+                Shape sh_mask({shape[0], 1, 1, shape[3]});
+
+                if (axis == 1) {
+                    sh_mask = sh;
+                }
+
+                TestSaberBase<X86, X86, AK_FLOAT, Softmax, SoftmaxParam> testbase_mask(2, 1);
+                testbase_mask.set_param(param);
+                testbase_mask.set_input_shape(std::vector<Shape>({sh, sh_mask}));
+                testbase_mask.run_test(softmax_cpu<float, X86, X86>);
+                testbase2.set_param(param);
+                testbase2.set_input_shape(sh);
+                testbase2.run_test(softmax_cpu<float, X86, X86>);
+            }
+        }
+    }
+
     LOG(INFO) << "x86 test end.";
 #endif
 
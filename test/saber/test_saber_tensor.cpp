@@ -916,6 +916,28 @@ TEST(TestSaberFunc, test_tensor_share_diff_dtype) {
 #endif //USE_BM
 }
 #endif
+#ifdef USE_X86_PLACE
+TEST(TestSaberFunc, test_tensor_external_data) {
+    Env<X86>::env_init();
+    Shape sh({1, 2, 4, 4}, Layout_NCHW);
+    Tensor<X86> tensor(sh);
+    const void* own_data = tensor.data();
+    std::vector<float> user(sh.count() * 2, 1.f);
+
+    LOG(INFO) << "test X86 tensor alias external memory";
+    tensor.set_external_data(user.data(), user.size() * sizeof(float));
+    CHECK_EQ(tensor.data(), user.data()) << "tensor should alias external memory";
+    tensor.reshape(Shape({2, 2, 4, 4}, Layout_NCHW));
+    CHECK_EQ(tensor.data(), user.data()) << "reshape within capacity should keep external memory";
+    fill_tensor_const(tensor, 2.f);
+    CHECK_EQ(user[user.size() - 1], 2.f) << "writes should land in external memory";
+
+    LOG(INFO) << "test X86 tensor drop external memory";
+    tensor.set_external_data(nullptr, 0);
+    CHECK_EQ(tensor.data(), own_data) << "own buffer should be restored";
+}
+#endif
+
 int main(int argc, const char** argv) {
     // initial logger
     logger::init(argv[0]);
@@ -0,0 +1,247 @@
+/* Copyright (c) 2018 Anakin Authors, Inc. All Rights Reserved.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+// included by logger_core.h after the funcRegister declarations, don't include it directly.
+
+#include <condition_variable>
+#include <memory>
+
+namespace logger {
+
+namespace core {
+
+namespace async {
+
+/**
+ *  @brief one formatted line waiting for the flusher.
+ *  slots are reused, text keeps its capacity so a warm ring doesn't allocate.
+ */
+struct Record {
+    VerBoseType verbose;
+    const char* file;
+    unsigned    line;
+    char        preamble[128];
+    std::string text;              ///< prefix + message
+};
+
+/**
+ *  @brief lock free ring of one logging thread.
+ *
+ *  The owner thread is the only producer, the flusher (or a thread calling flush()
+ *  under the drain lock) the only consumer.
+ */
+class Ring {
+public:
+    static const size_t kCapacity = 1024; ///< power of 2
+
+    Ring():_slots(kCapacity) {}
+
+    /// false when the ring is full, the caller drains it and pushes again.
+    bool push(VerBoseType verbose, const char* file, unsigned line,
+              const char* prefix, const char* message) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= kCapacity) {
+            return false;
+        }
+        Record& record = _slots[head & (kCapacity - 1)];
+        record.verbose = verbose;
+        record.file = file;
+        record.line = line;
+        funcRegister::print_preamble(record.preamble, sizeof(record.preamble), verbose, file, line);
+        record.text.assign(prefix);
+        record.text.append(message);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// hand the pending records to func in order, returns how many.
+    template<typename Func>
+    size_t drain(Func& func) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t head = _head.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; i++) {
+            func(_slots[i & (kCapacity - 1)]);
+        }
+        _tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    ///< set when the owner thread exits, the flusher frees the ring once it's empty
+    std::atomic<bool> retired{false};
+
+private:
+    std::vector<Record> _slots;
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+/**
+ *  @brief asynchronous backend of the logger.
+ *
+ *  When started, log_to_all formats the line on the calling thread into the ring of that
+ *  thread and returns, a background thread writes the rings to stderr and the log files
+ *  every interval ms (sooner when a ring is half full). No lock is taken on the logging
+ *  path except the first time a thread logs or finds its ring full: it then blocks on
+ *  writing the rings out itself before queuing the line. FATAL lines drain the rings and
+ *  are written synchronously before the abort. Lines of one thread keep their order,
+ *  lines of different threads are ordered by drain.
+ *
+ *  Started by logger::set_async(true) or env ANAKIN_LOG_ASYNC=<interval ms> at logger::init.
+ */
+class Backend {
+public:
+    /// never destroyed, threads may log while static objects are torn down.
+    static Backend& instance() {
+        static Backend* backend = new Backend();
+        return *backend;
+    }
+
+    bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    void start(unsigned interval_ms) {
+        std::lock_guard<std::mutex> guard(_state_mut);
+        if (enabled()) {
+            return;
+        }
+        _interval_ms = interval_ms > 0 ? interval_ms : 1;
+        _stop = false;
+        _thread = std::thread([this]() { run(); });
+        if (!_atexit_registered) {
+            _atexit_registered = true;
+            std::atexit([]() { Backend::instance().stop(); });
+        }
+        _enabled.store(true, std::memory_order_release);
+    }
+
+    /// write everything left and join the flusher, later lines are synchronous again.
+    void stop() {
+        std::lock_guard<std::mutex> guard(_state_mut);
+        if (!enabled()) {
+            return;
+        }
+        _enabled.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> wait_guard(_wait_mut);
+            _stop = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+        flush();
+    }
+
+    void push(VerBoseType verbose, const char* file, unsigned line,
+              const char* prefix, const char* message) {
+        Ring* ring = local_ring();
+        // only this thread fills its ring, it's empty once the rings are written out
+        while (!ring->push(verbose, file, line, prefix, message)) {
+            flush();
+        }
+        if (ring->size() == Ring::kCapacity / 2) {
+            _cv.notify_one();
+        }
+    }
+
+    /// write out what every ring holds now.
+    void flush() {
+        std::lock_guard<std::mutex> drain_guard(_drain_mut);
+        std::lock_guard<std::recursive_mutex> write_guard(LoggerConfig::rsMutex);
+        auto write = [](Record& record) {
+            Message message{record.verbose, record.file, record.line,
+                            record.preamble, "", record.text.c_str()};
+            funcRegister::write_message(message, false);
+        };
+        size_t written = 0;
+        std::lock_guard<std::mutex> rings_guard(_rings_mut);
+        for (auto it = _rings.begin(); it != _rings.end();) {
+            written += (*it)->drain(write);
+            if ((*it)->retired.load(std::memory_order_acquire) && (*it)->size() == 0) {
+                it = _rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (written > 0) {
+            funcRegister::flush_callback();
+        }
+    }
+
+private:
+    Backend() {}
+
+    /// owns the ring of one thread, retires it on thread exit
+    struct RingHolder {
+        std::shared_ptr<Ring> ring;
+        ~RingHolder() {
+            if (ring) {
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    Ring* local_ring() {
+        static thread_local RingHolder holder;
+        if (!holder.ring) {
+            holder.ring = std::make_shared<Ring>();
+            std::lock_guard<std::mutex> guard(_rings_mut);
+            _rings.push_back(holder.ring);
+        }
+        return holder.ring.get();
+    }
+
+    void run() {
+        set_flusher_name();
+        std::unique_lock<std::mutex> lock(_wait_mut);
+        while (!_stop) {
+            _cv.wait_for(lock, std::chrono::milliseconds(_interval_ms));
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    static void set_flusher_name() {
+#if LOGGER_TLS_NAMES
+        funcRegister::set_thread_name("log_flusher");
+#endif
+    }
+
+    std::atomic<bool> _enabled{false};
+    bool _stop{false};
+    bool _atexit_registered{false};
+    unsigned _interval_ms{10};
+    std::thread _thread;
+    std::mutex _state_mut;
+    std::mutex _wait_mut;
+    std::condition_variable _cv;
+    ///< one consumer at a time for every ring
+    std::mutex _drain_mut;
+    std::mutex _rings_mut;
+    std::vector<std::shared_ptr<Ring> > _rings;
+};
+
+} // namespace async
+
+} // namespace core
+
+} // namespace logger
+
+#endif // ASYNC_LOGGER_H
@@ -49,6 +49,12 @@
 
 #define LOGGER_CONCAT(str1,str2)  str1##str2
 
+/// \brief compile time cutoff: LOG sites above it (e.g. -DLOGGER_MAX_VERBOSE=-1 drops INFO)
+/// become constant false and are compiled out. FATAL is always kept.
+#ifndef LOGGER_MAX_VERBOSE
+#define LOGGER_MAX_VERBOSE 9
+#endif
+
 /// \brief intercept the our own abort signal
 ///
 /// for usage: signal(SIGABRT, SIG_DFL);
@@ -218,6 +224,14 @@ namespace core {
 
          } // init LoggerConfig
     }// namespace LoggerConfig
+
+    /// \brief process wide runtime cutoff on top of the stderr/file ones, lines above it are
+    /// dropped before anything is formatted. Defaults to env ANAKIN_LOG_LEVEL or Verbose_Max.
+    inline std::atomic<int>& runtime_verbosity() {
+        static std::atomic<int> level(getenv("ANAKIN_LOG_LEVEL") ? atoi(getenv("ANAKIN_LOG_LEVEL"))
+                                                                 : int(Verbose_Max));
+        return level;
+    }
 } // namespace core
 
 
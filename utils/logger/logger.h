@@ -37,6 +37,27 @@ namespace logger {
 
     }
 
+    /// write lines from a background thread (flushing every interval_ms) or synchronously again.
+    inline void set_async(bool on, unsigned interval_ms = 10) {
+        if (on) {
+            SCOPE_LOGGER_CORE::async::Backend::instance().start(interval_ms);
+        } else {
+            SCOPE_LOGGER_CORE::async::Backend::instance().stop();
+        }
+    }
+
+    /// write out the lines queued by the async backend.
+    inline void flush() {
+        if (SCOPE_LOGGER_CORE::async::Backend::instance().enabled()) {
+            SCOPE_LOGGER_CORE::async::Backend::instance().flush();
+        }
+    }
+
+    /// drop every line above verbose at runtime, e.g. Verbose_WARNING in production.
+    inline void set_verbosity(int verbose) {
+        SCOPE_LOGGER_CORE::runtime_verbosity().store(verbose, std::memory_order_relaxed);
+    }
+
 } // namespace logger
 
 
@@ -70,8 +91,13 @@ CHECK_SYMBOL_WARP(CHECK_GT_IMPL, >)
 #undef CHECK_SYMBOL_WARP
 
 /// usage: LOG_S(INFO)<<"function? "<<comevalue<<std::endl;
+/// the compile time cutoff goes first so a disabled site folds to nothing
+#define LOGGER_COMPILED_OUT(verbose) \
+  ((verbose) > LOGGER_MAX_VERBOSE && (verbose) > SCOPE_LOGGER_CORE::Verbose_FATAL)
 #define VLOG_IF_S(verbose, cond)																						\
-  (SCOPE_LOGGER_CORE::verbose > SCOPE_LOGGER_CORE_CONFIG::current_verbosity_cutoff()									\
+  (LOGGER_COMPILED_OUT(SCOPE_LOGGER_CORE::verbose)																		\
+			 || SCOPE_LOGGER_CORE::verbose > SCOPE_LOGGER_CORE_CONFIG::current_verbosity_cutoff()						\
+			 || SCOPE_LOGGER_CORE::verbose > SCOPE_LOGGER_CORE::runtime_verbosity().load(std::memory_order_relaxed)	\
 			 || (cond)==false) ? (void)0																				\
 			 :SCOPE_LOGGER_CORE::voidify() & SCOPE_LOGGER_CORE::loggerMsg(SCOPE_LOGGER_CORE::verbose, __FILE__, __LINE__)
 #define LOG_IF_S(verbose_name, cond) VLOG_IF_S(Verbose_##verbose_name, cond)
@@ -203,7 +229,8 @@ CHECK_SYMBOL_WARP(CHECK_GT_IMPL, >)
 #define DCHECK_LE      DCHECK_LE_S
 #define DCHECK_GT      DCHECK_GT_S
 #define DCHECK_GE      DCHECK_GE_S
-#define VLOG_IS_ON(verbose) ((verbose) <= SCOPE_LOGGER_CORE_CONFIG::current_verbosity_cutoff())
+#define VLOG_IS_ON(verbose) ((verbose) <= SCOPE_LOGGER_CORE_CONFIG::current_verbosity_cutoff() \
+                             && (verbose) <= SCOPE_LOGGER_CORE::runtime_verbosity().load(std::memory_order_relaxed))
 #endif
 
 #else // USE_SGX
@@ -239,6 +239,7 @@ namespace logger {
         /*                            log stderr manipulate                         */
         /****************************************************************************/
         void print_preamble(char* out_buff, size_t out_buff_size, VerBoseType    verbose, const char* file, unsigned line);
+        void write_message(Message& message, bool flush_now);
         void log_message(int stack_trace_skip, Message& message, bool abort_if_fatal);
         void log_to_all(int            stack_trace_skip,
                                VerBoseType    verbose,
@@ -322,6 +323,8 @@ namespace logger {
 
 }  // namespace logger
 
+#include "async_logger.h"
+
 namespace logger {
 
 namespace core {
@@ -566,6 +569,15 @@ inline void log_to_all(int  stack_trace_skip,
                        const char*    prefix,
                        const char*    buff)
 {
+  auto& backend = async::Backend::instance();
+  if (backend.enabled()) {
+    if (verbose > Verbose_FATAL) {
+      backend.push(verbose, file, line, prefix, buff);
+      return;
+    }
+    // the lines queued before a fatal one go first
+    backend.flush();
+  }
   char preamble_buff[128];
   print_preamble(preamble_buff, sizeof(preamble_buff), verbose, file, line);
   auto message = Message{verbose, file, line, preamble_buff, prefix, buff};
@@ -840,10 +852,10 @@ inline void print_preamble(char* out_buff,
 	   line, level_buff);*/
 }
 
-inline void log_message(int stack_trace_skip, Message& message, bool abort_if_fatal)
+/// write message to stderr and the log files, the caller holds LoggerConfig::rsMutex.
+inline void write_message(Message& message, bool flush_now)
 {
   const auto verbosity = message.verbose;
-  std::lock_guard<std::recursive_mutex> lock(LoggerConfig::rsMutex);
 
   if (verbosity <= LoggerConfig::currentVerbos) {
     if (LoggerConfig::colorstderr && LoggerConfig::terminalSupportColor) {
@@ -873,13 +885,33 @@ inline void log_message(int stack_trace_skip, Message& message, bool abort_if_fa
       message.preamble, message.prefix, message.message);
     }
 
-    if (LoggerConfig::flushBufferInMs == 0) {
+    if (flush_now) {
       fflush(stderr);
     } else {
       LoggerConfig::needFlush = true;
     }
   } // if verbosity <= LoggerConfig::currentVerbos
 
+  for (auto& p : LoggerConfig::callbackVecs) {
+    if (verbosity <= p.verbose) {
+      p.callback(p.user_data, message); // log to file
+      if (flush_now) {
+        // fflush(file)
+        if (p.flush) { p.flush(p.user_data); }
+      } else {
+        LoggerConfig::needFlush = true;
+      }
+    }
+  }
+}
+
+inline void log_message(int stack_trace_skip, Message& message, bool abort_if_fatal)
+{
+  const auto verbosity = message.verbose;
+  std::lock_guard<std::recursive_mutex> lock(LoggerConfig::rsMutex);
+
+  write_message(message, LoggerConfig::flushBufferInMs == 0);
+
   if (verbosity == Verbose_FATAL) {
     auto st = stacktrace(stack_trace_skip + 2); // friendly message of stack trace
     if (!st.empty()) {
@@ -905,20 +937,6 @@ inline void log_message(int stack_trace_skip, Message& message, bool abort_if_fa
     }
   }
 
-
-
-  for (auto& p : LoggerConfig::callbackVecs) {
-    if (verbosity <= p.verbose) {
-      p.callback(p.user_data, message); // log to file
-      if (LoggerConfig::flushBufferInMs == 0) {
-        // fflush(file)
-        if (p.flush) { p.flush(p.user_data); }
-      } else {
-        LoggerConfig::needFlush = true;
-      }
-    }
-  }
-
   if (LoggerConfig::flushBufferInMs > 0 && !LoggerConfig::flushThread) {
     // create the guard thread preiodic flushing
      LoggerConfig::flushThread = new std::thread([](){
@@ -1048,6 +1066,12 @@ inline void initial(const char* argv0){
   //fflush(stderr);
   install_logger_signal_handlers();
   flush_callback();
+  // ANAKIN_LOG_ASYNC=<flush interval in ms> moves the writes off the logging threads
+  if (const char* async_ms = getenv("ANAKIN_LOG_ASYNC")) {
+    if (atoi(async_ms) > 0) {
+      async::Backend::instance().start(atoi(async_ms));
+    }
+  }
 
 }
 